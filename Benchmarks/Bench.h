@@ -0,0 +1,119 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// --------------------------- Инфраструктура бенчмарков ---------------------------
+
+// Простой таймер на steady_clock
+class BenchTimer {
+    chrono::steady_clock::time_point start_ = chrono::steady_clock::now();
+public:
+    void reset() { start_ = chrono::steady_clock::now(); }
+    double elapsed_ns() const {
+        return chrono::duration<double, nano>(chrono::steady_clock::now() - start_).count();
+    }
+    double elapsed_ms() const { return elapsed_ns() / 1e6; }
+};
+
+// Временный рабочий каталог: хранилища читают и пишут файлы в текущем каталоге,
+// поэтому бенчмарк переходит в отдельную папку и удаляет ее по завершении
+class ScratchDir {
+    filesystem::path previous_;
+    filesystem::path path_;
+public:
+    explicit ScratchDir(const string& name);
+    ~ScratchDir();
+    ScratchDir(const ScratchDir&) = delete;
+    ScratchDir& operator=(const ScratchDir&) = delete;
+};
+
+// Детерминированный генератор псевдослучайных чисел (xorshift64)
+class BenchRandom {
+    uint64_t state_;
+public:
+    explicit BenchRandom(uint64_t seed = 0x9E3779B97F4A7C15ull) : state_(seed) {}
+    uint64_t next() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 7;
+        state_ ^= state_ << 17;
+        return state_;
+    }
+    size_t below(size_t n) { return static_cast<size_t>(next() % n); }
+};
+
+// Не дает компилятору выбросить результат измеряемого кода. На GCC/Clang - пустая
+// asm-вставка, читающая адрес; на MSVC - запись в volatile-указатель (volatile сам
+// указатель, а не данные по нему, поэтому запись выбросить нельзя)
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+// Приемник вывода без записи: буфер переиспользуется, запись не выделяет память
+class NullBuffer : public streambuf {
+    char buffer_[4096];
+public:
+    NullBuffer() { setp(buffer_, buffer_ + sizeof(buffer_)); }
+protected:
+    int overflow(int ch) override {
+        setp(buffer_, buffer_ + sizeof(buffer_));
+        return traits_type::not_eof(ch);
+    }
+};
+
+// cout отбрасывает вывод, пока объект жив
+class SilentCout {
+    NullBuffer null_;
+    streambuf* previous_;
+public:
+    SilentCout() : previous_(cout.rdbuf(&null_)) {}
+    ~SilentCout() { cout.rdbuf(previous_); }
+    SilentCout(const SilentCout&) = delete;
+    SilentCout& operator=(const SilentCout&) = delete;
+};
+
+// Число выделений памяти через operator new с начала работы процесса
+// (глобальные operator new/delete бенчмарков подменены и считают вызовы)
+size_t allocation_count();
+
+// --------------------------- Синтетические данные ---------------------------
+string synthetic_username(size_t i);
+
+// users.txt из n сотрудников, пустой hr_users.txt и admin_users.txt с одним администратором
+void write_synthetic_users(size_t n);
+
+// Полный набор данных в текущем каталоге (bench_dataset.cpp): users.txt, hr_users.txt,
+// admin_users.txt, projects.txt, employee_projects.txt и performance_scores.txt
+struct SyntheticDataset {
+    size_t employees = 0;
+    size_t hr_users = 0;
+    size_t projects = 0;
+    size_t assignments = 0;
+    size_t scores = 0;
+};
+SyntheticDataset write_synthetic_dataset(size_t employees, uint64_t seed = 0x9E3779B97F4A7C15ull);
+
+// --------------------------- Бенчмарки ---------------------------
+void bench_user_index(const vector<string>& args);
+void bench_load(const vector<string>& args);
+void bench_parse(const vector<string>& args);
+void bench_scoring(const vector<string>& args);
+void bench_search(const vector<string>& args);
+void bench_case_fold(const vector<string>& args);
+void bench_e2e(const vector<string>& args);
+void bench_utilities(const vector<string>& args);
+
+// --------------------------- Служебные команды ---------------------------
+void gen_data(const vector<string>& args);
@@ -0,0 +1,84 @@
+#include "Bench.h"
+#include "Utilities.h"
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- Приведение к нижнему регистру ---------------------------
+// Прежний toLower (std::tolower по байту) против таблицы и векторных веток
+// fold_case_cp1251 на строках разной длины. Текст - буквы А..я, A..z, цифры и
+// пробелы в CP1251, изредка Ё. Результат каждой ветки сравнивается с таблицей.
+// Аргумент: суммарный объем текста в байтах на один замер (по умолчанию 64 МБ)
+static string make_cp1251_text(BenchRandom& random, size_t length) {
+    string text(length, ' ');
+    for (char& c : text) {
+        size_t kind = random.below(100);
+        if (kind < 60) c = static_cast<char>(0xC0 + random.below(64));
+        else if (kind < 80) c = static_cast<char>((random.below(2) ? 'A' : 'a') + random.below(26));
+        else if (kind < 90) c = static_cast<char>('0' + random.below(10));
+        else if (kind < 99) c = ' ';
+        else c = static_cast<char>(0xA8);
+    }
+    return text;
+}
+
+void bench_case_fold(const vector<string>& args) {
+    size_t volume = args.empty() ? (64u << 20) : stoul(args[0]);
+
+    cout << "Лучший набор инструкций: " << scoring_isa_name(scoring_isa()) << "\n";
+    cout << left << setw(10) << "Длина" << setw(24) << "Способ" << setw(14) << "нс/строка"
+        << setw(12) << "МБ/с" << "расхождений\n";
+    cout << string(70, '-') << "\n";
+
+    BenchRandom random;
+    for (size_t length : { 8, 32, 256, 4096 }) {
+        size_t count = max<size_t>(1, volume / length / 16);
+        vector<string> texts;
+        texts.reserve(16);
+        for (size_t i = 0; i < 16; ++i) texts.push_back(make_cp1251_text(random, length));
+
+        vector<string> expected;
+        for (const auto& text : texts) expected.push_back(folded_cp1251(text));
+
+        auto report = [&](const string& name, double ns, size_t mismatches) {
+            cout << left << setw(10) << length << setw(24) << name << setw(14) << fixed << setprecision(1)
+                << ns / (count * texts.size()) << setw(12) << (count * texts.size() * length) / (ns / 1e9) / 1e6
+                << mismatches << "\n";
+        };
+
+        string out(length, '\0');
+        BenchTimer tolower_timer;
+        for (size_t k = 0; k < count; ++k) {
+            for (const auto& text : texts) {
+                transform(text.begin(), text.end(), out.begin(),
+                    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                do_not_optimize(out);
+            }
+        }
+        report("std::tolower", tolower_timer.elapsed_ns(), 0);
+
+        for (ScoringIsa isa : { ScoringIsa::SCALAR, ScoringIsa::SSE2, ScoringIsa::AVX2 }) {
+            if (static_cast<int>(isa) > static_cast<int>(scoring_isa())) continue;
+
+            BenchTimer timer;
+            for (size_t k = 0; k < count; ++k) {
+                for (const auto& text : texts) {
+                    fold_case_cp1251(text.data(), length, out.data(), isa);
+                    do_not_optimize(out);
+                }
+            }
+            double ns = timer.elapsed_ns();
+
+            size_t mismatches = 0;
+            for (size_t i = 0; i < texts.size(); ++i) {
+                fold_case_cp1251(texts[i].data(), length, out.data(), isa);
+                if (out != expected[i]) ++mismatches;
+            }
+            report(string("fold_case_cp1251 ") + scoring_isa_name(isa), ns, mismatches);
+        }
+    }
+    cout << resetiosflags(ios_base::floatfield);
+}
@@ -0,0 +1,244 @@
+#include "Bench.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- Синтетический набор данных ---------------------------
+// Файлы в тех же форматах, что пишет программа: ФИО и роли в нижнем регистре
+// (ввод из меню приводится toLower), отделы и статусы - как в списках выбора,
+// оценки - с запятой, как их сохраняет русская локаль. Кириллица в CP1251.
+// Числа форматируются без потоков: после создания Application глобальная локаль
+// русская, и ofstream разбивал бы их на разряды.
+
+namespace {
+    struct NamePair {
+        const char* cyrillic;
+        const char* latin;
+    };
+
+    // Мужская форма; женская получается окончанием "а" (у фамилий на -ой/-ий - "ая")
+    const NamePair last_names[] = {
+        { "иванов", "ivanov" }, { "петров", "petrov" }, { "сидоров", "sidorov" }, { "смирнов", "smirnov" },
+        { "кузнецов", "kuznetsov" }, { "попов", "popov" }, { "васильев", "vasilev" }, { "соколов", "sokolov" },
+        { "михайлов", "mikhailov" }, { "новиков", "novikov" }, { "федоров", "fedorov" }, { "морозов", "morozov" },
+        { "волков", "volkov" }, { "алексеев", "alekseev" }, { "лебедев", "lebedev" }, { "семенов", "semenov" },
+        { "егоров", "egorov" }, { "павлов", "pavlov" }, { "козлов", "kozlov" }, { "степанов", "stepanov" },
+        { "николаев", "nikolaev" }, { "орлов", "orlov" }, { "андреев", "andreev" }, { "макаров", "makarov" },
+        { "никитин", "nikitin" }, { "захаров", "zakharov" }, { "зайцев", "zaitsev" }, { "соловьев", "solovev" },
+        { "борисов", "borisov" }, { "яковлев", "yakovlev" }, { "григорьев", "grigorev" }, { "романов", "romanov" },
+        { "воробьев", "vorobev" }, { "сергеев", "sergeev" }, { "фролов", "frolov" }, { "королёв", "korolev" },
+        { "ковалёв", "kovalev" }, { "сёмин", "semin" }, { "ильин", "ilin" }, { "максимов", "maksimov" },
+        { "поляков", "polyakov" }, { "сорокин", "sorokin" }, { "виноградов", "vinogradov" }, { "белов", "belov" },
+        { "медведев", "medvedev" }, { "антонов", "antonov" }, { "тарасов", "tarasov" }, { "жуков", "zhukov" },
+        { "баранов", "baranov" }, { "филиппов", "filippov" }, { "комаров", "komarov" }, { "давыдов", "davydov" },
+        { "беляев", "belyaev" }, { "герасимов", "gerasimov" }, { "богданов", "bogdanov" }, { "осипов", "osipov" },
+        { "толстой", "tolstoy" }, { "чайковский", "chaikovsky" }, { "островский", "ostrovsky" }, { "вишневский", "vishnevsky" },
+    };
+
+    const NamePair male_first_names[] = {
+        { "александр", "alexander" }, { "алексей", "alexey" }, { "андрей", "andrey" }, { "артём", "artem" },
+        { "борис", "boris" }, { "вадим", "vadim" }, { "виктор", "viktor" }, { "владимир", "vladimir" },
+        { "дмитрий", "dmitry" }, { "евгений", "evgeny" }, { "егор", "egor" }, { "иван", "ivan" },
+        { "игорь", "igor" }, { "кирилл", "kirill" }, { "максим", "maksim" }, { "михаил", "mikhail" },
+        { "никита", "nikita" }, { "николай", "nikolay" }, { "олег", "oleg" }, { "павел", "pavel" },
+        { "петр", "petr" }, { "роман", "roman" }, { "сергей", "sergey" }, { "юрий", "yury" },
+        { "фёдор", "fedor" }, { "семён", "semen" }, { "ярослав", "yaroslav" }, { "лев", "lev" },
+    };
+
+    const NamePair female_first_names[] = {
+        { "анна", "anna" }, { "алёна", "alena" }, { "анастасия", "anastasia" }, { "валентина", "valentina" },
+        { "вера", "vera" }, { "виктория", "viktoria" }, { "галина", "galina" }, { "дарья", "darya" },
+        { "екатерина", "ekaterina" }, { "елена", "elena" }, { "ирина", "irina" }, { "ксения", "ksenia" },
+        { "людмила", "lyudmila" }, { "мария", "maria" }, { "марина", "marina" }, { "наталья", "natalia" },
+        { "ольга", "olga" }, { "полина", "polina" }, { "светлана", "svetlana" }, { "софья", "sofia" },
+        { "татьяна", "tatiana" }, { "юлия", "yulia" }, { "яна", "yana" }, { "любовь", "lyubov" },
+    };
+
+    // Отчества: мужское и женское
+    const char* patronymics[][2] = {
+        { "александрович", "александровна" }, { "алексеевич", "алексеевна" }, { "андреевич", "андреевна" },
+        { "викторович", "викторовна" }, { "владимирович", "владимировна" }, { "дмитриевич", "дмитриевна" },
+        { "иванович", "ивановна" }, { "игоревич", "игоревна" }, { "михайлович", "михайловна" },
+        { "николаевич", "николаевна" }, { "олегович", "олеговна" }, { "павлович", "павловна" },
+        { "петрович", "петровна" }, { "сергеевич", "сергеевна" }, { "юрьевич", "юрьевна" },
+        { "фёдорович", "фёдоровна" }, { "семёнович", "семёновна" },
+    };
+
+    // Отделы из choose_department; разработка встречается чаще остальных
+    const char* departments[] = {
+        "Разработка", "Разработка", "Разработка", "Разработка", "QA", "QA",
+        "Дизайн", "Маркетинг", "Продажи", "Поддержка",
+    };
+
+    const char* project_roles[] = {
+        "участник", "участник", "участник", "разработчик", "разработчик", "разработчик",
+        "тестировщик", "аналитик", "дизайнер", "главный разработчик", "руководитель", "менеджер",
+    };
+
+    const char* project_statuses[] = {
+        "Активный", "Активный", "Активный", "Активный", "Активный", "Активный",
+        "Завершенный", "Завершенный", "Приостановленный", "Планируется",
+    };
+
+    const char* project_prefixes[] = {
+        "Hotel", "Bank", "Retail", "Logistics", "Medical", "School", "Travel", "Energy", "Insurance", "Media",
+    };
+    const char* project_suffixes[] = {
+        "Portal", "Platform", "App", "System", "Analytics", "Gateway", "Crm", "Billing",
+    };
+
+    const char* description_verbs[] = {
+        "Разработка", "Внедрение", "Сопровождение", "Модернизация", "Создание",
+    };
+    const char* description_objects[] = {
+        "системы управления отелем", "мобильного банковского приложения", "платформы электронной коммерции",
+        "системы учета клиентов", "портала для сотрудников", "службы доставки", "системы бронирования",
+        "аналитической панели продаж", "личного кабинета клиента", "системы электронного документооборота",
+    };
+
+    template <typename T, size_t N>
+    const T& pick(BenchRandom& random, const T(&items)[N]) {
+        return items[random.below(N)];
+    }
+
+    string feminine_last_name(const char* last_name) {
+        string result = last_name;
+        if (result.size() >= 2 && (result.ends_with("ий") || result.ends_with("ой"))) {
+            result.replace(result.size() - 2, 2, "ая");
+        }
+        else {
+            result += "а";
+        }
+        return result;
+    }
+
+    // Дата "ГГГГ-ММ-ДД ЧЧ:ММ:СС" в 2024-2025 годах
+    string random_date(BenchRandom& random) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d:%02d",
+            2024 + static_cast<int>(random.below(2)), 1 + static_cast<int>(random.below(12)),
+            1 + static_cast<int>(random.below(28)), static_cast<int>(random.below(24)),
+            static_cast<int>(random.below(60)), static_cast<int>(random.below(60)));
+        return buf;
+    }
+
+    // Строка пользователя; номер в логине делает его уникальным. Возвращает логин
+    string write_person(ofstream& out, BenchRandom& random, const char* login_prefix, size_t i,
+        const char* department, const char* role) {
+        bool female = random.below(2) == 0;
+        const NamePair& last = pick(random, last_names);
+        const NamePair& first = female ? pick(random, female_first_names) : pick(random, male_first_names);
+        const char* patronymic = pick(random, patronymics)[female ? 1 : 0];
+
+        string login = string(login_prefix) + first.latin + "_" + last.latin + to_string(i);
+        out << login << "|" << to_string(1000000007ull * (i + 1)) << "|"
+            << (female ? feminine_last_name(last.cyrillic) : string(last.cyrillic)) << " "
+            << first.cyrillic << " " << patronymic << "|"
+            << department << "|" << role << "\n";
+        return login;
+    }
+}
+
+SyntheticDataset write_synthetic_dataset(size_t employees, uint64_t seed) {
+    SyntheticDataset dataset;
+    dataset.employees = employees;
+    dataset.hr_users = max<size_t>(3, employees / 200);
+    dataset.projects = max<size_t>(10, employees / 25);
+
+    BenchRandom random(seed);
+    vector<string> logins;
+    logins.reserve(employees);
+
+    {
+        ofstream users("users.txt", ios::trunc | ios::binary);
+        for (size_t i = 0; i < employees; ++i) {
+            logins.push_back(write_person(users, random, "", i, pick(random, departments), "EMPLOYEE"));
+        }
+    }
+    {
+        ofstream hr("hr_users.txt", ios::trunc | ios::binary);
+        for (size_t i = 0; i < dataset.hr_users; ++i) {
+            write_person(hr, random, "hr_", employees + i, "HR", "HR");
+        }
+        ofstream admin("admin_users.txt", ios::trunc | ios::binary);
+        admin << "admin|0|Системный администратор|ADMIN|ADMIN\n";
+    }
+
+    vector<string> project_names;
+    project_names.reserve(dataset.projects);
+    {
+        ofstream projects("projects.txt", ios::trunc | ios::binary);
+        for (size_t i = 0; i < dataset.projects; ++i) {
+            string name = string(project_prefixes[i % size(project_prefixes)]) +
+                project_suffixes[(i / size(project_prefixes)) % size(project_suffixes)] + to_string(i);
+            projects << name << "|" << pick(random, description_verbs) << " " << pick(random, description_objects)
+                << "|" << pick(random, project_statuses) << "|" << random_date(random) << "\n";
+            project_names.push_back(move(name));
+        }
+    }
+
+    // У каждого сотрудника 0-4 разных проекта (в среднем 2); без проектов - примерно каждый
+    // десятый, таким оценка не выставляется. Оценки есть у 70% участников проектов
+    {
+        ofstream assignments("employee_projects.txt", ios::trunc | ios::binary);
+        ofstream scores("performance_scores.txt", ios::trunc | ios::binary);
+        constexpr size_t MAX_PROJECTS_PER_EMPLOYEE = 4;
+        for (const string& login : logins) {
+            size_t count = random.below(MAX_PROJECTS_PER_EMPLOYEE + 1);
+            if (count == 0 && random.below(2) == 0) count = 2;
+
+            // Выбор без повторов: проектов не меньше 10, повторная попытка нужна редко
+            size_t chosen[MAX_PROJECTS_PER_EMPLOYEE];
+            for (size_t k = 0; k < count; ++k) {
+                size_t project = 0;
+                do {
+                    project = random.below(project_names.size());
+                } while (find(chosen, chosen + k, project) != chosen + k);
+                chosen[k] = project;
+
+                assignments << login << "|" << project_names[project] << "|"
+                    << pick(random, project_roles) << "|" << random_date(random) << "\n";
+            }
+            dataset.assignments += count;
+
+            if (count > 0 && random.below(10) < 7) {
+                size_t hundredths = random.below(10001);
+                char buf[32];
+                snprintf(buf, sizeof(buf), "%zu,%02zu", hundredths / 100, hundredths % 100);
+                scores << login << "|" << buf << "\n";
+                ++dataset.scores;
+            }
+        }
+    }
+    return dataset;
+}
+
+// --------------------------- gen_data ---------------------------
+// Служебная команда: набор данных в указанный каталог, например для запуска
+// программы (в том числе --script) на большом объеме.
+// Аргументы: каталог [число сотрудников (по умолчанию 100000)]
+void gen_data(const vector<string>& args) {
+    if (args.empty()) {
+        cerr << "Использование: Benchmarks.exe gen_data <каталог> [число сотрудников]\n";
+        return;
+    }
+    size_t employees = args.size() > 1 ? stoul(args[1]) : 100000;
+
+    filesystem::path previous = filesystem::current_path();
+    filesystem::create_directories(args[0]);
+    filesystem::current_path(args[0]);
+
+    BenchTimer timer;
+    SyntheticDataset dataset = write_synthetic_dataset(employees);
+    double ms = timer.elapsed_ms();
+    filesystem::current_path(previous);
+
+    cout << "Каталог: " << args[0] << "\n"
+        << "Сотрудников: " << dataset.employees << ", HR: " << dataset.hr_users
+        << ", проектов: " << dataset.projects << ", назначений: " << dataset.assignments
+        << ", оценок: " << dataset.scores << "\n"
+        << "Записано за " << static_cast<long long>(ms) << " мс\n";
+}
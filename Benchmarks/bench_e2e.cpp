@@ -0,0 +1,284 @@
+#include "Bench.h"
+#include "UserClasses.h"
+#include "Projects.h"
+#include "SystemConfig.h"
+#include <charconv>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+// --------------------------- Сквозной бенчмарк ---------------------------
+// На каждом масштабе (1K, 100K, 1M сотрудников) генерируется полный набор данных
+// (write_synthetic_dataset), затем замеряются операции так, как их выполняет программа:
+// загрузка и сохранение хранилищ, поиск по логину, поиск подстроки, сортировки,
+// рейтинг, пакетный расчет оценок и запись отчетов через командный режим Application.
+// Результаты печатаются таблицей и пишутся в JSON для сравнения между версиями.
+// Аргументы: [максимальное число сотрудников (1000000)] [файл результатов (bench_e2e.json)]
+
+namespace {
+    struct E2eResult {
+        string name;
+        size_t ops;
+        double ms;
+    };
+
+    struct E2eScale {
+        size_t rows = 0;
+        SyntheticDataset dataset;
+        vector<E2eResult> results;
+    };
+
+    template <typename Body>
+    void measure(vector<E2eResult>& results, const char* name, size_t ops, Body&& body) {
+        BenchTimer timer;
+        body();
+        results.push_back({ name, ops, timer.elapsed_ms() });
+    }
+
+    // Команды report|логин|формат для count случайных сотрудников
+    string report_script(const vector<string>& logins, size_t count, const char* format, BenchRandom& random) {
+        string script;
+        for (size_t i = 0; i < count; ++i) {
+            script += "report|" + logins[random.below(logins.size())] + "|" + format + "\n";
+        }
+        return script;
+    }
+
+    size_t count_errors(const string& output) {
+        size_t errors = 0;
+        for (size_t pos = output.find("\"status\":\"error\""); pos != string::npos;
+            pos = output.find("\"status\":\"error\"", pos + 1)) {
+            ++errors;
+        }
+        return errors;
+    }
+
+    E2eScale run_scale(size_t rows) {
+        E2eScale scale;
+        scale.rows = rows;
+        ScratchDir dir("hr_bench_e2e");
+
+        measure(scale.results, "generate", 1, [&] { scale.dataset = write_synthetic_dataset(rows); });
+        vector<E2eResult>& results = scale.results;
+        // Хранилища сообщают о загрузке и ошибках в cout; на время замеров это отбрасывается
+        SilentCout silent;
+
+        vector<string> logins;
+        {
+            unique_ptr<UserStore> users;
+            unique_ptr<ProjectStore> projects;
+            unique_ptr<SystemConfig> config;
+            measure(results, "load.users", 1, [&] { users = make_unique<UserStore>(); });
+            measure(results, "load.projects", 1, [&] { projects = make_unique<ProjectStore>(); });
+            measure(results, "load.config", 1, [&] { config = make_unique<SystemConfig>(); });
+            // Как в Application: рейтинг обновляется при каждой новой оценке
+            config->setScoreListener([&](const string& username, double score) {
+                users->update_rating(username, score);
+            });
+
+            logins.reserve(users->users().size());
+            for (const auto& user : users->users()) logins.push_back(user->username());
+            vector<const Project*> all_projects = projects->all_projects();
+
+            BenchRandom random;
+            size_t found = 0;
+
+            const size_t lookups = 100000;
+            measure(results, "find.username", lookups, [&] {
+                for (size_t i = 0; i < lookups; ++i) {
+                    found += users->find_by_username(logins[random.below(logins.size())]) != nullptr;
+                }
+            });
+            measure(results, "find.project", lookups, [&] {
+                for (size_t i = 0; i < lookups; ++i) {
+                    const string& name = all_projects[random.below(all_projects.size())]->name();
+                    found += projects->find_project(name) != nullptr;
+                }
+            });
+            const size_t employee_lookups = 10000;
+            measure(results, "find.employee_projects", employee_lookups, [&] {
+                for (size_t i = 0; i < employee_lookups; ++i) {
+                    found += projects->get_employee_projects(logins[random.below(logins.size())]).size();
+                }
+            });
+
+            // Запросы как в bench_search: часть ФИО, логин и отсутствующее имя
+            const size_t queries = 1000;
+            vector<string> name_queries;
+            vector<string> project_queries;
+            for (size_t i = 0; i < queries; ++i) {
+                const User* user = users->users()[random.below(logins.size())].get();
+                switch (i % 3) {
+                case 0: name_queries.push_back(user->fullname().substr(user->fullname().find(' ') - 2)); break;
+                case 1: name_queries.push_back(user->username()); break;
+                default: name_queries.push_back("нет такого " + to_string(i)); break;
+                }
+                const string& project = all_projects[random.below(all_projects.size())]->name();
+                project_queries.push_back(i % 2 ? project.substr(0, 4) : project.substr(project.size() - 4));
+            }
+            measure(results, "search.employees", queries, [&] {
+                for (const auto& q : name_queries) found += users->search_employees_by_name(q).size();
+            });
+            measure(results, "search.projects", queries, [&] {
+                for (const auto& q : project_queries) found += projects->search_projects_by_name(q).size();
+            });
+
+            const size_t sorts = 3;
+            measure(results, "sort.employees_by_name", sorts, [&] {
+                for (size_t i = 0; i < sorts; ++i) found += users->get_employees_sorted_by_name().size();
+            });
+            // Первый запрос рейтинга строит индекс по всем оценкам
+            measure(results, "rank.build", 1, [&] {
+                found += users->get_employees_sorted_by_rating(config.get()).size();
+            });
+            measure(results, "sort.employees_by_rating", sorts, [&] {
+                for (size_t i = 0; i < sorts; ++i) found += users->get_employees_sorted_by_rating(config.get()).size();
+            });
+
+            const size_t rank_queries = 10000;
+            measure(results, "rank.employee", rank_queries, [&] {
+                for (size_t i = 0; i < rank_queries; ++i) {
+                    found += users->get_employee_rank(logins[random.below(logins.size())], config.get()).first;
+                }
+            });
+            const size_t top_queries = 1000;
+            measure(results, "rank.top10", top_queries, [&] {
+                for (size_t i = 0; i < top_queries; ++i) found += users->get_top_rated(10, config.get()).size();
+            });
+            measure(results, "rank.top10_department", top_queries, [&] {
+                static const string departments[] = { "Разработка", "QA", "Дизайн", "Маркетинг", "Продажи", "Поддержка" };
+                for (size_t i = 0; i < top_queries; ++i) {
+                    found += users->get_top_rated_in_department(departments[i % 6], 10, config.get()).size();
+                }
+            });
+
+            // Пакетный расчет по всем участникам проектов, как batch_calculate_performance
+            ScoreTable table;
+            vector<string> scored;
+            measure(results, "scoring.table", logins.size(), [&] {
+                for (const auto& user : users->users()) {
+                    ProjectActivity activity = projects->get_employee_activity(user->username());
+                    if (activity.total_projects == 0) continue;
+                    scored.push_back(user->username());
+                    table.add(config->getDepartmentId(user->department()),
+                        random.below(10001) / 100.0, random.below(10001) / 100.0, activity.tasks_score());
+                }
+            });
+            measure(results, "scoring.bulk", table.size(), [&] {
+                config->calculatePerformanceBulk(table);
+            });
+            vector<pair<string, double>> scores;
+            scores.reserve(scored.size());
+            for (size_t i = 0; i < scored.size(); ++i) scores.emplace_back(scored[i], table.final_scores[i]);
+            measure(results, "scoring.store", scores.size(), [&] { config->setPerformanceScores(scores); });
+
+            measure(results, "save.users", 1, [&] { users->save_all_files(); });
+            measure(results, "save.projects", 1, [&] { projects->save_all_files(); });
+            measure(results, "save.scores", 1, [&] { config->savePerformanceScores(); });
+            do_not_optimize(found);
+        }
+
+        // Отчеты - целиком, как их пишет программа: модель, рендер, файл, архив и каталог
+        unique_ptr<Application> app;
+        measure(results, "load.application", 1, [&] { app = make_unique<Application>(); });
+
+        BenchRandom random(rows);
+        const size_t reports = min<size_t>(rows, 500);
+        for (const char* format : { "txt", "json" }) {
+            istringstream script(report_script(logins, reports, format, random));
+            ostringstream output;
+            string name = string("report.") + format;
+            measure(results, name.c_str(), reports, [&] { app->run_headless(script, output); });
+            if (size_t errors = count_errors(output.str())) {
+                cerr << name << ": ошибок " << errors << " из " << reports << "\n";
+            }
+        }
+        return scale;
+    }
+
+    void append_number(string& out, double value, int precision) {
+        char buf[64];
+        auto [end, ec] = to_chars(buf, buf + sizeof(buf), value, chars_format::fixed, precision);
+        out.append(buf, ec == errc() ? end : buf);
+    }
+
+    void append_number(string& out, size_t value) {
+        char buf[32];
+        auto [end, ec] = to_chars(buf, buf + sizeof(buf), value);
+        out.append(buf, end);
+    }
+
+    // Поля и числа - только ASCII; числа через to_chars, независимо от глобальной локали
+    string results_json(const vector<E2eScale>& scales) {
+        string out = "{\n  \"benchmark\": \"e2e\",\n  \"date\": \"" + now_string() +
+            "\",\n  \"isa\": \"" + scoring_isa_name(scoring_isa()) + "\",\n  \"scales\": [";
+        for (size_t s = 0; s < scales.size(); ++s) {
+            const E2eScale& scale = scales[s];
+            out += s ? ",\n    {" : "\n    {";
+            out += "\n      \"rows\": "; append_number(out, scale.rows);
+            out += ",\n      \"hr_users\": "; append_number(out, scale.dataset.hr_users);
+            out += ",\n      \"projects\": "; append_number(out, scale.dataset.projects);
+            out += ",\n      \"assignments\": "; append_number(out, scale.dataset.assignments);
+            out += ",\n      \"scores\": "; append_number(out, scale.dataset.scores);
+            out += ",\n      \"results\": [";
+            for (size_t r = 0; r < scale.results.size(); ++r) {
+                const E2eResult& result = scale.results[r];
+                out += r ? ",\n        " : "\n        ";
+                out += "{ \"name\": \"" + result.name + "\", \"ops\": ";
+                append_number(out, result.ops);
+                out += ", \"total_ms\": ";
+                append_number(out, result.ms, 3);
+                out += ", \"us_per_op\": ";
+                append_number(out, result.ops ? result.ms * 1000 / result.ops : 0, 3);
+                out += " }";
+            }
+            out += "\n      ]\n    }";
+        }
+        out += "\n  ]\n}\n";
+        return out;
+    }
+}
+
+void bench_e2e(const vector<string>& args) {
+    size_t max_rows = args.empty() ? 1000000 : stoul(args[0]);
+    // Путь - относительно каталога запуска, а не временного каталога бенчмарка
+    filesystem::path json_path = filesystem::absolute(args.size() > 1 ? args[1] : "bench_e2e.json");
+
+    // Стандартные масштабы до max_rows; нестандартный max_rows добавляется последним
+    vector<size_t> sizes;
+    for (size_t rows : { 1000, 100000, 1000000 }) {
+        if (rows <= max_rows) sizes.push_back(rows);
+    }
+    if (sizes.empty() || sizes.back() != max_rows) sizes.push_back(max_rows);
+
+    vector<E2eScale> scales;
+    for (size_t rows : sizes) {
+        scales.push_back(run_scale(rows));
+        const E2eScale& scale = scales.back();
+
+        cout << "Сотрудников: " << scale.rows << ", HR: " << scale.dataset.hr_users
+            << ", проектов: " << scale.dataset.projects << ", назначений: " << scale.dataset.assignments
+            << ", оценок: " << scale.dataset.scores << "\n";
+        cout << left << setw(28) << "Операция" << setw(10) << "Раз"
+            << setw(14) << "Всего, мс" << "мкс/операцию\n";
+        cout << string(66, '-') << "\n";
+        for (const auto& result : scale.results) {
+            cout << left << setw(28) << result.name << setw(10) << result.ops
+                << setw(14) << fixed << setprecision(2) << result.ms
+                << setprecision(3) << (result.ops ? result.ms * 1000 / result.ops : 0) << "\n";
+        }
+        cout << resetiosflags(ios_base::floatfield) << "\n";
+    }
+
+    string json = results_json(scales);
+    ofstream out(json_path, ios::binary | ios::trunc);
+    out.write(json.data(), static_cast<streamsize>(json.size()));
+    if (!out) {
+        cerr << "Не удалось записать результаты: " << json_path.string() << "\n";
+        return;
+    }
+    cout << "Результаты: " << json_path.string() << "\n";
+}
@@ -0,0 +1,77 @@
+#include "Bench.h"
+#include "UserClasses.h"
+#include "Projects.h"
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- Загрузка users.txt ---------------------------
+// Прежний загрузчик (getline + trim + split + create_user_from_record) против
+// отображения файла в память с разбором полей через string_view.
+// Аргумент: число строк в users.txt (по умолчанию 1000000)
+void bench_load(const vector<string>& args) {
+    size_t n = args.empty() ? 1000000 : stoul(args[0]);
+
+    ScratchDir dir("hr_bench_load");
+    write_synthetic_users(n);
+    cout << "Строк в users.txt: " << n << ", размер: "
+        << filesystem::file_size("users.txt") / 1024 << " КБ\n";
+
+    // Прогрев файлового кеша, чтобы оба варианта читали из памяти
+    {
+        MappedFile warm(USERS_FILE);
+        size_t lines = 0;
+        warm.for_each_line([&](string_view) { ++lines; });
+        do_not_optimize(lines);
+    }
+
+    const int rounds = 3;
+    double getline_ms = 1e300;
+    double mapped_ms = 1e300;
+    double store_ms = 1e300;
+
+    for (int r = 0; r < rounds; ++r) {
+        {
+            BenchTimer timer;
+            vector<unique_ptr<User>> users;
+            ifstream in(USERS_FILE);
+            string line;
+            while (getline(in, line)) {
+                line = trim(line);
+                if (line.empty()) continue;
+                auto u = UserFactory::create_user_from_record(line);
+                if (u) users.push_back(move(u));
+            }
+            getline_ms = min(getline_ms, timer.elapsed_ms());
+            do_not_optimize(users);
+        }
+        {
+            BenchTimer timer;
+            vector<unique_ptr<User>> users;
+            MappedFile file(USERS_FILE);
+            file.for_each_line([&](string_view line) {
+                string_view fields[5];
+                size_t count = split_fields(line, '|', fields, 5);
+                auto u = UserFactory::create_user_from_fields(fields, count);
+                if (u) users.push_back(move(u));
+            });
+            mapped_ms = min(mapped_ms, timer.elapsed_ms());
+            do_not_optimize(users);
+        }
+        {
+            // Полная загрузка хранилища, включая построение индекса логинов
+            BenchTimer timer;
+            UserStore store;
+            store_ms = min(store_ms, timer.elapsed_ms());
+            do_not_optimize(store);
+        }
+    }
+
+    cout << fixed << setprecision(1)
+        << "getline + split:          " << getline_ms << " мс\n"
+        << "MappedFile + string_view: " << mapped_ms << " мс (x" << setprecision(2)
+        << getline_ms / mapped_ms << ")\n" << setprecision(1)
+        << "UserStore (с индексом):   " << store_ms << " мс\n";
+    cout << resetiosflags(ios_base::floatfield);
+}
@@ -0,0 +1,114 @@
+#include "Bench.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+
+using namespace std;
+
+// --------------------------- Инфраструктура бенчмарков ---------------------------
+
+ScratchDir::ScratchDir(const string& name) {
+    previous_ = filesystem::current_path();
+    path_ = filesystem::temp_directory_path() / name;
+    filesystem::remove_all(path_);
+    filesystem::create_directories(path_);
+    filesystem::current_path(path_);
+}
+
+ScratchDir::~ScratchDir() {
+    filesystem::current_path(previous_);
+    error_code ec;
+    filesystem::remove_all(path_, ec);
+}
+
+// --------------------------- Счетчик выделений памяти ---------------------------
+
+static atomic<size_t> g_allocations{ 0 };
+
+size_t allocation_count() {
+    return g_allocations.load(memory_order_relaxed);
+}
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// --------------------------- Синтетические данные ---------------------------
+
+string synthetic_username(size_t i) {
+    return "user" + to_string(i);
+}
+
+void write_synthetic_users(size_t n) {
+    static const char* last_names[] = { "иванов", "петров", "сидоров", "смирнов", "кузнецов", "попов" };
+    static const char* first_names[] = { "иван", "петр", "алексей", "дмитрий", "сергей", "андрей" };
+    static const char* departments[] = { "Разработка", "QA", "Дизайн", "Маркетинг", "Продажи", "Поддержка" };
+
+    ofstream users("users.txt", ios::trunc);
+    for (size_t i = 0; i < n; ++i) {
+        users << synthetic_username(i) << "|" << (1000000007ull * (i + 1)) << "|"
+            << last_names[i % 6] << " " << first_names[(i / 6) % 6] << " " << i << "|"
+            << departments[(i / 36) % 6] << "|EMPLOYEE\n";
+    }
+
+    ofstream hr("hr_users.txt", ios::trunc);
+    ofstream admin("admin_users.txt", ios::trunc);
+    admin << "admin|0|Системный администратор|ADMIN|ADMIN\n";
+}
+
+// --------------------------- main ---------------------------
+// Запуск: Benchmarks.exe [имя_бенчмарка [аргументы...]]; без аргументов выполняются все,
+// кроме служебных команд (gen_data)
+int main(int argc, char* argv[]) {
+    const map<string, function<void(const vector<string>&)>> benches = {
+        { "user_index", bench_user_index },
+        { "load", bench_load },
+        { "parse", bench_parse },
+        { "scoring", bench_scoring },
+        { "search", bench_search },
+        { "case_fold", bench_case_fold },
+        { "e2e", bench_e2e },
+        { "utilities", bench_utilities },
+    };
+    // Служебные команды в общий прогон не входят
+    const map<string, function<void(const vector<string>&)>> tools = {
+        { "gen_data", gen_data },
+    };
+
+    vector<string> args(argv + 1, argv + argc);
+    if (args.empty()) {
+        for (const auto& [name, bench] : benches) {
+            cout << "=== " << name << " ===\n";
+            bench({});
+        }
+        return 0;
+    }
+
+    auto it = benches.find(args[0]);
+    if (it == benches.end()) {
+        it = tools.find(args[0]);
+        if (it == tools.end()) {
+            cerr << "Неизвестный бенчмарк: " << args[0] << "\nДоступные:";
+            for (const auto& [name, bench] : benches) cerr << " " << name;
+            for (const auto& [name, tool] : tools) cerr << " " << name;
+            cerr << "\n";
+            return 1;
+        }
+    }
+    it->second(vector<string>(args.begin() + 1, args.end()));
+    return 0;
+}
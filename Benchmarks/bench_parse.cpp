@@ -0,0 +1,52 @@
+#include "Bench.h"
+#include "Utilities.h"
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- Разбор записей ---------------------------
+// split() + trim() (vector<string> и новая строка на каждое поле) против
+// split_fields() поверх FieldRange: ожидается 0 выделений памяти на строку.
+// Аргумент: число строк (по умолчанию 1000000)
+void bench_parse(const vector<string>& args) {
+    size_t n = args.empty() ? 1000000 : stoul(args[0]);
+
+    vector<string> lines;
+    lines.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        lines.push_back(" " + synthetic_username(i) + " |" + to_string(1000000007ull * (i + 1)) +
+            "| Иванов Иван " + to_string(i) + " |Разработка| EMPLOYEE ");
+    }
+
+    size_t checksum = 0;
+
+    size_t allocs_before = allocation_count();
+    BenchTimer split_timer;
+    for (const auto& line : lines) {
+        auto parts = split(line, '|');
+        for (const auto& part : parts) checksum += trim(part).size();
+    }
+    double split_ns = split_timer.elapsed_ns() / n;
+    double split_allocs = double(allocation_count() - allocs_before) / n;
+    do_not_optimize(checksum);
+
+    allocs_before = allocation_count();
+    BenchTimer fields_timer;
+    for (const auto& line : lines) {
+        string_view fields[5];
+        size_t count = split_fields(line, '|', fields, 5);
+        for (size_t i = 0; i < count; ++i) checksum += fields[i].size();
+    }
+    double fields_ns = fields_timer.elapsed_ns() / n;
+    double fields_allocs = double(allocation_count() - allocs_before) / n;
+    do_not_optimize(checksum);
+
+    cout << left << setw(22) << "Способ" << setw(16) << "нс/строка" << "выделений/строка\n";
+    cout << string(54, '-') << "\n";
+    cout << fixed << setprecision(1)
+        << left << setw(22) << "split + trim" << setw(16) << split_ns << setprecision(2) << split_allocs << "\n"
+        << setprecision(1)
+        << left << setw(22) << "split_fields" << setw(16) << fields_ns << setprecision(2) << fields_allocs << "\n";
+    cout << resetiosflags(ios_base::floatfield);
+}
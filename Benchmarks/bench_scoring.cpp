@@ -0,0 +1,75 @@
+#include "Bench.h"
+#include "ScoringKernel.h"
+#include "SystemConfig.h"
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- Пакетный расчет оценок ---------------------------
+// Пересчет всей таблицы ScoreTable после изменения весов: поштучный
+// calculatePerformanceForDepartment против score_bulk на каждом доступном наборе
+// инструкций. Результаты каждой ветки сравниваются с поштучным расчетом побитово.
+// Аргумент: число строк (по умолчанию 10000000)
+void bench_scoring(const vector<string>& args) {
+    size_t n = args.empty() ? 10000000 : stoul(args[0]);
+
+    ScratchDir scratch("hr_bench_scoring");
+    SystemConfig config;
+
+    // Оценки с шагом 0.01 и дробные оценки задач, как у ProjectActivity::tasks_score()
+    BenchRandom random;
+    ScoreTable table;
+    table.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        table.add(static_cast<DepartmentId>(random.below(DEPARTMENT_COUNT)),
+            random.below(10001) / 100.0,
+            random.below(10001) / 100.0,
+            random.below(1000000) / 9999.0);
+    }
+
+    vector<double> expected(n);
+    BenchTimer scalar_timer;
+    for (size_t i = 0; i < n; ++i) {
+        double score = config.calculatePerformanceForDepartment(table.department_ids[i],
+            table.department_scores[i], table.teamwork_scores[i], table.tasks_scores[i]);
+        expected[i] = round(score * 100) / 100;
+    }
+    double scalar_ms = scalar_timer.elapsed_ms();
+    do_not_optimize(expected);
+
+    cout << "Строк: " << n << ", лучший набор инструкций: " << scoring_isa_name(scoring_isa()) << "\n";
+    cout << left << setw(26) << "Способ" << setw(12) << "мс" << setw(14) << "нс/строка" << "расхождений\n";
+    cout << string(64, '-') << "\n";
+    cout << fixed << setprecision(2)
+        << left << setw(26) << "calculatePerformance..." << setw(12) << scalar_ms
+        << setw(14) << scalar_ms * 1e6 / n << "-\n";
+
+    vector<double> weights(DEPARTMENT_COUNT);
+    for (size_t i = 0; i < DEPARTMENT_COUNT; ++i) {
+        weights[i] = config.getDepartmentWeight(static_cast<DepartmentId>(i));
+    }
+
+    vector<double> out(n);
+    for (ScoringIsa isa : { ScoringIsa::SCALAR, ScoringIsa::SSE2, ScoringIsa::AVX2 }) {
+        if (static_cast<int>(isa) > static_cast<int>(scoring_isa())) continue;
+
+        BenchTimer timer;
+        score_bulk(weights.data(), config.getTeamworkWeight(), config.getTasksWeight(),
+            reinterpret_cast<const unsigned char*>(table.department_ids.data()),
+            table.department_scores.data(), table.teamwork_scores.data(), table.tasks_scores.data(),
+            out.data(), n, isa);
+        double ms = timer.elapsed_ms();
+        do_not_optimize(out);
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (memcmp(&out[i], &expected[i], sizeof(double)) != 0) ++mismatches;
+        }
+        cout << left << setw(26) << (string("score_bulk ") + scoring_isa_name(isa)) << setw(12) << ms
+            << setw(14) << ms * 1e6 / n << mismatches << "\n";
+    }
+    cout << resetiosflags(ios_base::floatfield);
+}
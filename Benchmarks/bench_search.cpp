@@ -0,0 +1,91 @@
+#include "Bench.h"
+#include "UserClasses.h"
+#include "Projects.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- UserStore::search_employees_by_name ---------------------------
+// Сравнивает триграммный индекс с прежним проходом по всем сотрудникам с приведением
+// ФИО и логина к нижнему регистру. Запросы - как в строке поиска HR: часть ФИО
+// с номером ("ов петр 4242"), логин и отсутствующее имя.
+// Аргумент: максимальное число пользователей (по умолчанию 1000000)
+static vector<const User*> linear_search(const UserStore& store, const string& keyword) {
+    vector<const User*> result;
+    string keyword_lower = keyword;
+    transform(keyword_lower.begin(), keyword_lower.end(), keyword_lower.begin(), ::tolower);
+
+    for (const auto& user : store.users()) {
+        if (user->role() == Role::EMPLOYEE || user->role() == Role::PENDING) {
+            string fullname_lower = user->fullname();
+            transform(fullname_lower.begin(), fullname_lower.end(), fullname_lower.begin(), ::tolower);
+
+            string username_lower = user->username();
+            transform(username_lower.begin(), username_lower.end(), username_lower.begin(), ::tolower);
+
+            if (fullname_lower.find(keyword_lower) != string::npos ||
+                username_lower.find(keyword_lower) != string::npos) {
+                result.push_back(user.get());
+            }
+        }
+    }
+    return result;
+}
+
+void bench_search(const vector<string>& args) {
+    size_t max_users = args.empty() ? 1000000 : stoul(args[0]);
+
+    cout << left << setw(12) << "Польз."
+        << setw(16) << "Загрузка, мс"
+        << setw(20) << "Индекс, мкс/поиск"
+        << setw(20) << "Линейно, мкс/поиск"
+        << setw(12) << "Найдено" << "\n";
+    cout << string(80, '-') << "\n";
+
+    for (size_t n = 1000; n <= max_users; n *= 10) {
+        ScratchDir dir("hr_bench_search");
+        write_synthetic_users(n);
+
+        BenchTimer load_timer;
+        UserStore store;
+        double load_ms = load_timer.elapsed_ms();
+
+        BenchRandom rng;
+        vector<string> queries;
+        const size_t query_count = 3000;
+        queries.reserve(query_count);
+        for (size_t i = 0; i < query_count; ++i) {
+            const User* user = store.users()[rng.below(n)].get();
+            switch (i % 3) {
+            case 0: queries.push_back(user->fullname().substr(user->fullname().find(' ') - 2)); break;
+            case 1: queries.push_back(user->username()); break;
+            default: queries.push_back("нет такого " + to_string(i)); break;
+            }
+        }
+
+        size_t found = 0;
+        BenchTimer index_timer;
+        for (const auto& q : queries) {
+            found += store.search_employees_by_name(q).size();
+        }
+        double index_us = index_timer.elapsed_ns() / query_count / 1000;
+        double found_avg = static_cast<double>(found) / query_count;
+
+        size_t linear_count = max<size_t>(3, min<size_t>(query_count, 30000000 / n / 10));
+        BenchTimer linear_timer;
+        for (size_t i = 0; i < linear_count; ++i) {
+            found += linear_search(store, queries[i]).size();
+        }
+        double linear_us = linear_timer.elapsed_ns() / linear_count / 1000;
+        do_not_optimize(found);
+
+        cout << left << setw(12) << n
+            << setw(16) << fixed << setprecision(1) << load_ms
+            << setw(20) << setprecision(2) << index_us
+            << setw(20) << setprecision(1) << linear_us
+            << setw(12) << found_avg << "\n";
+    }
+    cout << resetiosflags(ios_base::floatfield);
+}
@@ -0,0 +1,66 @@
+#include "Bench.h"
+#include "UserClasses.h"
+#include "Projects.h"
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- UserStore::find_by_username ---------------------------
+// Сравнивает хеш-индекс логинов с прежним линейным проходом по всем уровням хранилища.
+// Время поиска по индексу не должно расти с числом пользователей.
+// Аргумент: максимальное число пользователей (по умолчанию 1000000)
+void bench_user_index(const vector<string>& args) {
+    size_t max_users = args.empty() ? 1000000 : stoul(args[0]);
+
+    cout << left << setw(12) << "Польз."
+        << setw(16) << "Загрузка, мс"
+        << setw(20) << "Индекс, нс/поиск"
+        << setw(20) << "Линейно, нс/поиск" << "\n";
+    cout << string(68, '-') << "\n";
+
+    for (size_t n = 1000; n <= max_users; n *= 10) {
+        ScratchDir dir("hr_bench_user_index");
+        write_synthetic_users(n);
+
+        BenchTimer load_timer;
+        UserStore store;
+        double load_ms = load_timer.elapsed_ms();
+
+        // Половина запросов — существующие логины, половина — отсутствующие
+        BenchRandom rng;
+        vector<string> queries;
+        const size_t query_count = 200000;
+        queries.reserve(query_count);
+        for (size_t i = 0; i < query_count; ++i) {
+            queries.push_back(i % 2 ? synthetic_username(rng.below(n)) : "missing" + to_string(i));
+        }
+
+        size_t found = 0;
+        BenchTimer index_timer;
+        for (const auto& q : queries) {
+            if (store.find_by_username(q)) ++found;
+        }
+        double index_ns = index_timer.elapsed_ns() / query_count;
+        do_not_optimize(found);
+
+        // Прежний алгоритм: админ, затем HR, затем все сотрудники по порядку
+        auto all = store.all_users();
+        size_t linear_count = max<size_t>(100, 20000000 / n);
+        BenchTimer linear_timer;
+        for (size_t i = 0; i < linear_count; ++i) {
+            const string& q = queries[i % query_count];
+            for (const User* u : all) {
+                if (u->username() == q) { ++found; break; }
+            }
+        }
+        double linear_ns = linear_timer.elapsed_ns() / linear_count;
+        do_not_optimize(found);
+
+        cout << left << setw(12) << n
+            << setw(16) << fixed << setprecision(1) << load_ms
+            << setw(20) << index_ns
+            << setw(20) << linear_ns << "\n";
+    }
+    cout << resetiosflags(ios_base::floatfield);
+}
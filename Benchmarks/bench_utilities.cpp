@@ -0,0 +1,126 @@
+#include "Bench.h"
+#include "Utilities.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- Строковые функции Utilities ---------------------------
+// trim, split, toLower, format_cell, print_table_row и now_string на строках ASCII и
+// CP1251 разной длины: нс на вызов и выделений памяти на вызов. Для сравнения рядом
+// стоят варианты без выделений (trim(string_view), split_fields).
+// print_table_row пишет в cout, который на время замеров отбрасывает вывод, поэтому
+// измеряется форматирование, а не консоль.
+// Аргумент: суммарный объем текста в байтах на один замер (по умолчанию 16 МБ)
+namespace {
+    string make_text(BenchRandom& random, size_t length, bool cyrillic) {
+        string text(length, ' ');
+        for (char& c : text) {
+            size_t kind = random.below(100);
+            if (kind < 85) {
+                c = cyrillic ? static_cast<char>(0xC0 + random.below(64))
+                    : static_cast<char>((random.below(2) ? 'A' : 'a') + random.below(26));
+            }
+            else if (kind < 90) c = static_cast<char>('0' + random.below(10));
+            else c = ' ';
+        }
+        return text;
+    }
+
+    struct UtilityResult {
+        const char* name;
+        double ns;
+        double allocs;
+    };
+
+    // call(i) - вызов на i-м тексте набора; возвращает что-нибудь от результата
+    template <typename Call>
+    UtilityResult measure(const char* name, size_t calls, size_t texts, Call&& call) {
+        size_t checksum = 0;
+        size_t allocs_before = allocation_count();
+        BenchTimer timer;
+        for (size_t k = 0; k < calls; ++k) checksum += call(k % texts);
+        double ns = timer.elapsed_ns() / calls;
+        double allocs = double(allocation_count() - allocs_before) / calls;
+        do_not_optimize(checksum);
+        return { name, ns, allocs };
+    }
+
+    void print_result(const string& length, const char* text_kind, const UtilityResult& result) {
+        cout << left << setw(8) << length << setw(8) << text_kind << setw(28) << result.name
+            << setw(12) << fixed << setprecision(1) << result.ns << setprecision(2) << result.allocs << "\n";
+    }
+}
+
+void bench_utilities(const vector<string>& args) {
+    size_t volume = args.empty() ? (16u << 20) : stoul(args[0]);
+    const size_t text_count = 16;
+
+    cout << left << setw(8) << "Длина" << setw(8) << "Текст" << setw(28) << "Функция"
+        << setw(12) << "нс/вызов" << "выделений/вызов\n";
+    cout << string(72, '-') << "\n";
+
+    BenchRandom random;
+    for (size_t length : { 8, 32, 128, 1024 }) {
+        size_t calls = max<size_t>(1000, volume / length);
+
+        for (bool cyrillic : { false, true }) {
+            vector<string> texts;
+            vector<string> padded;
+            vector<string> records;
+            for (size_t i = 0; i < text_count; ++i) {
+                texts.push_back(make_text(random, length, cyrillic));
+                padded.push_back("  " + texts.back() + " \t");
+                // Запись с полями по 8 символов, как строки файлов данных
+                string record = texts.back();
+                for (size_t p = 7; p < record.size(); p += 8) record[p] = '|';
+                records.push_back(move(record));
+            }
+
+            // Строки таблицы из 4 ячеек этой длины; ширины столбцов - как в списке сотрудников
+            vector<vector<string>> rows;
+            for (size_t i = 0; i < text_count; ++i) {
+                rows.push_back({ texts[i], texts[(i + 1) % text_count], texts[(i + 2) % text_count],
+                    texts[(i + 3) % text_count] });
+            }
+            const vector<size_t> widths = { 15, 30, 20, 12 };
+
+            // toLower меняет строку на месте: каждый вызов начинается с копии в готовый буфер
+            string work;
+            work.reserve(length);
+
+            vector<UtilityResult> results;
+            {
+                SilentCout silent;
+                results.push_back(measure("trim(string)", calls, text_count,
+                    [&](size_t i) { return trim(padded[i]).size(); }));
+                results.push_back(measure("trim(string_view)", calls, text_count,
+                    [&](size_t i) { return trim(string_view(padded[i])).size(); }));
+                results.push_back(measure("split", calls, text_count,
+                    [&](size_t i) { return split(records[i], '|').size(); }));
+                results.push_back(measure("split_fields", calls, text_count, [&](size_t i) {
+                    string_view fields[256];
+                    return split_fields(records[i], '|', fields, size(fields));
+                }));
+                results.push_back(measure("toLower", calls, text_count, [&](size_t i) {
+                    work.assign(texts[i]);
+                    return toLower(work).size();
+                }));
+                results.push_back(measure("format_cell (дополнение)", calls, text_count,
+                    [&](size_t i) { return format_cell(texts[i], length + 8).size(); }));
+                results.push_back(measure("format_cell (обрезка)", calls, text_count,
+                    [&](size_t i) { return format_cell(texts[i], max<size_t>(4, length / 2)).size(); }));
+                results.push_back(measure("print_table_row", calls / 4, text_count, [&](size_t i) {
+                    print_table_row(rows[i], widths);
+                    return rows[i].size();
+                }));
+            }
+            for (const auto& result : results) print_result(to_string(length), cyrillic ? "CP1251" : "ASCII", result);
+        }
+    }
+
+    // now_string от входа не зависит
+    print_result("-", "-", measure("now_string", 100000, 1, [](size_t) { return now_string().size(); }));
+    cout << resetiosflags(ios_base::floatfield);
+}
@@ -0,0 +1,195 @@
+#include "CaseFold.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CASEFOLD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__)
+#define CASEFOLD_TARGET_SSE2 __attribute__((target("sse2")))
+#define CASEFOLD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CASEFOLD_TARGET_SSE2
+#define CASEFOLD_TARGET_AVX2
+#endif
+
+using namespace std;
+
+// --------------------------- Скалярная ветка ---------------------------
+
+static void fold_scalar(const char* src, char* dst, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) dst[i] = fold_case_cp1251(src[i]);
+}
+
+#ifdef CASEFOLD_X86
+
+// --------------------------- Векторные ветки ---------------------------
+// Блоком сдвигаются два сплошных диапазона: A..Z и А..Я (0xC0-0xDF), +0x20, и Ё (+0x10).
+// Остальные байты 0x80-0xBF (Ў, Є, кавычки, №...) идут вразнобой - блок, где они есть,
+// кроме Ё и ё, досчитывается по таблице. В русских именах таких блоков почти нет.
+// Беззнаковое "c - lo <= hi - lo" в SSE2 записывается через min_epu8.
+
+CASEFOLD_TARGET_SSE2
+static void fold_sse2(const char* src, char* dst, size_t size) {
+    const __m128i upper_a = _mm_set1_epi8('A');
+    const __m128i latin_span = _mm_set1_epi8('Z' - 'A');
+    const __m128i cyrillic_a = _mm_set1_epi8(static_cast<char>(0xC0));
+    const __m128i cyrillic_span = _mm_set1_epi8(0x1F);
+    const __m128i irregular_mask = _mm_set1_epi8(static_cast<char>(0xC0));
+    const __m128i irregular_bits = _mm_set1_epi8(static_cast<char>(0x80));
+    const __m128i upper_yo = _mm_set1_epi8(static_cast<char>(0xA8));
+    const __m128i lower_yo = _mm_set1_epi8(static_cast<char>(0xB8));
+    const __m128i shift = _mm_set1_epi8(0x20);
+    const __m128i yo_shift = _mm_set1_epi8(0x10);
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+        __m128i is_upper_yo = _mm_cmpeq_epi8(v, upper_yo);
+        __m128i is_yo = _mm_or_si128(is_upper_yo, _mm_cmpeq_epi8(v, lower_yo));
+        __m128i irregular = _mm_andnot_si128(is_yo,
+            _mm_cmpeq_epi8(_mm_and_si128(v, irregular_mask), irregular_bits));
+        if (_mm_movemask_epi8(irregular) != 0) {
+            fold_scalar(src, dst, i, i + 16);
+            continue;
+        }
+
+        __m128i latin = _mm_sub_epi8(v, upper_a);
+        __m128i in_latin = _mm_cmpeq_epi8(_mm_min_epu8(latin, latin_span), latin);
+        __m128i cyrillic = _mm_sub_epi8(v, cyrillic_a);
+        __m128i in_cyrillic = _mm_cmpeq_epi8(_mm_min_epu8(cyrillic, cyrillic_span), cyrillic);
+
+        __m128i upper = _mm_or_si128(in_latin, in_cyrillic);
+        v = _mm_add_epi8(v, _mm_and_si128(upper, shift));
+        v = _mm_add_epi8(v, _mm_and_si128(is_upper_yo, yo_shift));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+    }
+    fold_scalar(src, dst, i, size);
+}
+
+CASEFOLD_TARGET_AVX2
+static void fold_avx2(const char* src, char* dst, size_t size) {
+    const __m256i upper_a = _mm256_set1_epi8('A');
+    const __m256i latin_span = _mm256_set1_epi8('Z' - 'A');
+    const __m256i cyrillic_a = _mm256_set1_epi8(static_cast<char>(0xC0));
+    const __m256i cyrillic_span = _mm256_set1_epi8(0x1F);
+    const __m256i irregular_mask = _mm256_set1_epi8(static_cast<char>(0xC0));
+    const __m256i irregular_bits = _mm256_set1_epi8(static_cast<char>(0x80));
+    const __m256i upper_yo = _mm256_set1_epi8(static_cast<char>(0xA8));
+    const __m256i lower_yo = _mm256_set1_epi8(static_cast<char>(0xB8));
+    const __m256i shift = _mm256_set1_epi8(0x20);
+    const __m256i yo_shift = _mm256_set1_epi8(0x10);
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+
+        __m256i is_upper_yo = _mm256_cmpeq_epi8(v, upper_yo);
+        __m256i is_yo = _mm256_or_si256(is_upper_yo, _mm256_cmpeq_epi8(v, lower_yo));
+        __m256i irregular = _mm256_andnot_si256(is_yo,
+            _mm256_cmpeq_epi8(_mm256_and_si256(v, irregular_mask), irregular_bits));
+        if (_mm256_movemask_epi8(irregular) != 0) {
+            fold_scalar(src, dst, i, i + 32);
+            continue;
+        }
+
+        __m256i latin = _mm256_sub_epi8(v, upper_a);
+        __m256i in_latin = _mm256_cmpeq_epi8(_mm256_min_epu8(latin, latin_span), latin);
+        __m256i cyrillic = _mm256_sub_epi8(v, cyrillic_a);
+        __m256i in_cyrillic = _mm256_cmpeq_epi8(_mm256_min_epu8(cyrillic, cyrillic_span), cyrillic);
+
+        __m256i upper = _mm256_or_si256(in_latin, in_cyrillic);
+        v = _mm256_add_epi8(v, _mm256_and_si256(upper, shift));
+        v = _mm256_add_epi8(v, _mm256_and_si256(is_upper_yo, yo_shift));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+    }
+    fold_scalar(src, dst, i, size);
+}
+
+#endif
+
+// --------------------------- Диспетчер ---------------------------
+
+// Короче блока вектор не дает выигрыша
+static constexpr size_t VECTOR_MIN_SIZE = 16;
+
+void fold_case_cp1251(const char* src, size_t size, char* dst, ScoringIsa isa) {
+#ifdef CASEFOLD_X86
+    if (size >= VECTOR_MIN_SIZE) {
+        ScoringIsa available = scoring_isa();
+        if (isa == ScoringIsa::AVX2 && available == ScoringIsa::AVX2) {
+            fold_avx2(src, dst, size);
+            return;
+        }
+        if (isa != ScoringIsa::SCALAR && available != ScoringIsa::SCALAR) {
+            fold_sse2(src, dst, size);
+            return;
+        }
+    }
+#endif
+    fold_scalar(src, dst, 0, size);
+}
+
+string folded_cp1251(string_view text) {
+    string result(text.size(), '\0');
+    fold_case_cp1251(text.data(), text.size(), result.data());
+    return result;
+}
+
+bool equals_fold_cp1251(string_view a, string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (fold_case_cp1251(a[i]) != fold_case_cp1251(b[i])) return false;
+    }
+    return true;
+}
+
+// --------------------------- UTF-8 ---------------------------
+// U+0400..U+040F (D0 80..8F) -> U+0450..U+045F (D1 90..9F)
+// U+0410..U+041F (D0 90..9F) -> U+0430..U+043F (D0 B0..BF)
+// U+0420..U+042F (D0 A0..AF) -> U+0440..U+044F (D1 80..8F)
+// U+0490 Ґ       (D2 90)     -> U+0491         (D2 91)
+
+void fold_case_utf8(const char* src, size_t size, char* dst) {
+    size_t i = 0;
+    while (i < size) {
+        unsigned char lead = static_cast<unsigned char>(src[i]);
+        if (lead < 0x80) {
+            dst[i] = fold_case_cp1251(src[i]);
+            ++i;
+            continue;
+        }
+        unsigned char next = i + 1 < size ? static_cast<unsigned char>(src[i + 1]) : 0;
+        if ((lead == 0xD0 || lead == 0xD2) && (next & 0xC0) == 0x80) {
+            unsigned char out_lead = lead;
+            unsigned char out_next = next;
+            if (lead == 0xD0 && next >= 0x80 && next <= 0x8F) {
+                out_lead = 0xD1;
+                out_next = static_cast<unsigned char>(next + 0x10);
+            }
+            else if (lead == 0xD0 && next >= 0x90 && next <= 0x9F) {
+                out_next = static_cast<unsigned char>(next + 0x20);
+            }
+            else if (lead == 0xD0 && next >= 0xA0 && next <= 0xAF) {
+                out_lead = 0xD1;
+                out_next = static_cast<unsigned char>(next - 0x20);
+            }
+            else if (lead == 0xD2 && next == 0x90) {
+                out_next = 0x91;
+            }
+            dst[i] = static_cast<char>(out_lead);
+            dst[i + 1] = static_cast<char>(out_next);
+            i += 2;
+            continue;
+        }
+        dst[i] = src[i];
+        ++i;
+    }
+}
+
+string folded_utf8(string_view text) {
+    string result(text.size(), '\0');
+    fold_case_utf8(text.data(), text.size(), result.data());
+    return result;
+}
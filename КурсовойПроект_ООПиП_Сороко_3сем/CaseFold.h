@@ -0,0 +1,66 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "ScoringKernel.h"
+
+using namespace std;
+
+// --------------------------- Приведение к нижнему регистру ---------------------------
+// Не зависит от глобальной локали (std::tolower в русской локали Windows приводит
+// кириллицу, в классической - нет). Приводятся ASCII и вся кириллица CP1251:
+// А..Я, Ё, а также Ђ Ѓ Є Ѕ І Ї Ј Љ Њ Ћ Ќ Ў Џ Ґ.
+
+constexpr array<unsigned char, 256> make_cp1251_fold_table() {
+    array<unsigned char, 256> table{};
+    for (size_t c = 0; c < table.size(); ++c) table[c] = static_cast<unsigned char>(c);
+
+    for (size_t c = 'A'; c <= 'Z'; ++c) table[c] = static_cast<unsigned char>(c + 0x20);
+    for (size_t c = 0xC0; c <= 0xDF; ++c) table[c] = static_cast<unsigned char>(c + 0x20);
+
+    // Прописные и строчные буквы верхней половины, не идущие блоком
+    constexpr unsigned char pairs[][2] = {
+        { 0x80, 0x90 }, { 0x81, 0x83 }, { 0x8A, 0x9A }, { 0x8C, 0x9C }, { 0x8D, 0x9D },
+        { 0x8E, 0x9E }, { 0x8F, 0x9F }, { 0xA1, 0xA2 }, { 0xA3, 0xBC }, { 0xA5, 0xB4 },
+        { 0xA8, 0xB8 }, { 0xAA, 0xBA }, { 0xAF, 0xBF }, { 0xB2, 0xB3 }, { 0xBD, 0xBE },
+    };
+    for (const auto& pair : pairs) table[pair[0]] = pair[1];
+    return table;
+}
+
+inline constexpr array<unsigned char, 256> CP1251_FOLD_TABLE = make_cp1251_fold_table();
+
+constexpr char fold_case_cp1251(char ch) {
+    return static_cast<char>(CP1251_FOLD_TABLE[static_cast<unsigned char>(ch)]);
+}
+
+static_assert(fold_case_cp1251('Q') == 'q' && fold_case_cp1251('q') == 'q');
+static_assert(fold_case_cp1251('\xC0') == '\xE0' && fold_case_cp1251('\xDF') == '\xFF');  // А, Я
+static_assert(fold_case_cp1251('\xA8') == '\xB8');                                        // Ё
+
+// Приводит size байтов src в dst (dst может совпадать с src). Длинные строки
+// обрабатываются блоками по 16/32 байта (SSE2/AVX2); набор инструкций определяется
+// так же, как для score_bulk. Если он не поддерживается процессором - берется лучший доступный.
+void fold_case_cp1251(const char* src, size_t size, char* dst, ScoringIsa isa = scoring_isa());
+
+// Копия строки в нижнем регистре
+string folded_cp1251(string_view text);
+
+// Равенство без учета регистра, без выделения памяти
+bool equals_fold_cp1251(string_view a, string_view b);
+
+// То же для текста в UTF-8 (ввод из файлов и консоли с кодовой страницей 65001).
+// Строчные и прописные буквы кириллицы кодируются одинаковым числом байтов,
+// поэтому результат имеет ту же длину; остальные символы и некорректные
+// последовательности копируются как есть.
+void fold_case_utf8(const char* src, size_t size, char* dst);
+string folded_utf8(string_view text);
+
+namespace HRSystem {
+    using ::fold_case_cp1251;
+    using ::folded_cp1251;
+    using ::equals_fold_cp1251;
+    using ::fold_case_utf8;
+    using ::folded_utf8;
+}
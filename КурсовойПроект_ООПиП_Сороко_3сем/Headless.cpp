@@ -0,0 +1,591 @@
+#include "UserClasses.h"
+#include "Projects.h"
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- Командный режим ---------------------------
+// Команда - строка с полями через '|', как записи файлов данных (текст в CP1251):
+//   add-employee|логин|пароль|ФИО|отдел       remove-employee|логин
+//   edit-employee|логин|ФИО|отдел             employee|логин
+//   add-project|название|описание[|статус]    remove-project|название
+//   assign|логин|проект[|роль]                unassign|логин|проект
+//   score|логин|оценка_отдела|оценка_команды  report|логин[|txt|json|csv]
+//   rank|логин                                top|k[|отдел]
+//   search|текст[|лимит]                      search-projects|текст[|лимит]
+//   begin / commit / rollback - пакетная запись обоих хранилищ. rollback откатывает только
+//   сотрудников и проекты, поэтому score и report внутри пакета отклоняются с ошибкой
+//   help, exit
+// Пустые строки и строки с '#' пропускаются. Команды вызывают те же методы хранилищ,
+// что и меню, с теми же проверками; логины, как и в меню, приводятся к нижнему регистру.
+//
+// Ответ - по строке JSON на команду:
+//   {"line":3,"command":"rank","status":"ok","ms":0.0042,"result":{...}}
+//   {"line":4,"command":"assign","status":"error","ms":0.0011,"error":"..."}
+// и итоговая строка {"summary":{...}}. ms - время выполнения самой команды, без разбора и вывода.
+// Пакеты, не закрытые до конца сценария, записываются; их число - summary.unclosed_batches.
+
+namespace {
+
+// Запись JSON в строку с расстановкой запятых между элементами
+class JsonWriter {
+public:
+    explicit JsonWriter(string& out) : out_(out) {}
+
+    JsonWriter& key(string_view name) {
+        separate();
+        out_ += '"';
+        out_ += name;
+        out_ += "\":";
+        need_comma_ = false;
+        return *this;
+    }
+    JsonWriter& value(string_view text) {
+        separate();
+        append_json_string(out_, text);
+        need_comma_ = true;
+        return *this;
+    }
+    JsonWriter& value(const char* text) { return value(string_view(text)); }
+    JsonWriter& value(long long number) {
+        separate();
+        char buf[24];
+        auto result = to_chars(buf, buf + sizeof(buf), number);
+        out_.append(buf, result.ptr);
+        need_comma_ = true;
+        return *this;
+    }
+    JsonWriter& value(int number) { return value(static_cast<long long>(number)); }
+    JsonWriter& value(size_t number) { return value(static_cast<long long>(number)); }
+    JsonWriter& value(double number, int precision) {
+        separate();
+        char buf[32];
+        auto result = to_chars(buf, buf + sizeof(buf), number, chars_format::fixed, precision);
+        out_.append(buf, result.ptr);
+        need_comma_ = true;
+        return *this;
+    }
+    JsonWriter& null() {
+        separate();
+        out_ += "null";
+        need_comma_ = true;
+        return *this;
+    }
+    JsonWriter& begin_object() { return open('{'); }
+    JsonWriter& end_object() { return close('}'); }
+    JsonWriter& begin_array() { return open('['); }
+    JsonWriter& end_array() { return close(']'); }
+
+private:
+    string& out_;
+    bool need_comma_ = false;
+
+    void separate() {
+        if (need_comma_) out_ += ',';
+    }
+    JsonWriter& open(char bracket) {
+        separate();
+        out_ += bracket;
+        need_comma_ = false;
+        return *this;
+    }
+    JsonWriter& close(char bracket) {
+        out_ += bracket;
+        need_comma_ = true;
+        return *this;
+    }
+};
+
+// Аргументы команды без ее имени; отсутствующий необязательный аргумент - пустой
+struct CommandArgs {
+    static constexpr size_t MAX = 8;
+    string_view values[MAX];
+    size_t count = 0;
+
+    string_view operator[](size_t i) const { return i < count ? values[i] : string_view(); }
+};
+
+struct Command {
+    size_t min_args;
+    size_t max_args;
+    const char* usage;
+    // Заполняет result (объект уже открыт) или возвращает false с текстом в error
+    function<bool(const CommandArgs& args, JsonWriter& result, string& error)> run;
+};
+
+bool parse_count(string_view text, size_t& value) {
+    auto result = from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == errc() && result.ptr == text.data() + text.size();
+}
+
+void write_employee(JsonWriter& json, const User* user) {
+    json.begin_object()
+        .key("username").value(user->username())
+        .key("fullname").value(user->fullname())
+        .key("department").value(user->department())
+        .key("role").value(role_to_string(user->role()))
+        .end_object();
+}
+
+} // namespace
+
+int Application::run_headless(istream& in, ostream& out) {
+    const size_t DEFAULT_SEARCH_LIMIT = 100;
+    const string RESERVED_LOGINS[] = { "admin", "administrator", "root" };
+
+    StringMap<Command> commands;
+
+    commands["add-employee"] = { 4, 4, "add-employee|логин|пароль|ФИО|отдел",
+        [this, &RESERVED_LOGINS](const CommandArgs& args, JsonWriter& result, string& error) {
+            string username = login_of(args[0]);
+            string password(args[1]);
+            if (username.empty() || args[2].empty() || args[3].empty()) {
+                error = "логин, ФИО и отдел не могут быть пустыми";
+                return false;
+            }
+            if (find(begin(RESERVED_LOGINS), end(RESERVED_LOGINS), username) != end(RESERVED_LOGINS)) {
+                error = "логин зарезервирован системой";
+                return false;
+            }
+            if (store_->find_by_username(username) != nullptr) {
+                error = "сотрудник с таким логином уже существует";
+                return false;
+            }
+            if (password.length() < 6) {
+                error = "пароль должен содержать минимум 6 символов";
+                return false;
+            }
+            string password_hash = hash_password(password);
+            if (store_->is_password_already_used(password_hash)) {
+                error = "пароль уже используется другим пользователем";
+                return false;
+            }
+
+            auto employee = UserFactory::create_user(username, password_hash, string(args[2]), string(args[3]),
+                Role::EMPLOYEE);
+            if (!store_->add_user(move(employee))) {
+                error = "ошибка добавления сотрудника";
+                return false;
+            }
+            result.key("username").value(username);
+            return true;
+        } };
+
+    commands["remove-employee"] = { 1, 1, "remove-employee|логин",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            string username = login_of(args[0]);
+            if (!store_->get_employee(username)) {
+                error = "сотрудник не найден";
+                return false;
+            }
+
+            // Как в меню: сначала назначения на проекты, затем сам сотрудник
+            size_t unassigned = 0;
+            {
+                ProjectStore::Transaction tx(*project_store_);
+                for (const Project* project : project_store_->get_employee_projects(username)) {
+                    string project_name = project->name();
+                    if (project_store_->remove_employee_from_project(username, project_name)) ++unassigned;
+                }
+                tx.commit();
+            }
+            if (!store_->remove_user_by_username(username)) {
+                error = "ошибка удаления сотрудника";
+                return false;
+            }
+            result.key("username").value(username).key("unassigned").value(unassigned);
+            return true;
+        } };
+
+    commands["edit-employee"] = { 3, 3, "edit-employee|логин|ФИО|отдел",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            string username = login_of(args[0]);
+            if (args[1].empty() || args[2].empty()) {
+                error = "ФИО и отдел не могут быть пустыми";
+                return false;
+            }
+            if (!store_->get_employee(username) ||
+                !store_->update_employee(username, string(args[1]), string(args[2]))) {
+                error = "сотрудник не найден";
+                return false;
+            }
+            result.key("username").value(username);
+            return true;
+        } };
+
+    commands["employee"] = { 1, 1, "employee|логин",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            const User* employee = store_->get_employee(login_of(args[0]));
+            if (!employee) {
+                error = "сотрудник не найден";
+                return false;
+            }
+            ProjectActivity activity = project_store_->get_employee_activity(employee->username());
+            result.key("username").value(employee->username())
+                .key("fullname").value(employee->fullname())
+                .key("department").value(employee->department())
+                .key("role").value(role_to_string(employee->role()))
+                .key("projects").value(activity.total_projects)
+                .key("score");
+            if (system_config_->hasPerformanceScore(employee->username())) {
+                result.value(system_config_->getPerformanceScore(employee->username()), 2);
+            }
+            else {
+                result.null();
+            }
+            return true;
+        } };
+
+    commands["add-project"] = { 2, 3, "add-project|название|описание[|статус]",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            if (args[0].empty() || args[1].empty()) {
+                error = "название и описание проекта не могут быть пустыми";
+                return false;
+            }
+            string status = args[2].empty() ? string("активный") : string(args[2]);
+            if (!project_store_->add_project(make_unique<Project>(string(args[0]), string(args[1]), status))) {
+                error = "проект с таким названием уже существует";
+                return false;
+            }
+            result.key("project").value(args[0]).key("status").value(status);
+            return true;
+        } };
+
+    commands["remove-project"] = { 1, 1, "remove-project|название",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            string name(args[0]);
+            if (!project_store_->remove_project(name)) {
+                error = "проект не найден";
+                return false;
+            }
+            result.key("project").value(name);
+            return true;
+        } };
+
+    commands["assign"] = { 2, 3, "assign|логин|проект[|роль]",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            string username = login_of(args[0]);
+            string project_name(args[1]);
+            string role = args[2].empty() ? string("Участник") : string(args[2]);
+            if (!store_->get_employee(username)) {
+                error = "сотрудник не найден";
+                return false;
+            }
+            if (!project_store_->find_project(project_name)) {
+                error = "проект не найден";
+                return false;
+            }
+            if (!project_store_->assign_employee_to_project(username, project_name, role)) {
+                error = "сотрудник уже назначен на этот проект";
+                return false;
+            }
+            result.key("username").value(username).key("project").value(project_name).key("role").value(role);
+            return true;
+        } };
+
+    commands["unassign"] = { 2, 2, "unassign|логин|проект",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            string username = login_of(args[0]);
+            string project_name(args[1]);
+            if (!project_store_->remove_employee_from_project(username, project_name)) {
+                error = "сотрудник не назначен на этот проект";
+                return false;
+            }
+            result.key("username").value(username).key("project").value(project_name);
+            return true;
+        } };
+
+    // Тот же расчет, что в меню и в пакетном расчете (Application::prepare_performance).
+    // Оценки пишутся сразу, мимо пакета хранилищ, поэтому внутри begin/commit запрещены
+    commands["score"] = { 3, 3, "score|логин|оценка_отдела|оценка_команды (вне begin/commit)",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            if (store_->in_batch() || project_store_->in_batch()) {
+                error = "score внутри пакета запрещен: rollback не отменяет оценки, выполните после commit";
+                return false;
+            }
+
+            double departmentScore = 0;
+            double teamworkScore = 0;
+            if (!parse_decimal(trim(args[1]), departmentScore) || !parse_decimal(trim(args[2]), teamworkScore)) {
+                error = "оценка должна быть числом";
+                return false;
+            }
+
+            const User* employee = store_->get_employee(login_of(args[0]));
+            if (!employee) {
+                error = "сотрудник не найден";
+                return false;
+            }
+            PerformanceInput performance;
+            if (!prepare_performance(*employee, departmentScore, teamworkScore, performance, error)) {
+                return false;
+            }
+            double finalScore = save_performance(employee->username(), performance);
+
+            result.key("username").value(employee->username())
+                .key("tasks_score").value(performance.tasks_score, 2)
+                .key("score").value(finalScore, 2);
+            return true;
+        } };
+
+    // Отчет сохраняется в архив сразу, мимо пакета - как и score, только вне begin/commit
+    commands["report"] = { 1, 2, "report|логин[|txt|json|csv] (вне begin/commit)",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            if (store_->in_batch() || project_store_->in_batch()) {
+                error = "report внутри пакета запрещен: rollback не отменяет сохраненные отчеты, выполните после commit";
+                return false;
+            }
+            string format_name = folded_cp1251(args[1]);
+            ReportFormat format = ReportFormat::TEXT;
+            if (format_name == "json") format = ReportFormat::JSON;
+            else if (format_name == "csv") format = ReportFormat::CSV;
+            else if (!format_name.empty() && format_name != "txt") {
+                error = "формат отчета: txt, json или csv";
+                return false;
+            }
+
+            User* employee = store_->get_employee(login_of(args[0]));
+            if (!employee) {
+                error = "сотрудник не найден";
+                return false;
+            }
+
+            ReportModel report = build_report_model(employee->username(), employee);
+            unique_ptr<ReportRenderer> other_renderer;
+            ReportRenderer* renderer = &text_report_;
+            if (format != ReportFormat::TEXT) {
+                other_renderer = make_report_renderer(format);
+                renderer = other_renderer.get();
+            }
+
+            string filename;
+            size_t version = 0;
+            if (!store_report(report, *renderer, filename, version)) {
+                error = "ошибка сохранения файла отчета";
+                return false;
+            }
+            result.key("username").value(report.username)
+                .key("file").value(filename)
+                .key("version").value(version);
+            return true;
+        } };
+
+    commands["rank"] = { 1, 1, "rank|логин",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            string username = login_of(args[0]);
+            if (!store_->get_employee(username)) {
+                error = "сотрудник не найден";
+                return false;
+            }
+            auto [position, total] = store_->get_employee_rank(username, system_config_.get());
+            result.key("username").value(username).key("rank");
+            if (position > 0) result.value(position);
+            else result.null();
+            result.key("total").value(total).key("score");
+            if (system_config_->hasPerformanceScore(username)) {
+                result.value(system_config_->getPerformanceScore(username), 2);
+            }
+            else {
+                result.null();
+            }
+            return true;
+        } };
+
+    commands["top"] = { 1, 2, "top|k[|отдел]",
+        [this](const CommandArgs& args, JsonWriter& result, string& error) {
+            size_t k = 0;
+            if (!parse_count(args[0], k) || k == 0) {
+                error = "k должно быть положительным числом";
+                return false;
+            }
+            auto leaders = args[1].empty()
+                ? store_->get_top_rated(k, system_config_.get())
+                : store_->get_top_rated_in_department(string(args[1]), k, system_config_.get());
+
+            result.key("count").value(leaders.size()).key("employees").begin_array();
+            for (const auto& [employee, rating] : leaders) {
+                result.begin_object()
+                    .key("username").value(employee->username())
+                    .key("fullname").value(employee->fullname())
+                    .key("department").value(employee->department())
+                    .key("score").value(rating, 2)
+                    .end_object();
+            }
+            result.end_array();
+            return true;
+        } };
+
+    commands["search"] = { 1, 2, "search|текст[|лимит]",
+        [this, DEFAULT_SEARCH_LIMIT](const CommandArgs& args, JsonWriter& result, string& error) {
+            size_t limit = DEFAULT_SEARCH_LIMIT;
+            if (!args[1].empty() && !parse_count(args[1], limit)) {
+                error = "лимит должен быть числом";
+                return false;
+            }
+            auto found = store_->search_employees_by_name(string(args[0]));
+
+            result.key("count").value(found.size()).key("employees").begin_array();
+            for (size_t i = 0; i < found.size() && i < limit; ++i) write_employee(result, found[i]);
+            result.end_array();
+            return true;
+        } };
+
+    commands["search-projects"] = { 1, 2, "search-projects|текст[|лимит]",
+        [this, DEFAULT_SEARCH_LIMIT](const CommandArgs& args, JsonWriter& result, string& error) {
+            size_t limit = DEFAULT_SEARCH_LIMIT;
+            if (!args[1].empty() && !parse_count(args[1], limit)) {
+                error = "лимит должен быть числом";
+                return false;
+            }
+            auto found = project_store_->search_projects_by_name(string(args[0]));
+
+            result.key("count").value(found.size()).key("projects").begin_array();
+            for (size_t i = 0; i < found.size() && i < limit; ++i) {
+                result.begin_object()
+                    .key("name").value(found[i]->name())
+                    .key("status").value(found[i]->status())
+                    .key("created").value(found[i]->created_date())
+                    .end_object();
+            }
+            result.end_array();
+            return true;
+        } };
+
+    // Пакет: файлы хранилищ пишутся один раз при commit (для загрузки больших сценариев)
+    commands["begin"] = { 0, 0, "begin",
+        [this](const CommandArgs&, JsonWriter& result, string&) {
+            store_->begin_batch();
+            project_store_->begin_batch();
+            result.key("batch").value("open");
+            return true;
+        } };
+
+    commands["commit"] = { 0, 0, "commit",
+        [this](const CommandArgs&, JsonWriter& result, string& error) {
+            if (!store_->in_batch() && !project_store_->in_batch()) {
+                error = "пакет не начат";
+                return false;
+            }
+            store_->commit_batch();
+            project_store_->commit_batch();
+            result.key("batch").value("committed");
+            return true;
+        } };
+
+    commands["rollback"] = { 0, 0, "rollback",
+        [this](const CommandArgs&, JsonWriter& result, string& error) {
+            if (!store_->in_batch() && !project_store_->in_batch()) {
+                error = "пакет не начат";
+                return false;
+            }
+            store_->rollback_batch();
+            project_store_->rollback_batch();
+            result.key("batch").value("rolled back");
+            return true;
+        } };
+
+    commands["help"] = { 0, 0, "help",
+        [&commands](const CommandArgs&, JsonWriter& result, string&) {
+            vector<string_view> usages;
+            for (const auto& [name, command] : commands) usages.push_back(command.usage);
+            sort(usages.begin(), usages.end());
+
+            result.key("commands").begin_array();
+            for (string_view usage : usages) result.value(usage);
+            result.end_array();
+            return true;
+        } };
+
+    size_t line_number = 0;
+    size_t executed = 0;
+    size_t failed = 0;
+    double total_ms = 0;
+    double max_ms = 0;
+
+    string line;
+    string response;
+    while (getline(in, line)) {
+        ++line_number;
+        string_view text = trim(string_view(line));
+        if (text.empty() || text.front() == '#') continue;
+
+        string_view fields[CommandArgs::MAX + 1];
+        size_t count = split_fields(text, '|', fields, CommandArgs::MAX + 1);
+        string name = folded_cp1251(trim(fields[0]));
+        if (name == "exit" || name == "quit") break;
+
+        CommandArgs args;
+        args.count = count - 1;
+        for (size_t i = 0; i < args.count; ++i) args.values[i] = trim(fields[i + 1]);
+
+        response.clear();
+        JsonWriter json(response);
+        json.begin_object().key("line").value(line_number).key("command").value(name);
+
+        string error;
+        string result_text;
+        JsonWriter result(result_text);
+        bool ok = false;
+        double ms = 0;
+
+        auto command = commands.find(name);
+        if (command == commands.end()) {
+            error = "неизвестная команда (список: help)";
+        }
+        else if (args.count < command->second.min_args || args.count > command->second.max_args) {
+            error = string("формат: ") + command->second.usage;
+        }
+        else {
+            result.begin_object();
+            auto start = chrono::steady_clock::now();
+            ok = command->second.run(args, result, error);
+            ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            result.end_object();
+        }
+
+        ++executed;
+        if (!ok) ++failed;
+        total_ms += ms;
+        max_ms = max(max_ms, ms);
+
+        json.key("status").value(ok ? "ok" : "error").key("ms").value(ms, 4);
+        if (ok) {
+            json.key("result");
+            response += result_text;
+        }
+        else {
+            json.key("error").value(error);
+        }
+        json.end_object();
+        response += '\n';
+        out << response;
+    }
+
+    // Незавершенные пакеты (begin вкладываются) записываются все, до внешнего уровня,
+    // чтобы выполненные команды не пропали; их число попадает в итог
+    size_t unclosed_batches = 0;
+    while (store_->in_batch() || project_store_->in_batch()) {
+        if (store_->in_batch()) store_->commit_batch();
+        if (project_store_->in_batch()) project_store_->commit_batch();
+        ++unclosed_batches;
+    }
+
+    response.clear();
+    JsonWriter summary(response);
+    summary.begin_object().key("summary").begin_object()
+        .key("commands").value(executed)
+        .key("ok").value(executed - failed)
+        .key("errors").value(failed)
+        .key("total_ms").value(total_ms, 3)
+        .key("max_ms").value(max_ms, 4)
+        .key("unclosed_batches").value(unclosed_batches)
+        .end_object().end_object();
+    response += '\n';
+    out << response << flush;
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#include "Journal.h"
+#include "Stats.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- Журнал изменений (append-only) ---------------------------
+
+bool AppendJournal::append(const string& record) {
+    STAT_SCOPE(stat, "AppendJournal::append");
+    ofstream out(path_, ios::app);
+    if (!out.is_open()) {
+        cerr << "Ошибка: не удалось открыть журнал для записи: " << path_ << "\n";
+        return false;
+    }
+
+    // Ошибка записи видна только после сброса буфера: деструктор ofstream ее проглотит
+    out << record << "\n";
+    out.flush();
+    if (!out) {
+        cerr << "Ошибка записи в журнал: " << path_ << "\n";
+        return false;
+    }
+
+    ++record_count_;
+    stat.add_bytes(static_cast<long long>(record.size() + 1));
+    return true;
+}
+
+bool AppendJournal::append_all(const vector<string>& records) {
+    STAT_SCOPE(stat, "AppendJournal::append_all");
+    if (records.empty()) return true;
+
+    ofstream out(path_, ios::app);
+    if (!out.is_open()) {
+        cerr << "Ошибка: не удалось открыть журнал для записи: " << path_ << "\n";
+        return false;
+    }
+
+    long long bytes = 0;
+    for (const auto& record : records) {
+        if (!(out << record << "\n")) break;
+        bytes += static_cast<long long>(record.size() + 1);
+    }
+    out.flush();
+    if (!out) {
+        cerr << "Ошибка записи в журнал: " << path_ << "\n";
+        return false;
+    }
+
+    record_count_ += records.size();
+    stat.add_bytes(bytes);
+    return true;
+}
+
+void AppendJournal::truncate() {
+    ofstream out(path_, ios::trunc);
+    if (!out.is_open()) {
+        cerr << "Ошибка: не удалось очистить журнал: " << path_ << "\n";
+    }
+    record_count_ = 0;
+}
+
+bool AppendJournal::rewrite(const vector<string>& records) {
+    STAT_SCOPE(stat, "AppendJournal::rewrite");
+    const string temp_path = path_ + ".tmp";
+    ofstream out(temp_path, ios::trunc);
+    if (!out.is_open()) {
+        cerr << "Ошибка: не удалось открыть журнал для записи: " << temp_path << "\n";
+        return false;
+    }
+
+    for (const auto& record : records) {
+        if (!(out << record << "\n")) break;
+    }
+    stat.add_bytes(out.tellp());
+    out.close();
+
+    error_code ec;
+    if (!out) {
+        cerr << "Ошибка записи в журнал: " << temp_path << "\n";
+        filesystem::remove(temp_path, ec);
+        return false;
+    }
+
+    filesystem::rename(temp_path, path_, ec);
+    if (ec) {
+        cerr << "Ошибка: не удалось заменить журнал: " << path_ << "\n";
+        filesystem::remove(temp_path, ec);
+        return false;
+    }
+    record_count_ = records.size();
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Utilities.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// --------------------------- Журнал изменений (append-only) ---------------------------
+// Файл-спутник, в который каждая операция дописывает одну строку. Базовый файл
+// данных переписывается целиком только при уплотнении, после чего журнал очищается.
+class AppendJournal {
+public:
+    explicit AppendJournal(string path) : path_(move(path)) {}
+
+    const string& path() const { return path_; }
+
+    // Число записей в журнале (после последнего replay/truncate)
+    size_t record_count() const { return record_count_; }
+
+    // Дописать одну запись в конец журнала
+    bool append(const string& record);
+
+    // Дописать несколько записей за одно открытие файла
+    bool append_all(const vector<string>& records);
+
+    // Прочитать все записи по порядку; fn(string_view record).
+    // Файл отображается в память, записи не копируются
+    template <typename Fn>
+    void replay(Fn fn) {
+        record_count_ = 0;
+        MappedFile file;
+        if (!file.open(path_)) return;
+
+        file.for_each_line([&](string_view line) {
+            line = trim(line);
+            if (line.empty()) return;
+            fn(line);
+            ++record_count_;
+        });
+    }
+
+    // Очистить журнал (после того как его содержимое попало в базовый файл)
+    void truncate();
+
+    // Заменить содержимое журнала записями records. Они пишутся во временный файл,
+    // который затем переименовывается поверх журнала: при сбое на диске остается
+    // либо прежний журнал, либо новый целиком
+    bool rewrite(const vector<string>& records);
+
+private:
+    string path_;
+    size_t record_count_ = 0;
+};
+
+namespace HRSystem {
+    using ::AppendJournal;
+}
@@ -0,0 +1,122 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// --------------------------- Отображение файла в память ---------------------------
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = exchange(other.data_, nullptr);
+        size_ = exchange(other.size_, 0);
+        is_open_ = exchange(other.is_open_, false);
+#ifdef _WIN32
+        file_handle_ = exchange(other.file_handle_, nullptr);
+        mapping_handle_ = exchange(other.mapping_handle_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const string& path) {
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    file_handle_ = file;
+    is_open_ = true;
+
+    // Пустой файл отобразить нельзя — считаем его открытым и пустым
+    if (file_size.QuadPart == 0) return true;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        return false;
+    }
+    mapping_handle_ = mapping;
+
+    data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data_) {
+        close();
+        return false;
+    }
+    size_ = static_cast<size_t>(file_size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_handle_) CloseHandle(mapping_handle_);
+    if (file_handle_) CloseHandle(file_handle_);
+    data_ = nullptr;
+    mapping_handle_ = nullptr;
+    file_handle_ = nullptr;
+    size_ = 0;
+    is_open_ = false;
+}
+
+#else
+
+bool MappedFile::open(const string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    is_open_ = true;
+    if (st.st_size > 0) {
+        void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            is_open_ = false;
+            return false;
+        }
+        madvise(data, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(data);
+        size_ = static_cast<size_t>(st.st_size);
+    }
+
+    // Отображение остается действительным и после закрытия дескриптора
+    ::close(fd);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    is_open_ = false;
+}
+
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include "Utilities.h"
+
+using namespace std;
+
+// --------------------------- Отображение файла в память ---------------------------
+// Файл только для чтения, отображенный в адресное пространство процесса.
+// Загрузчики просматривают его строки как string_view и разбирают их split_fields().
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const string& path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // false, если файл не существует или не может быть отображен
+    bool open(const string& path);
+    void close();
+
+    bool is_open() const { return is_open_; }
+    size_t size() const { return size_; }
+    string_view view() const { return string_view(data_, size_); }
+
+    // Вызывает fn(string_view line) для каждой строки файла (без '\r' и '\n')
+    template <typename Fn>
+    void for_each_line(Fn fn) const {
+        string_view rest = view();
+        while (!rest.empty()) {
+            size_t end = rest.find('\n');
+            string_view line = rest.substr(0, end);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            fn(line);
+            if (end == string_view::npos) break;
+            rest.remove_prefix(end + 1);
+        }
+    }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool is_open_ = false;
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#endif
+};
+
+namespace HRSystem {
+    using ::MappedFile;
+}
@@ -1,77 +1,314 @@
 #include "UserClasses.h"
 #include "Projects.h"
+#include "Stats.h"
 
+#include <filesystem>
 #include<iostream>
 
 using namespace std;
 
-// --------------------------- ProjectStore  ---------------------------
+// --------------------------- Словари статусов и ролей ---------------------------
+
+// Синонимы записаны в нижнем регистре; вход приводится к нему fold_case_cp1251
+static const StringMap<ProjectStatus>& status_dictionary() {
+    static const StringMap<ProjectStatus> dictionary = {
+        { "активный", ProjectStatus::ACTIVE },
+        { "active", ProjectStatus::ACTIVE },
+        { "завершенный", ProjectStatus::COMPLETED },
+        { "завершённый", ProjectStatus::COMPLETED },
+        { "completed", ProjectStatus::COMPLETED },
+        { "приостановленный", ProjectStatus::SUSPENDED },
+        { "suspended", ProjectStatus::SUSPENDED },
+        { "планируется", ProjectStatus::PLANNED },
+        { "planned", ProjectStatus::PLANNED },
+    };
+    return dictionary;
+}
+
+static const StringMap<ProjectRole>& role_dictionary() {
+    static const StringMap<ProjectRole> dictionary = {
+        { "участник", ProjectRole::MEMBER },
+        { "member", ProjectRole::MEMBER },
+        { "руководитель", ProjectRole::LEAD },
+        { "team lead", ProjectRole::LEAD },
+        { "teamlead", ProjectRole::LEAD },
+        { "тимлид", ProjectRole::LEAD },
+        { "менеджер", ProjectRole::MANAGER },
+        { "manager", ProjectRole::MANAGER },
+        { "ведущий разработчик", ProjectRole::LEAD_DEVELOPER },
+        { "главный разработчик", ProjectRole::LEAD_DEVELOPER },
+        { "lead developer", ProjectRole::LEAD_DEVELOPER },
+        { "разработчик", ProjectRole::DEVELOPER },
+        { "developer", ProjectRole::DEVELOPER },
+        { "тестировщик", ProjectRole::TESTER },
+        { "tester", ProjectRole::TESTER },
+        { "аналитик", ProjectRole::ANALYST },
+        { "analyst", ProjectRole::ANALYST },
+        { "дизайнер", ProjectRole::DESIGNER },
+        { "designer", ProjectRole::DESIGNER },
+    };
+    return dictionary;
+}
+
+// Код значения по словарю; строка нормализуется на стеке, без выделения памяти
+template <typename Code>
+static Code lookup_code(const StringMap<Code>& dictionary, string_view value, Code fallback) {
+    value = trim(value);
+    char buf[64];
+    if (value.size() > sizeof(buf)) return fallback;
+    fold_case_cp1251(value.data(), value.size(), buf);
+
+    auto it = dictionary.find(string_view(buf, value.size()));
+    return it != dictionary.end() ? it->second : fallback;
+}
+
+ProjectStatus parse_project_status(string_view status) {
+    return lookup_code(status_dictionary(), status, ProjectStatus::OTHER);
+}
+
+ProjectRole parse_project_role(string_view role) {
+    return lookup_code(role_dictionary(), role, ProjectRole::OTHER);
+}
+
+// --------------------------- ProjectStore методы ---------------------------
 
 void ProjectStore::load_from_file() {
+    STAT_SCOPE(stat, "ProjectStore::load_from_file");
     load_projects_from_file();
     load_employee_projects_from_file();
 }
 
 void ProjectStore::load_projects_from_file() {
+    STAT_SCOPE(stat, "ProjectStore::load_projects_from_file");
     projects_.clear();
-    ifstream in(PROJECTS_FILE);
-    if (!in.is_open()) {
-        cerr << ":     : " << PROJECTS_FILE
-            << ".   .\n";
+    project_by_name_.clear();
+    MappedFile file;
+    if (!file.open(PROJECTS_FILE)) {
+        cerr << "Предупреждение: не удалось открыть файл проектов: " << PROJECTS_FILE
+            << ". Создан новый файл.\n";
         ofstream out(PROJECTS_FILE, ios::app);
         if (!out.is_open()) {
-            cerr << ":     : " << PROJECTS_FILE << "\n";
+            cerr << "Ошибка: не удалось создать файл проектов: " << PROJECTS_FILE << "\n";
         }
         return;
     }
 
-    string line;
-    while (getline(in, line)) {
-        if (in.bad() || in.fail()) {
-            cerr << "   .   .\n";
-            in.clear();
-            continue;
-        }
-        line = trim(line);
-        if (line.empty()) continue;
-        auto project = Project::create_from_record(line);
+    file.for_each_line([this](string_view line) {
+        string_view fields[4];
+        size_t count = split_fields(line, '|', fields, 4);
+        auto project = Project::create_from_fields(fields, count);
         if (project) {
             projects_.push_back(move(project));
         }
-    }
+    });
 
-    in.close();
+    rebuild_project_index();
 }
 
 void ProjectStore::load_employee_projects_from_file() {
+    STAT_SCOPE(stat, "ProjectStore::load_employee_projects_from_file");
     employee_projects_.clear();
-    ifstream in(EMPLOYEE_PROJECTS_FILE);
-    if (!in.is_open()) {
-        cerr << ":     : " << EMPLOYEE_PROJECTS_FILE
-            << ".   .\n";
+    MappedFile file;
+    if (!file.open(recover_employee_projects_compaction())) {
+        cerr << "Предупреждение: не удалось открыть файл проектов: " << EMPLOYEE_PROJECTS_FILE
+            << ". Создан новый файл.\n";
         ofstream out(EMPLOYEE_PROJECTS_FILE, ios::app);
         if (!out.is_open()) {
-            cerr << ":     : " << EMPLOYEE_PROJECTS_FILE << "\n";
+            cerr << "Ошибка: не удалось создать файл проектов: " << EMPLOYEE_PROJECTS_FILE << "\n";
         }
-        return;
     }
+    else {
+        file.for_each_line([this](string_view line) {
+            string_view fields[4];
+            size_t count = split_fields(line, '|', fields, 4);
+            auto emp_proj = EmployeeProject::create_from_fields(fields, count);
+            if (emp_proj) {
+                employee_projects_.push_back(move(emp_proj));
+            }
+        });
+        file.close();
+    }
+    employee_projects_base_records_ = employee_projects_.size();
+    rebuild_assignment_indexes();
 
-    string line;
-    while (getline(in, line)) {
-        if (in.bad() || in.fail()) {
-            cerr << "   .   .\n";
-            in.clear();
-            continue;
-        }
-        line = trim(line);
-        if (line.empty()) continue;
-        auto emp_proj = EmployeeProject::create_from_record(line);
+    // Применяем изменения, накопленные в журнале после последнего уплотнения
+    employee_projects_journal_.replay([this](string_view record) {
+        apply_employee_project_record(record);
+    });
+
+    if (employee_projects_journal_too_long()) {
+        save_employee_projects_to_file();
+    }
+}
+
+void ProjectStore::apply_employee_project_record(string_view record) {
+    string_view parts[5];
+    size_t count = split_fields(record, '|', parts, 5);
+    if (count < 3) return;
+
+    string_view op = parts[0];
+    string_view username = parts[1];
+    string_view project_name = parts[2];
+
+    if (op == "+") {
+        auto emp_proj = EmployeeProject::create_from_fields(parts + 1, count - 1);
         if (emp_proj) {
+            index_assignment(emp_proj.get());
             employee_projects_.push_back(move(emp_proj));
         }
-    }  
+        return;
+    }
+
+    EmployeeProject* emp_proj = find_assignment(username, project_name);
+    if (!emp_proj) return;
+
+    if (op == "-") {
+        erase_assignment(emp_proj);
+    }
+    else if (op == "~" && count >= 4) {
+        emp_proj->set_role(string(parts[3]));
+    }
+}
+
+// --------------------------- Индексы проектов и назначений ---------------------------
+
+void ProjectStore::rebuild_project_index() {
+    project_by_name_.clear();
+    project_by_name_.reserve(projects_.size());
+    project_name_search_.clear();
+    project_name_search_.reserve(projects_.size());
+    for (const auto& project : projects_) {
+        // При повторяющихся названиях, как и прежний поиск, находим первый проект
+        project_by_name_.emplace(project->name(), project.get());
+        project_name_search_.insert(project.get(), project->name());
+    }
+}
+
+void ProjectStore::rebuild_assignment_indexes() {
+    assignments_by_user_.clear();
+    assignments_by_project_.clear();
+    assignment_by_key_.clear();
+    assignment_by_key_.reserve(employee_projects_.size());
+    for (const auto& emp_proj : employee_projects_) {
+        index_assignment(emp_proj.get());
+    }
+}
+
+void ProjectStore::index_assignment(EmployeeProject* emp_proj) {
+    assignments_by_user_[emp_proj->username()].push_back(emp_proj);
+    assignments_by_project_[emp_proj->project_name()].push_back(emp_proj);
+    assignment_by_key_.emplace(AssignmentKey{ emp_proj->username(), emp_proj->project_name() }, emp_proj);
+}
+
+// Удаляет связь из списка по ключу; пустые списки удаляются из таблицы
+static void remove_from_bucket(StringMap<vector<EmployeeProject*>>& index,
+    const string& key, const EmployeeProject* emp_proj) {
+    auto it = index.find(key);
+    if (it == index.end()) return;
+
+    auto& bucket = it->second;
+    auto pos = find(bucket.begin(), bucket.end(), emp_proj);
+    if (pos != bucket.end()) bucket.erase(pos);
+    if (bucket.empty()) index.erase(it);
+}
+
+void ProjectStore::unindex_assignment(const EmployeeProject* emp_proj) {
+    remove_from_bucket(assignments_by_user_, emp_proj->username(), emp_proj);
+    remove_from_bucket(assignments_by_project_, emp_proj->project_name(), emp_proj);
+
+    auto key_it = assignment_by_key_.find(AssignmentKey{ emp_proj->username(), emp_proj->project_name() });
+    if (key_it == assignment_by_key_.end() || key_it->second != emp_proj) return;
+    assignment_by_key_.erase(key_it);
+
+    // Если сотрудник был назначен на проект повторно, ключ переходит к следующему назначению
+    auto user_it = assignments_by_user_.find(emp_proj->username());
+    if (user_it == assignments_by_user_.end()) return;
+    for (EmployeeProject* other : user_it->second) {
+        if (other->project_name() == emp_proj->project_name()) {
+            assignment_by_key_.emplace(AssignmentKey{ other->username(), other->project_name() }, other);
+            break;
+        }
+    }
+}
+
+EmployeeProject* ProjectStore::find_assignment(string_view username, string_view project_name) const {
+    auto it = assignment_by_key_.find(AssignmentKey{ username, project_name });
+    return it != assignment_by_key_.end() ? it->second : nullptr;
+}
 
-    in.close();
+void ProjectStore::erase_assignment(const EmployeeProject* emp_proj) {
+    unindex_assignment(emp_proj);
+    auto it = find_if(employee_projects_.begin(), employee_projects_.end(),
+        [emp_proj](const unique_ptr<EmployeeProject>& p) { return p.get() == emp_proj; });
+    if (it == employee_projects_.end()) return;
+    employee_projects_rollback_.retire(move(*it));
+    employee_projects_.erase(it);
+}
+
+bool ProjectStore::employee_projects_journal_too_long() const {
+    size_t records = employee_projects_journal_.record_count();
+    return records > JOURNAL_MIN_RECORDS &&
+        records > employee_projects_base_records_ * JOURNAL_COMPACTION_RATIO;
+}
+
+// Одна запись в журнал вместо перезаписи employee_projects.txt
+void ProjectStore::log_employee_project_change(const string& record) {
+    if (in_batch()) {
+        pending_journal_records_.push_back(record);
+        return;
+    }
+
+    if (!employee_projects_journal_.append(record) || employee_projects_journal_too_long()) {
+        save_employee_projects_to_file();
+    }
+}
+
+void ProjectStore::begin_batch() {
+    ++batch_depth_;
+    projects_rollback_.begin(projects_);
+    employee_projects_rollback_.begin(employee_projects_);
+    pending_journal_marks_.push_back(pending_journal_records_.size());
+}
+
+// Записывает каждый затронутый файл один раз: журнал — одним дописыванием
+void ProjectStore::commit_batch() {
+    if (batch_depth_ == 0) return;
+
+    projects_rollback_.commit();
+    employee_projects_rollback_.commit();
+    pending_journal_marks_.pop_back();
+    if (--batch_depth_ > 0) return;
+
+    if (projects_dirty_) save_projects_to_file();
+
+    if (employee_projects_dirty_) {
+        // Полная перезапись уже включает все изменения из журнала пакета
+        save_employee_projects_to_file();
+    }
+    else if (!employee_projects_journal_.append_all(pending_journal_records_) ||
+        employee_projects_journal_too_long()) {
+        save_employee_projects_to_file();
+    }
+
+    projects_dirty_ = employee_projects_dirty_ = false;
+    pending_journal_records_.clear();
+}
+
+// Файлы во время пакета не менялись: откат возвращает прежние объекты на место,
+// отбрасывает записи журнала этого уровня и перестраивает индексы
+void ProjectStore::rollback_batch() {
+    if (batch_depth_ == 0) return;
+
+    projects_rollback_.rollback(projects_);
+    employee_projects_rollback_.rollback(employee_projects_);
+    pending_journal_records_.resize(pending_journal_marks_.back());
+    pending_journal_marks_.pop_back();
+    if (--batch_depth_ == 0) {
+        projects_dirty_ = employee_projects_dirty_ = false;
+    }
+
+    rebuild_project_index();
+    rebuild_assignment_indexes();
 }
 
 void ProjectStore::save_all_files() {
@@ -80,85 +317,168 @@ void ProjectStore::save_all_files() {
 }
 
 void ProjectStore::save_projects_to_file() {
+    if (in_batch()) {
+        projects_dirty_ = true;
+        return;
+    }
+
+    STAT_SCOPE(stat, "ProjectStore::save_projects_to_file");
     ofstream out(PROJECTS_FILE, ios::trunc);
     if (!out.is_open()) {
-        cerr << " :       : "
+        cerr << "Критическая ошибка: не удалось открыть файл проектов для записи: "
             << PROJECTS_FILE << "\n";
         return;
     }
 
     for (const auto& project : projects_) {
         if (!(out << project->serialize() << "\n")) {
-            cerr << "    .\n";
+            cerr << "Ошибка записи проекта в файл.\n";
             break;
         }
     }
 
-   
-    out.close();  //   
+    stat.add_bytes(out.tellp());
+    out.close();  // Явное закрытие потока
 
     if (!out) {
-        cerr << "    .\n";
+        cerr << "Ошибка при закрытии файла проектов.\n";
     }
 }
 
 void ProjectStore::save_employee_projects_to_file() {
-    ofstream out(EMPLOYEE_PROJECTS_FILE, ios::trunc);
+    if (in_batch()) {
+        employee_projects_dirty_ = true;
+        return;
+    }
+
+    STAT_SCOPE(stat, "ProjectStore::save_employee_projects_to_file");
+    // Снимок пишется во временный файл; журнал переименовывается в .old только после
+    // того, как снимок записан целиком (см. recover_employee_projects_compaction)
+    const string temp_path = EMPLOYEE_PROJECTS_FILE + ".tmp";
+    const string rotated_path = EMPLOYEE_PROJECTS_JOURNAL_FILE + ".old";
+    error_code ec;
+    ofstream out(temp_path, ios::trunc);
     if (!out.is_open()) {
-        cerr << " :       : "
-            << EMPLOYEE_PROJECTS_FILE << "\n";
+        cerr << "Критическая ошибка: не удалось открыть файл проектов для записи: "
+            << temp_path << "\n";
         return;
     }
 
     for (const auto& emp_proj : employee_projects_) {
         if (!(out << emp_proj->serialize() << "\n")) {
-            cerr << "    .\n";
+            cerr << "Ошибка записи проекта в файл.\n";
             break;
         }
     }
-    
-    out.close();  //   
+    stat.add_bytes(out.tellp());
+    out.close();  // Явное закрытие потока
 
     if (!out) {
-        cerr << "    .\n";
+        cerr << "Ошибка при закрытии файла проектов.\n";
+        filesystem::remove(temp_path, ec);
+        return;
     }
+
+    // .old должен появиться, даже если журнала еще не было
+    { ofstream touch(EMPLOYEE_PROJECTS_JOURNAL_FILE, ios::app); }
+    filesystem::rename(EMPLOYEE_PROJECTS_JOURNAL_FILE, rotated_path, ec);
+    if (ec) {
+        cerr << "Ошибка: не удалось переименовать журнал назначений: " << EMPLOYEE_PROJECTS_JOURNAL_FILE << "\n";
+        filesystem::remove(temp_path, ec);
+        return;
+    }
+    // Снимок содержит полное состояние — новые записи идут в пустой журнал
+    employee_projects_base_records_ = employee_projects_.size();
+    employee_projects_journal_.truncate();
+
+    filesystem::rename(temp_path, EMPLOYEE_PROJECTS_FILE, ec);
+    if (ec) {
+        // Замену завершит следующая загрузка
+        cerr << "Ошибка: не удалось заменить файл проектов: " << EMPLOYEE_PROJECTS_FILE << "\n";
+        return;
+    }
+    filesystem::remove(rotated_path, ec);
+}
+
+// Уплотнение, прерванное сбоем. Записи журнала не идемпотентны (повторное "+" дало бы
+// второе назначение), поэтому .old нельзя применять поверх базового файла. Но .old
+// появляется только после полной записи снимка: если он есть, снимок (уже учитывающий
+// .old) заменяет базовый файл, а .old удаляется. Временный файл без .old - недописанный
+// снимок. Возвращает файл, который нужно прочитать как базовый.
+string ProjectStore::recover_employee_projects_compaction() {
+    const string temp_path = EMPLOYEE_PROJECTS_FILE + ".tmp";
+    const string rotated_path = EMPLOYEE_PROJECTS_JOURNAL_FILE + ".old";
+    error_code ec;
+    if (!filesystem::exists(rotated_path, ec)) {
+        filesystem::remove(temp_path, ec);
+        return EMPLOYEE_PROJECTS_FILE;
+    }
+
+    if (filesystem::exists(temp_path, ec)) {
+        filesystem::rename(temp_path, EMPLOYEE_PROJECTS_FILE, ec);
+        if (ec) {
+            cerr << "Ошибка: не удалось заменить файл проектов: " << EMPLOYEE_PROJECTS_FILE << "\n";
+            return temp_path;
+        }
+    }
+    filesystem::remove(rotated_path, ec);
+    return EMPLOYEE_PROJECTS_FILE;
 }
 
 bool ProjectStore::add_project(unique_ptr<Project> project) {
     if (!project || project->name().empty()) return false;
 
-    // ,       
+    // Проверяем, существует ли уже проект с таким именем
     if (find_project(project->name()) != nullptr) return false;
 
+    project_by_name_.emplace(project->name(), project.get());
+    project_name_search_.insert(project.get(), project->name());
     projects_.push_back(move(project));
     save_projects_to_file();
     return true;
 }
 
 bool ProjectStore::remove_project(const string& project_name) {
-    //  
-    for (size_t i = 0; i < projects_.size(); ++i) {
-        if (projects_[i]->name() == project_name) {
-            projects_.erase(projects_.begin() + i);
-
-            //       
-            vector<size_t> to_remove;
-            for (size_t j = 0; j < employee_projects_.size(); ++j) {
-                if (employee_projects_[j]->project_name() == project_name) {
-                    to_remove.push_back(j);
-                }
-            }
+    auto found = project_by_name_.find(project_name);
+    if (found == project_by_name_.end()) return false;
+
+    const Project* project = found->second;
+    project_by_name_.erase(found);
+    project_name_search_.erase(project);
+    auto owner = find_if(projects_.begin(), projects_.end(),
+        [project](const unique_ptr<Project>& p) { return p.get() == project; });
+    projects_rollback_.retire(move(*owner));
+    projects_.erase(owner);
+
+    // Проект с тем же названием мог встречаться в файле повторно
+    for (const auto& p : projects_) {
+        if (p->name() == project_name) {
+            project_by_name_.emplace(p->name(), p.get());
+            break;
+        }
+    }
 
-            //    
-            for (auto it = to_remove.rbegin(); it != to_remove.rend(); ++it) {
-                employee_projects_.erase(employee_projects_.begin() + *it);
-            }
+    // Удаляем все связи сотрудников с этим проектом
+    auto assigned = assignments_by_project_.find(project_name);
+    if (assigned != assignments_by_project_.end()) {
+        vector<EmployeeProject*> to_remove = move(assigned->second);
+        assignments_by_project_.erase(assigned);
 
-            save_all_files();
-            return true;
+        for (const EmployeeProject* emp_proj : to_remove) {
+            log_employee_project_change("-|" + emp_proj->username() + "|" + project_name);
+            remove_from_bucket(assignments_by_user_, emp_proj->username(), emp_proj);
+            assignment_by_key_.erase(AssignmentKey{ emp_proj->username(), emp_proj->project_name() });
         }
+
+        for (auto& emp_proj : employee_projects_) {
+            if (emp_proj->project_name() == project_name) employee_projects_rollback_.retire(move(emp_proj));
+        }
+        employee_projects_.erase(remove(employee_projects_.begin(), employee_projects_.end(), nullptr),
+            employee_projects_.end());
     }
-    return false;
+
+    save_projects_to_file();
+    return true;
 }
 
 
@@ -170,6 +490,11 @@ bool ProjectStore::update_project(const string& project_name, const string& new_
     auto project = find_project(project_name);
     if (!project) return false;
 
+    projects_rollback_.on_rollback([project, status = project->status(), description = project->description()] {
+        project->set_status(status);
+        project->set_description(description);
+    });
+
     if (!new_status.empty()) {
         project->set_status(new_status);
     }
@@ -182,15 +507,14 @@ bool ProjectStore::update_project(const string& project_name, const string& new_
     return true;
 }
 Project* ProjectStore::find_project(const string& project_name) const {
-    for (const auto& project : projects_) {
-        if (project->name() == project_name) return project.get();
-    }
-    return nullptr;
+    STAT_SCOPE(stat, "ProjectStore::find_project");
+    auto it = project_by_name_.find(project_name);
+    return it != project_by_name_.end() ? it->second : nullptr;
 }
 
 bool ProjectStore::assign_employee_to_project(const string& username, const string& project_name) {
-    //   
-    return assign_employee_to_project(username, project_name, "");
+    // значение по умолчанию
+    return assign_employee_to_project(username, project_name, "Участник");
 }
 
 bool ProjectStore::assign_employee_to_project(const string& username, const string& project_name, const string& role) {
@@ -198,34 +522,35 @@ bool ProjectStore::assign_employee_to_project(const string& username, const stri
     if (!project) return false;
 
     auto ep = make_unique<EmployeeProject>(username, project_name, role);
+    string record = "+|" + ep->serialize();
+    index_assignment(ep.get());
     employee_projects_.push_back(move(ep));
 
-    save_employee_projects_to_file();
+    log_employee_project_change(record);
     return true;
 }
 
 
 bool ProjectStore::remove_employee_from_project(const string& username, const string& project_name) {
-    for (size_t i = 0; i < employee_projects_.size(); ++i) {
-        if (employee_projects_[i]->username() == username &&
-            employee_projects_[i]->project_name() == project_name) {
-            employee_projects_.erase(employee_projects_.begin() + i);
-            save_employee_projects_to_file();
-            return true;
-        }
-    }
-    return false;
+    EmployeeProject* emp_proj = find_assignment(username, project_name);
+    if (!emp_proj) return false;
+
+    // Аргументы могут ссылаться на поля самого назначения (emp_proj->project_name()),
+    // поэтому запись собирается до его удаления
+    string record = "-|" + username + "|" + project_name;
+    erase_assignment(emp_proj);
+    log_employee_project_change(record);
+    return true;
 }
 
 bool ProjectStore::update_employee_role(const string& username, const string& project_name, const string& new_role) {
-    for (auto& emp_proj : employee_projects_) {
-        if (emp_proj->username() == username && emp_proj->project_name() == project_name) {
-            emp_proj->set_role(new_role);
-            save_employee_projects_to_file();
-            return true;
-        }
-    }
-    return false;
+    EmployeeProject* emp_proj = find_assignment(username, project_name);
+    if (!emp_proj) return false;
+
+    employee_projects_rollback_.on_rollback([emp_proj, role = emp_proj->role()] { emp_proj->set_role(role); });
+    emp_proj->set_role(new_role);
+    log_employee_project_change("~|" + username + "|" + project_name + "|" + new_role);
+    return true;
 }
 
 
@@ -246,57 +571,103 @@ vector<const EmployeeProject*> ProjectStore::all_employee_projects() const {
 }
 
 vector<const Project*> ProjectStore::get_employee_projects(const string& username) const {
+    STAT_SCOPE(stat, "ProjectStore::get_employee_projects");
     vector<const Project*> result;
-    for (const auto& emp_proj : employee_projects_) {
-        if (emp_proj->username() == username) {
-            auto project = find_project(emp_proj->project_name());
-            if (project) {
-                result.push_back(project);
-            }
+    auto it = assignments_by_user_.find(username);
+    if (it == assignments_by_user_.end()) return result;
+
+    result.reserve(it->second.size());
+    for (const EmployeeProject* emp_proj : it->second) {
+        auto project = find_project(emp_proj->project_name());
+        if (project) {
+            result.push_back(project);
         }
     }
     return result;
 }
 
 vector<const EmployeeProject*> ProjectStore::get_project_employees(const string& project_name) const {
-    vector<const EmployeeProject*> result;
-    for (const auto& emp_proj : employee_projects_) {
-        if (emp_proj->project_name() == project_name) {
-            result.push_back(emp_proj.get());
+    STAT_SCOPE(stat, "ProjectStore::get_project_employees");
+    auto it = assignments_by_project_.find(project_name);
+    if (it == assignments_by_project_.end()) return {};
+    return vector<const EmployeeProject*>(it->second.begin(), it->second.end());
+}
+
+// Назначения сотрудника вместе с проектами, в порядке get_employee_projects
+vector<EmployeeProjectLink> ProjectStore::get_employee_project_links(const string& username) const {
+    STAT_SCOPE(stat, "ProjectStore::get_employee_project_links");
+    vector<EmployeeProjectLink> result;
+    auto it = assignments_by_user_.find(username);
+    if (it == assignments_by_user_.end()) return result;
+
+    result.reserve(it->second.size());
+    for (const EmployeeProject* emp_proj : it->second) {
+        auto project = find_project(emp_proj->project_name());
+        if (project) {
+            result.push_back({ project, emp_proj });
         }
     }
     return result;
 }
 
-//   
-vector<const Project*> ProjectStore::search_projects_by_name(const string& keyword) const {
-    vector<const Project*> result;
-    string keyword_lower = keyword;
-    transform(keyword_lower.begin(), keyword_lower.end(), keyword_lower.begin(), ::tolower);
-
-    for (const auto& project : projects_) {
-        string name_lower = project->name();
-        transform(name_lower.begin(), name_lower.end(), name_lower.begin(), ::tolower);
-
-        if (name_lower.find(keyword_lower) != string::npos) {
-            result.push_back(project.get());
+ProjectActivity ProjectStore::get_employee_activity(const string& username) const {
+    STAT_SCOPE(stat, "ProjectStore::get_employee_activity");
+    ProjectActivity activity;
+    for (const auto& link : get_employee_project_links(username)) {
+        activity.total_projects++;
+        ProjectStatus status = link.project->status_code();
+        if (status == ProjectStatus::ACTIVE) {
+            activity.active_projects++;
+        }
+        else if (status == ProjectStatus::COMPLETED) {
+            activity.completed_projects++;
+        }
+        if (link.assignment->is_leadership()) {
+            activity.leadership_count++;
         }
     }
-    return result;
+    return activity;
+}
+
+double ProjectActivity::tasks_score() const {
+    if (total_projects == 0) return 0;
+    double completionRate = (static_cast<double>(completed_projects) / total_projects) * 100;
+    double leadershipBonus = leadership_count * 10;
+    double activityBonus = (static_cast<double>(active_projects) / total_projects) * 20;
+    return min(100.0, completionRate + leadershipBonus + activityBonus);
+}
+
+const string* ProjectStore::role_of(string_view username, string_view project_name) const {
+    STAT_SCOPE(stat, "ProjectStore::role_of");
+    const EmployeeProject* emp_proj = find_assignment(username, project_name);
+    return emp_proj ? &emp_proj->role() : nullptr;
+}
+
+// Поиск и фильтрация
+vector<const Project*> ProjectStore::search_projects_by_name(const string& keyword) const {
+    STAT_SCOPE(stat, "ProjectStore::search_projects_by_name");
+    return project_name_search_.search(keyword);
 }
 
 vector<const Project*> ProjectStore::filter_projects_by_status(const string& status) const {
+    STAT_SCOPE(stat, "ProjectStore::filter_projects_by_status");
     vector<const Project*> result;
+    // Известный статус сравниваем по коду ("Активный" == "активный" == "Active"),
+    // пользовательский — по точному совпадению строки
+    ProjectStatus code = parse_project_status(status);
     for (const auto& project : projects_) {
-        if (project->status() == status) {
+        bool match = code != ProjectStatus::OTHER ? project->status_code() == code
+                                                  : project->status() == status;
+        if (match) {
             result.push_back(project.get());
         }
     }
     return result;
 }
 
-// 
+// Сортировка
 vector<const Project*> ProjectStore::get_projects_sorted_by_name(bool ascending) const {
+    STAT_SCOPE(stat, "ProjectStore::get_projects_sorted_by_name");
     vector<const Project*> result = all_projects();
 
     sort(result.begin(), result.end(), [ascending](const Project* a, const Project* b) {
@@ -312,6 +683,7 @@ vector<const Project*> ProjectStore::get_projects_sorted_by_name(bool ascending)
 }
 
 vector<const Project*> ProjectStore::get_projects_sorted_by_date(bool ascending) const {
+    STAT_SCOPE(stat, "ProjectStore::get_projects_sorted_by_date");
     vector<const Project*> result = all_projects();
 
     sort(result.begin(), result.end(), [ascending](const Project* a, const Project* b) {
@@ -327,22 +699,22 @@ vector<const Project*> ProjectStore::get_projects_sorted_by_date(bool ascending)
 }
 
 void Application::hr_add_project() {
-    cout << "\n---    ---\n";
+    cout << "\n--- Добавление нового проекта ---\n";
 
-    string name = input_line(" : ");
+    string name = input_line("Название проекта: ");
     if (name.empty()) {
-        cout << "     .\n";
+        cout << "Название проекта не может быть пустым.\n";
         return;
     }
 
-    string description = input_line(" : ");
+    string description = input_line("Описание проекта: ");
     if (description.empty()) {
-        cout << "     .\n";
+        cout << "Описание проекта не может быть пустым.\n";
         return;
     }
 
-    string status = "";
-    cout << "  (  ''): ";
+    string status = "активный";
+    cout << "Статус проекта (по умолчанию 'Активный'): ";
     string status_input = input_line("");
     if (!status_input.empty()) {
         status = status_input;
@@ -350,10 +722,10 @@ void Application::hr_add_project() {
 
     auto project = make_unique<Project>(name, description, status);
     if (project_store_->add_project(move(project))) {
-        cout << " '" << name << "'  .\n";
+        cout << "Проект '" << name << "' успешно добавлен.\n";
     }
     else {
-        cout << ":      .\n";
+        cout << "Ошибка: проект с таким названием уже существует.\n";
     }
 }
 
@@ -363,15 +735,15 @@ void Application::hr_view_all_projects() {
     auto projects = project_store_->all_projects();
 
     if (projects.empty()) {
-        cout << "\n .\n";
+        cout << "\nНет проектов.\n";
         return;
     }
 
-    cout << "\n---   (" << projects.size() << ") ---\n";
+    cout << "\n--- Все проекты (" << projects.size() << ") ---\n";
 
-    //   
-    vector<size_t> widths = { 4, 30, 20, 15, 20 }; // , , , ,  
-    vector<string> headers = { "", " ", "", "", " " };
+    // Определяем ширины колонок
+    vector<size_t> widths = { 4, 30, 20, 15, 20 }; // Номер, Название, Описание, Статус, Дата создания
+    vector<string> headers = { "№", "Название проекта", "Описание", "Статус", "Дата создания" };
 
     print_table_header(headers, widths);
 
@@ -398,22 +770,22 @@ void Application::hr_view_all_projects() {
 
 
 void Application::hr_assign_employee_to_project() {
-    cout << "\n---     ---\n";
+    cout << "\n--- Назначение сотрудника на проект ---\n";
 
     auto employees = store_->get_all_employees();
     if (employees.empty()) {
-        cout << "   .\n";
+        cout << "Нет сотрудников для назначения.\n";
         return;
     }
 
-    cout << " :\n";
+    cout << "Список сотрудников:\n";
     for (size_t i = 0; i < employees.size(); ++i) {
         cout << (i + 1) << ") " << employees[i]->fullname() << "\n";
     }
 
-    int emp_choice = input_int(" : ");
+    int emp_choice = input_int("Выберите сотрудника: ");
     if (emp_choice < 1 || emp_choice > static_cast<int>(employees.size())) {
-        cout << " .\n";
+        cout << "Неверный выбор.\n";
         return;
     }
 
@@ -421,73 +793,73 @@ void Application::hr_assign_employee_to_project() {
 
     auto projects = project_store_->all_projects();
     if (projects.empty()) {
-        cout << " .\n";
+        cout << "Нет проектов.\n";
         return;
     }
 
-    cout << " :\n";
+    cout << "Список проектов:\n";
     for (size_t i = 0; i < projects.size(); ++i) {
         cout << (i + 1) << ") " << projects[i]->name() << "\n";
     }
 
-    int proj_choice = input_int(" : ");
+    int proj_choice = input_int("Выберите проект: ");
     if (proj_choice < 1 || proj_choice > static_cast<int>(projects.size())) {
-        cout << " .\n";
+        cout << "Неверный выбор.\n";
         return;
     }
 
     const string project_name = projects[proj_choice - 1]->name();
 
-    string role = input_line("   : ");
+    string role = input_line("Роль сотрудника в проекте: ");
     if (role.empty()) {
-        role = "";
+        role = "Участник";
     }
 
     if (project_store_->assign_employee_to_project(username, project_name, role)) {
-        cout << " " << username << "     '"
-            << project_name << "'   '" << role << "'.\n";
+        cout << "Сотрудник " << username << " успешно назначен на проект '"
+            << project_name << "' с ролью '" << role << "'.\n";
     }
     else {
-        cout << ":          .\n";
+        cout << "Ошибка: сотрудник уже назначен на этот проект или проект не существует.\n";
     }
 }
 
 void Application::hr_view_project_details() {
-    cout << "\n---   ---\n";
+    cout << "\n--- Детали проекта ---\n";
 
     auto projects = project_store_->all_projects();
     if (projects.empty()) {
-        cout << " .\n";
+        cout << "Нет проектов.\n";
         return;
     }
 
-    cout << " :\n";
+    cout << "Список проектов:\n";
     for (size_t i = 0; i < projects.size(); ++i) {
         cout << (i + 1) << ") " << projects[i]->name() << "\n";
     }
 
-    int choice = input_int("   : ");
+    int choice = input_int("Выберите проект для просмотра: ");
     if (choice < 1 || choice > static_cast<int>(projects.size())) {
-        cout << " .\n";
+        cout << "Неверный выбор.\n";
         return;
     }
 
     const auto& project = projects[choice - 1];
 
-    cout << "\n---    ---\n";
-    cout << ": " << project->name() << "\n";
-    cout << ": " << project->description() << "\n";
-    cout << ": " << project->status() << "\n";
-    cout << " : " << project->created_date() << "\n";
+    cout << "\n--- Информация о проекте ---\n";
+    cout << "Название: " << project->name() << "\n";
+    cout << "Описание: " << project->description() << "\n";
+    cout << "Статус: " << project->status() << "\n";
+    cout << "Дата создания: " << project->created_date() << "\n";
 
-    //    
+    // Показать сотрудников на проекте
     auto project_employees = project_store_->get_project_employees(project->name());
     if (!project_employees.empty()) {
-        cout << "\n   (" << project_employees.size() << "):\n";
+        cout << "\nСотрудники на проекте (" << project_employees.size() << "):\n";
 
-        //      
-        vector<size_t> widths = { 20, 15, 20, 12 }; // , , ,  
-        vector<string> headers = { "", "", "", " " };
+        // Определяем ширины колонок для таблицы сотрудников
+        vector<size_t> widths = { 20, 15, 20, 12 }; // ФИО, Логин, Роль, Дата назначения
+        vector<string> headers = { "ФИО", "Логин", "Роль", "Дата назначения" };
 
         print_table_header(headers, widths);
 
@@ -512,92 +884,86 @@ void Application::hr_view_project_details() {
         print_horizontal_line(total_width);
     }
     else {
-        cout << "\n   .\n";
+        cout << "\nНа проекте нет сотрудников.\n";
     }
 }
 
 void Application::hr_edit_project() {
-    cout << "\n---   ---\n";
+    cout << "\n--- Редактирование проекта ---\n";
 
     auto projects = project_store_->all_projects();
     if (projects.empty()) {
-        cout << " .\n";
+        cout << "Нет проектов.\n";
         return;
     }
     do {
-        cout << " :\n";
+        cout << "Список проектов:\n";
         for (size_t i = 0; i < projects.size(); ++i) {
             cout << (i + 1) << ") " << projects[i]->name() << "\n";
         }
 
-        int choice = input_int("    (0-): ");
+        int choice = input_int("Выберите проект для редактирования (0-выйти): ");
         if (choice < 1 || choice > static_cast<int>(projects.size())) {
-            cout << " .\n";
+            cout << "Неверный выбор.\n";
             return;
         }
 
         const string project_name = projects[choice - 1]->name();
         Project* project = project_store_->find_project(project_name);
 
-        cout << "\n   ?\n";
-        cout << "1)  \n";
-        cout << "2)  \n";
-        cout << "3)    \n";
+        cout << "\nЧто вы хотите изменить?\n";
+        cout << "1) Статус проекта\n";
+        cout << "2) Описание проекта\n";
+        cout << "3) Роль сотрудника на проекте\n";
 
-        int edit_choice = input_int(" : ");
+        int edit_choice = input_int("Ваш выбор: ");
 
         switch (edit_choice) {
         case 1: {
-            cout << " : " << project->status() << "\n";
-            string new_status = input_line("  (, , , ): ");
+            cout << "Текущий статус: " << project->status() << "\n";
+            string new_status = input_line("Новый статус («активный», «завершенный», «приостановленный», «планируется»): ");
 
-            //    
-            vector<string> valid_statuses = { "", "", "", "" };
+            // Создаем список допустимых статусов
+            vector<string> valid_statuses = { "активный", "завершенный", "приостановленный", "планируется" };
 
-            //   
-            bool valid_status = false;
-            for (const auto& status : valid_statuses) {
-                if (new_status == status) {
-                    valid_status = true;
-                    break;
-                }
-            }
+            // Проверяем корректность статуса (с учетом регистра и английских синонимов)
+            bool valid_status = parse_project_status(new_status) != ProjectStatus::OTHER;
 
             if (!valid_status && !new_status.empty()) {
-                cout << ":  '" << new_status << "'   .\n";
-                cout << " : ";
+                cout << "Предупреждение: статус '" << new_status << "' не является стандартным.\n";
+                cout << "Стандартные статусы: ";
                 for (size_t i = 0; i < valid_statuses.size(); ++i) {
                     if (i > 0) cout << ", ";
                     cout << valid_statuses[i];
                 }
                 cout << "\n";
 
-                cout << "   ? (y/n): ";
+                cout << "Продолжить с пользовательским статусом? (y/n): ";
                 string confirm = input_line("");
                 if (confirm != "y" && confirm != "Y") {
-                    cout << "  .\n";
+                    cout << "Изменение статуса отменено.\n";
                     break;
                 }
             }
 
             project->set_status(new_status);
             project_store_->save_projects_to_file();
-            cout << "  .\n";
+            cout << "Статус проекта обновлен.\n";
             break;
         }
         case 2: {
-            cout << " :\n";
+            cout << "Текущее описание:\n";
             cout << project->description() << "\n\n";
 
-            string new_desc = input_line("  ( Enter  ): ");
+            string new_desc = input_line("Новое описание (нажмите Enter для отмены): ");
             if (new_desc.empty()) {
-                cout << "  .\n";
+                cout << "Изменение описания отменено.\n";
                 break;
             }
 
             if (new_desc.length() < 10) {
-                cout << "   ( 10 ).\n";
-                cout << "? (y/n): ";
+                cout << "Описание слишком короткое (минимум 10 символов).\n";
+                cout << "Продолжить? (y/n): ";
                 string confirm = input_line("");
                 if (confirm != "y" && confirm != "Y") {
                     break;
@@ -606,107 +972,107 @@ void Application::hr_edit_project() {
 
             project->set_description(new_desc);
             project_store_->save_projects_to_file();
-            cout << "  .\n";
+            cout << "Описание проекта обновлено.\n";
             break;
         }
         case 3: {
-            //    ( )
+            // Изменение роли сотрудника (существующий код)
             auto project_employees = project_store_->get_project_employees(project_name);
             if (project_employees.empty()) {
-                cout << "   .\n";
+                cout << "На проекте нет сотрудников.\n";
                 break;
             }
 
-            cout << "  :\n";
+            cout << "Сотрудники на проекте:\n";
             for (size_t i = 0; i < project_employees.size(); ++i) {
                 User* user = store_->find_by_username(project_employees[i]->username());
                 if (user) {
                     cout << (i + 1) << ") " << user->fullname()
-                        << " -  : " << project_employees[i]->role() << "\n";
+                        << " - Текущая роль: " << project_employees[i]->role() << "\n";
                 }
             }
 
-            int emp_choice = input_int(" : ");
+            int emp_choice = input_int("Выберите сотрудника: ");
             if (emp_choice < 1 || emp_choice > static_cast<int>(project_employees.size())) {
-                cout << " .\n";
+                cout << "Неверный выбор.\n";
                 break;
             }
 
             const string username = project_employees[emp_choice - 1]->username();
-            cout << " :  ( ), , , , , \n";
-            string new_role = input_line(" : ");
+            cout << "Доступные роли: Участник (по умолчанию), Руководитель, Разработчик, Тестировщик, Аналитик, Дизайнер\n";
+            string new_role = input_line("Новая роль: ");
 
             if (new_role.empty()) {
-                new_role = "";
+                new_role = "участник";
             }
 
             if (project_store_->update_employee_role(username, project_name, new_role)) {
-                cout << "  .\n";
+                cout << "Роль сотрудника обновлена.\n";
             }
             else {
-                cout << "  .\n";
+                cout << "Ошибка обновления роли.\n";
             }
             break;
         }
         default:
-            cout << " .\n";
+            cout << "Неверный выбор.\n";
         }
     } while (true);
    
 }
 
 void Application::hr_delete_project() {
-    cout << "\n---   ---\n";
+    cout << "\n--- Удаление проекта ---\n";
 
     auto projects = project_store_->all_projects();
     if (projects.empty()) {
-        cout << " .\n";
+        cout << "Нет проектов.\n";
         return;
     }
 
-    cout << " :\n";
+    cout << "Список проектов:\n";
     for (size_t i = 0; i < projects.size(); ++i) {
         cout << (i + 1) << ") " << projects[i]->name() << "\n";
     }
 
-    int choice = input_int("   : ");
+    int choice = input_int("Выберите проект для удаления: ");
     if (choice < 1 || choice > static_cast<int>(projects.size())) {
-        cout << " .\n";
+        cout << "Неверный выбор.\n";
         return;
     }
 
     const string project_name = projects[choice - 1]->name();
 
-    cout << " ,     '" << project_name << "'? (y/n): ";
+    cout << "Вы уверены, что хотите удалить проект '" << project_name << "'? (y/n): ";
     string confirm = input_line("");
     if (confirm == "y" || confirm == "Y") {
         if (project_store_->remove_project(project_name)) {
-            cout << " .\n";
+            cout << "Проект удален.\n";
         }
         else {
-            cout << "  .\n";
+            cout << "Ошибка удаления проекта.\n";
         }
     }
     else {
-        cout << " .\n";
+        cout << "Удаление отменено.\n";
     }
 }
 
 void Application::hr_search_projects() {
-    cout << "\n---   ---\n";
-    string keyword = input_line("    : ");
+    cout << "\n--- Поиск проектов ---\n";
+    string keyword = input_line("Введите ключевое слово для поиска: ");
 
     auto results = project_store_->search_projects_by_name(keyword);
 
     if (results.empty()) {
-        cout << "\n  .\n";
+        cout << "\nПроекты не найдены.\n";
     }
     else {
-        cout << "\n---   (" << results.size() << ") ---\n";
+        cout << "\n--- Результаты поиска (" << results.size() << ") ---\n";
 
-        //   
-        vector<size_t> widths = { 30, 20, 15, 20 }; // , , , 
-        vector<string> headers = { " ", "", "", " " };
+        // Определяем ширины колонок
+        vector<size_t> widths = { 30, 20, 15, 20 }; // Название, Описание, Статус, Дата
+        vector<string> headers = { "Название проекта", "Описание", "Статус", "Дата создания" };
 
         print_table_header(headers, widths);
 
@@ -730,21 +1096,21 @@ void Application::hr_search_projects() {
 }
 
 void Application::hr_filter_projects_by_status() {
-    cout << "\n---     ---\n";
-    cout << " : , , \n";
-    string status = input_line("   : ");
+    cout << "\n--- Фильтр проектов по статусу ---\n";
+    cout << "Доступные статусы: Активный, Завершенный, Приостановленный\n";
+    string status = input_line("Введите статус для фильтрации: ");
 
     auto results = project_store_->filter_projects_by_status(status);
 
     if (results.empty()) {
-        cout << "\n   '" << status << "'  .\n";
+        cout << "\nПроекты с статусом '" << status << "' не найдены.\n";
     }
     else {
-        cout << "\n---    '" << status << "' (" << results.size() << ") ---\n";
+        cout << "\n--- Проекты со статусом '" << status << "' (" << results.size() << ") ---\n";
 
-        //   
-        vector<size_t> widths = { 30, 25, 20 }; // , , 
-        vector<string> headers = { " ", "", " " };
+        // Определяем ширины колонок
+        vector<size_t> widths = { 30, 25, 20 }; // Название, Описание, Дата
+        vector<string> headers = { "Название проекта", "Описание", "Дата создания" };
 
         print_table_header(headers, widths);
 
@@ -767,13 +1133,13 @@ void Application::hr_filter_projects_by_status() {
 }
 
 void Application::hr_sort_projects() {
-    cout << "\n---   ---\n";
-    cout << "1)   (-)\n";
-    cout << "2)   (-)\n";
-    cout << "3)    ( )\n";
-    cout << "4)    ( )\n";
+    cout << "\n--- Сортировка проектов ---\n";
+    cout << "1) По названию (А-Я)\n";
+    cout << "2) По названию (Я-А)\n";
+    cout << "3) По дате создания (старые сначала)\n";
+    cout << "4) По дате создания (новые сначала)\n";
 
-    int choice = input_int("  : ");
+    int choice = input_int("Выберите тип сортировки: ");
 
     vector<const Project*> sorted_projects;
     string title;
@@ -781,35 +1147,35 @@ void Application::hr_sort_projects() {
     switch (choice) {
     case 1:
         sorted_projects = project_store_->get_projects_sorted_by_name(true);
-        title = "    (-)";
+        title = "Проекты отсортированные по названию (А-Я)";
         break;
     case 2:
         sorted_projects = project_store_->get_projects_sorted_by_name(false);
-        title = "    (-)";
+        title = "Проекты отсортированные по названию (Я-А)";
         break;
     case 3:
         sorted_projects = project_store_->get_projects_sorted_by_date(true);
-        title = "     ( )";
+        title = "Проекты отсортированные по дате создания (старые сначала)";
         break;
     case 4:
         sorted_projects = project_store_->get_projects_sorted_by_date(false);
-        title = "     ( )";
+        title = "Проекты отсортированные по дате создания (новые сначала)";
         break;
     default:
-        cout << " .\n";
+        cout << "Неверный выбор.\n";
         return;
     }
 
     if (sorted_projects.empty()) {
-        cout << "\n .\n";
+        cout << "\nНет проектов.\n";
         return;
     }
 
     cout << "\n--- " << title << " (" << sorted_projects.size() << ") ---\n";
 
-    //   
-    vector<size_t> widths = { 30, 20, 15, 20 }; // , , , 
-    vector<string> headers = { " ", "", "", " " };
+    // Определяем ширины колонок
+    vector<size_t> widths = { 30, 20, 15, 20 }; // Название, Описание, Статус, Дата
+    vector<string> headers = { "Название проекта", "Описание", "Статус", "Дата создания" };
 
     print_table_header(headers, widths);
 
@@ -1,12 +1,33 @@
 #pragma once
 #include"Utilities.h"
+#include "Journal.h"
+#include "MappedFile.h"
+#include "TrigramIndex.h"
 
 class User;
 class UserStore;
 class Application;
 
 
-// ---------------------------   ---------------------------
+// --------------------------- Словари статусов и ролей ---------------------------
+// Статус проекта и роль в проекте хранятся строкой (для вывода и файла) и кодом из
+// общего словаря. Регистр и русские/английские синонимы сводятся к коду один раз —
+// при загрузке или изменении, дальше сравниваются только коды.
+enum class ProjectStatus : unsigned char { OTHER, ACTIVE, COMPLETED, SUSPENDED, PLANNED };
+
+enum class ProjectRole : unsigned char {
+    OTHER, MEMBER, LEAD, MANAGER, LEAD_DEVELOPER, DEVELOPER, TESTER, ANALYST, DESIGNER
+};
+
+ProjectStatus parse_project_status(string_view status);
+ProjectRole parse_project_role(string_view role);
+
+// Руководящие роли учитываются в оценке эффективности и в отчетах одинаково
+inline bool is_leadership_role(ProjectRole role) {
+    return role == ProjectRole::LEAD || role == ProjectRole::MANAGER || role == ProjectRole::LEAD_DEVELOPER;
+}
+
+// --------------------------- Класс проекта ---------------------------
 class Project {
     friend ostream& operator<<(ostream&, const Project&);
    
@@ -15,28 +36,38 @@ public:
     Project(string name, string description, string status)
         : name_(move(name)), description_(move(description)), status_(move(status)) {
         created_date_ = now_string();
+        status_code_ = parse_project_status(status_);
     }
 
     const string& name() const { return name_; }
     const string& description() const { return description_; }
     const string& status() const { return status_; }
     const string& created_date() const { return created_date_; }
+    ProjectStatus status_code() const { return status_code_; }
 
-    void set_status(const string& status) { status_ = status; }
+    void set_status(const string& status) {
+        status_ = status;
+        status_code_ = parse_project_status(status_);
+    }
     void set_description(const string& desc) { description_ = desc; }
 
-    //     
+    // Сериализация в строку для файла
     string serialize() const {
         return name_ + "|" + description_ + "|" + status_ + "|" + created_date_;
     }
 
     static unique_ptr<Project> create_from_record(const string& record) {
-        auto parts = split(record, '|');
-        if (parts.size() >= 4) {
+        string_view fields[4];
+        size_t count = split_fields(record, '|', fields, 4);
+        return create_from_fields(fields, count);
+    }
+
+    static unique_ptr<Project> create_from_fields(const string_view* fields, size_t count) {
+        if (count >= 4) {
             auto project = make_unique<Project>(
-                trim(parts[0]),  // name
-                trim(parts[1]),  // description
-                trim(parts[2])   // status
+                string(fields[0]),  // name
+                string(fields[1]),  // description
+                string(fields[2])   // status
             );
             return project;
         }
@@ -48,36 +79,48 @@ private:
     string description_;
     string status_;
     string created_date_;
+    ProjectStatus status_code_ = ProjectStatus::OTHER;
 };
 
-// ---------------------------  - ---------------------------
+// --------------------------- Связь сотрудник-проект ---------------------------
 class EmployeeProject {
     friend ostream& operator<<(ostream&, const EmployeeProject&);
 public:
     EmployeeProject(string username, string project_name, string role)
         : username_(move(username)), project_name_(move(project_name)), role_(move(role)) {
         assigned_date_ = now_string();
+        role_code_ = parse_project_role(role_);
     }
     
     const string& username() const { return username_; }
     const string& project_name() const { return project_name_; }
     const string& role() const { return role_; }
     const string& assigned_date() const { return assigned_date_; }
+    ProjectRole role_code() const { return role_code_; }
+    bool is_leadership() const { return is_leadership_role(role_code_); }
 
-    void set_role(const string& role) { role_ = role; }
+    void set_role(const string& role) {
+        role_ = role;
+        role_code_ = parse_project_role(role_);
+    }
 
-    //     
+    // Сериализация в строку для файла
     string serialize() const {
         return username_ + "|" + project_name_ + "|" + role_ + "|" + assigned_date_;
     }
 
     static unique_ptr<EmployeeProject> create_from_record(const string& record) {
-        auto parts = split(record, '|');
-        if (parts.size() >= 4) {
+        string_view fields[4];
+        size_t count = split_fields(record, '|', fields, 4);
+        return create_from_fields(fields, count);
+    }
+
+    static unique_ptr<EmployeeProject> create_from_fields(const string_view* fields, size_t count) {
+        if (count >= 4) {
             auto emp_proj = make_unique<EmployeeProject>(
-                trim(parts[0]),  // username
-                trim(parts[1]),  // project_name
-                trim(parts[2])   // role
+                string(fields[0]),  // username
+                string(fields[1]),  // project_name
+                string(fields[2])   // role
             );
             return emp_proj;
         }
@@ -89,15 +132,94 @@ private:
     string project_name_;
     string role_;
     string assigned_date_;
+    ProjectRole role_code_ = ProjectRole::OTHER;
+};
+
+// Составной ключ (логин, проект) индекса назначений. Представления указывают в строки
+// самого EmployeeProject: логин и проект у назначения после создания не меняются
+struct AssignmentKey {
+    string_view username;
+    string_view project_name;
+
+    bool operator==(const AssignmentKey&) const = default;
 };
 
-// ---------------------------   ---------------------------
+struct AssignmentKeyHash {
+    size_t operator()(const AssignmentKey& key) const {
+        size_t h = hash<string_view>{}(key.username);
+        return h ^ (hash<string_view>{}(key.project_name) + 0x9E3779B9 + (h << 6) + (h >> 2));
+    }
+};
+
+// Результат соединения назначения с проектом: проект, роль и дата назначения за один проход
+struct EmployeeProjectLink {
+    const Project* project;
+    const EmployeeProject* assignment;
+};
+
+// Сводка участия сотрудника в проектах: из нее считается оценка выполненных задач
+struct ProjectActivity {
+    int total_projects = 0;
+    int active_projects = 0;
+    int completed_projects = 0;
+    int leadership_count = 0;
+
+    // Оценка выполненных задач (0-100): доля завершенных, бонусы за лидерство и активность
+    double tasks_score() const;
+};
+
+// --------------------------- Хранилище проектов ---------------------------
 class ProjectStore : public Store<Project> {
 private:
     vector<unique_ptr<Project>> projects_;
     vector<unique_ptr<EmployeeProject>> employee_projects_;
 
+    // Журнал назначений: каждое изменение дописывается одной записью
+    // ("+|логин|проект|роль|дата", "-|логин|проект", "~|логин|проект|роль"),
+    // employee_projects.txt переписывается только при уплотнении
+    AppendJournal employee_projects_journal_{ EMPLOYEE_PROJECTS_JOURNAL_FILE };
+    size_t employee_projects_base_records_ = 0;
+
+    // Уплотнение: журнал длиннее этой доли базового файла (и не короче порога)
+    static constexpr double JOURNAL_COMPACTION_RATIO = 0.5;
+    static constexpr size_t JOURNAL_MIN_RECORDS = 64;
+
+    // Индексы поверх projects_/employee_projects_ (владеют объектами векторы).
+    // Связи в списках идут в порядке employee_projects_, поэтому выборки
+    // возвращают их в том же порядке, что и прежний полный проход.
+    StringMap<Project*> project_by_name_;
+    StringMap<vector<EmployeeProject*>> assignments_by_user_;
+    StringMap<vector<EmployeeProject*>> assignments_by_project_;
+    // (логин, проект) -> назначение; при повторных назначениях — первое по порядку файла
+    unordered_map<AssignmentKey, EmployeeProject*, AssignmentKeyHash> assignment_by_key_;
+    // Поиск подстроки в названии (search_projects_by_name), порядок выдачи - порядок projects_
+    TrigramIndex<Project> project_name_search_;
+
+    void rebuild_project_index();
+    void rebuild_assignment_indexes();
+    void index_assignment(EmployeeProject* emp_proj);
+    void unindex_assignment(const EmployeeProject* emp_proj);
+    EmployeeProject* find_assignment(string_view username, string_view project_name) const;
+    void erase_assignment(const EmployeeProject* emp_proj);
+
+    // Пакетный режим: полные перезаписи откладываются, записи журнала копятся в памяти
+    int batch_depth_ = 0;
+    bool projects_dirty_ = false;
+    bool employee_projects_dirty_ = false;
+    vector<string> pending_journal_records_;
+    // Откат на месте (см. BatchRollback) и число записей журнала на начало каждого уровня
+    BatchRollback<Project> projects_rollback_;
+    BatchRollback<EmployeeProject> employee_projects_rollback_;
+    vector<size_t> pending_journal_marks_;
+
+    void log_employee_project_change(const string& record);
+    void apply_employee_project_record(string_view record);
+    bool employee_projects_journal_too_long() const;
+    string recover_employee_projects_compaction();
+
 public:
+    using Transaction = StoreTransaction<ProjectStore>;
+
     ProjectStore() {
         load_from_file();
     }
@@ -105,34 +227,47 @@ public:
     void load_from_file();
     void save_all_files();
     
-    // CRUD   
+    // CRUD операции для проектов
     bool add_project(unique_ptr<Project> project);
     bool remove_project(const string& project_name);
     bool update_project(const string& project_name, const string& new_status);
     bool update_project(const string& project_name, const string& new_status, const string& new_description);
     Project* find_project(const string& project_name) const;
 
-    // CRUD    -
+    // CRUD операции для связи сотрудник-проект
     bool assign_employee_to_project(const string& username, const string& project_name);
     bool assign_employee_to_project(const string& username, const string& project_name, const string& role);
 
     bool remove_employee_from_project(const string& username, const string& project_name);
     bool update_employee_role(const string& username, const string& project_name, const string& new_role);
 
-    //  
+    // Получение данных
     vector<const Project*> all_projects() const;
     vector<const EmployeeProject*> all_employee_projects() const;
     vector<const Project*> get_employee_projects(const string& username) const;
     vector<const EmployeeProject*> get_project_employees(const string& project_name) const;
+    vector<EmployeeProjectLink> get_employee_project_links(const string& username) const;
+    ProjectActivity get_employee_activity(const string& username) const;
+
+    // Роль сотрудника в проекте за O(1); nullptr, если сотрудник не назначен
+    const string* role_of(string_view username, string_view project_name) const;
 
-    //   
+    // Поиск и фильтрация. Поиск по названию - без учета регистра, через триграммный индекс
     vector<const Project*> search_projects_by_name(const string& keyword) const;
     vector<const Project*> filter_projects_by_status(const string& status) const;
 
-    // 
+    // Сортировка
     vector<const Project*> get_projects_sorted_by_name(bool ascending = true) const;
     vector<const Project*> get_projects_sorted_by_date(bool ascending = true) const;
 
+    // Пакетная запись (используйте ProjectStore::Transaction).
+    // commit вложенного пакета переносит его изменения во внешний, rollback отменяет
+    // изменения своего уровня на месте: объекты, бывшие до пакета, не пересоздаются.
+    void begin_batch();
+    void commit_batch();
+    void rollback_batch();
+    bool in_batch() const { return batch_depth_ > 0; }
+
 public:
     void load_projects_from_file();
     void load_employee_projects_from_file();
@@ -140,7 +275,13 @@ public:
     void save_employee_projects_to_file();
 };
 namespace HRSystem {
+    using ::ProjectStatus;
+    using ::ProjectRole;
+    using ::parse_project_status;
+    using ::parse_project_role;
+    using ::is_leadership_role;
     using ::Project;
     using ::EmployeeProject;
+    using ::ProjectActivity;
     using ::ProjectStore;
 }
\ No newline at end of file
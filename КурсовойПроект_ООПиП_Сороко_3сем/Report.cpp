@@ -0,0 +1,550 @@
+#include "Report.h"
+#include "Utilities.h"
+#include "Stats.h"
+#include <charconv>
+#include <fstream>
+#include <locale>
+
+using namespace std;
+
+// --------------------------- Модель отчета о сотруднике ---------------------------
+
+static double percent_of(int part, int total) {
+    return total > 0 ? (static_cast<double>(part) / total) * 100 : 0;
+}
+
+double ReportModel::completion_rate() const { return percent_of(completed_projects, total_projects); }
+double ReportModel::activity_rate() const { return percent_of(active_projects, total_projects); }
+double ReportModel::leadership_rate() const { return percent_of(leadership_count, total_projects); }
+
+const char* ReportModel::score_level() const {
+    return score >= 90 ? "ОТЛИЧНО" :
+        score >= 75 ? "ХОРОШО" :
+        score >= 60 ? "УДОВЛЕТВОРИТЕЛЬНО" :
+        score >= 40 ? "ТРЕБУЕТСЯ УЛУЧШЕНИЕ" : "НЕДОСТАТОЧНО";
+}
+
+// --------------------------- Рендереры отчета ---------------------------
+
+const string& ReportRenderer::render(const ReportModel& model) {
+    STAT_SCOPE(stat, "ReportRenderer::render");
+    buffer_.clear();
+    write(model, buffer_);
+    return buffer_;
+}
+
+void ReportRenderer::render_to(const ReportModel& model, ostream& out) {
+    const string& text = render(model);
+    out.write(text.data(), static_cast<streamsize>(text.size()));
+}
+
+bool ReportRenderer::render_to_file(const ReportModel& model, const string& path) {
+    return write_file(path, render(model));
+}
+
+bool ReportRenderer::write_file(const string& path, string_view text) {
+    STAT_SCOPE(stat, "ReportRenderer::write_file");
+    ofstream file(path);
+    if (!file) return false;
+
+    file.write(text.data(), static_cast<streamsize>(text.size()));
+    file.close();
+    if (!file) return false;
+    stat.add_bytes(static_cast<long long>(text.size()));
+    return true;
+}
+
+unique_ptr<ReportRenderer> make_report_renderer(ReportFormat format) {
+    switch (format) {
+    case ReportFormat::CONSOLE: return make_unique<ConsoleReportRenderer>();
+    case ReportFormat::JSON: return make_unique<JsonReportRenderer>();
+    case ReportFormat::CSV: return make_unique<CsvReportRenderer>();
+    case ReportFormat::TEXT:
+    default: return make_unique<TextReportRenderer>();
+    }
+}
+
+const char* report_file_extension(ReportFormat format) {
+    switch (format) {
+    case ReportFormat::JSON: return ".json";
+    case ReportFormat::CSV: return ".csv";
+    default: return ".txt";
+    }
+}
+
+// --------------------------- Таблицы отчета (экран и текстовый файл) ---------------------------
+// Ширины те же, что у прежнего вывода через setw: длинное значение не обрезается,
+// а раздвигает строку.
+
+static const size_t REPORT_WIDTH = 80;
+
+static void append_left(string& out, string_view text, size_t width) {
+    out += text;
+    if (text.size() < width) out.append(width - text.size(), ' ');
+}
+
+static void append_right(string& out, string_view text, size_t width) {
+    if (text.size() < width) out.append(width - text.size(), ' ');
+    out += text;
+}
+
+static void append_line(string& out, char symbol) {
+    out.append(REPORT_WIDTH, symbol);
+    out += '\n';
+}
+
+// "|  заголовок по центру  |"
+static void append_title(string& out, string_view title) {
+    const size_t width = REPORT_WIDTH - 2;
+    out += '|';
+    if (title.size() >= width) {
+        out += title.substr(0, width);
+    }
+    else {
+        size_t left_padding = (width - title.size()) / 2;
+        out.append(left_padding, ' ');
+        out += title;
+        out.append(width - title.size() - left_padding, ' ');
+    }
+    out += "|\n";
+}
+
+// "| подпись | значение |" со значением, прижатым влево
+static void append_text_row(string& out, string_view label, size_t label_width, string_view value) {
+    out += "| ";
+    append_left(out, label, label_width);
+    out += " | ";
+    append_left(out, value, REPORT_WIDTH - label_width - 7);
+    out += " |\n";
+}
+
+// "| текст во всю ширину |"
+static void append_wide_row(string& out, string_view text) {
+    out += "| ";
+    append_left(out, text, REPORT_WIDTH - 4);
+    out += " |\n";
+}
+
+// Число с фиксированной точностью без потоков и локали; point - десятичный разделитель
+static string_view format_fixed(char (&buf)[32], double value, int precision, char point) {
+    auto result = to_chars(buf, buf + sizeof(buf), value, chars_format::fixed, precision);
+    if (point != '.') {
+        for (char* p = buf; p != result.ptr; ++p) {
+            if (*p == '.') *p = point;
+        }
+    }
+    return string_view(buf, result.ptr - buf);
+}
+
+static void append_int(string& out, long long value) {
+    char buf[24];
+    auto result = to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, result.ptr);
+}
+
+static void append_activity(string& out, const ReportModel& model, char point) {
+    const size_t label_width = 30;
+    const size_t value_width = REPORT_WIDTH - label_width - 7;
+
+    append_title(out, "ПРОЕКТНАЯ АКТИВНОСТЬ");
+    append_line(out, '-');
+
+    auto count_row = [&](string_view label, int value) {
+        out += "| ";
+        append_left(out, label, label_width);
+        out += " | ";
+        char buf[16];
+        auto result = to_chars(buf, buf + sizeof(buf), value);
+        append_right(out, string_view(buf, result.ptr - buf), value_width);
+        out += " |\n";
+    };
+    count_row("Всего проектов:", model.total_projects);
+    count_row("Активных проектов:", model.active_projects);
+    count_row("Завершенных проектов:", model.completed_projects);
+    count_row("Лидерских ролей:", model.leadership_count);
+
+    if (model.total_projects > 0) {
+        auto rate_row = [&](string_view label, double rate) {
+            out += "| ";
+            append_left(out, label, label_width);
+            out += " | ";
+            char buf[32];
+            append_right(out, format_fixed(buf, rate, 1, point), value_width);
+            out += "%|\n";
+        };
+        rate_row("Процент завершения:", model.completion_rate());
+        rate_row("Процент активности:", model.activity_rate());
+        rate_row("Процент лидерства:", model.leadership_rate());
+    }
+}
+
+// Таблица проектов без заголовка блока; max_rows == 0 - все проекты
+static void append_projects(string& out, const ReportModel& model, string_view date_header,
+    size_t max_rows, size_t date_width) {
+    const size_t name_width = 30;
+    const size_t status_width = 15;
+    const size_t date_column = 25;
+
+    out += "| ";
+    append_left(out, "Название проекта", name_width);
+    out += " | ";
+    append_left(out, "Статус", status_width);
+    out += " | ";
+    append_left(out, date_header, date_column);
+    out += " |\n";
+    append_line(out, '-');
+
+    size_t rows = max_rows == 0 ? model.projects.size() : min(model.projects.size(), max_rows);
+    for (size_t i = 0; i < rows; ++i) {
+        const ReportProjectRow& project = model.projects[i];
+
+        out += "| ";
+        if (project.name.size() > name_width - 2) {
+            out.append(project.name, 0, name_width - 3);
+            out += "...";
+        }
+        else {
+            append_left(out, project.name, name_width);
+        }
+        out += " | ";
+        if (project.status.size() > status_width - 2) {
+            out.append(project.status, 0, status_width - 3);
+            out += "...";
+        }
+        else {
+            append_left(out, project.status, status_width);
+        }
+        out += " | ";
+        append_left(out, string_view(project.assigned_date).substr(0, date_width), date_column);
+        out += " |\n";
+    }
+}
+
+static void append_score(string& out, const ReportModel& model, char point) {
+    append_title(out, "ОЦЕНКА ЭФФЕКТИВНОСТИ");
+    append_line(out, '-');
+
+    if (model.has_score) {
+        out += "| ";
+        append_left(out, "Текущая оценка:", 40);
+        out += " | ";
+        char buf[32];
+        append_right(out, format_fixed(buf, model.score, 2, point), 29);
+        out += "/100 |\n";
+
+        out += "| ";
+        append_left(out, "Уровень:", 40);
+        out += " | ";
+        append_left(out, model.score_level(), 33);
+        out += " |\n";
+    }
+    else {
+        append_wide_row(out, "Оценка эффективности не рассчитана. Используйте пункт меню");
+        append_wide_row(out, "'Рассчитать эффективность сотрудника' для проведения оценки.");
+    }
+    append_line(out, '=');
+}
+
+// max_length == 0 - без обрезки
+static void append_recommendations(string& out, const ReportModel& model, size_t max_length) {
+    append_title(out, "РЕКОМЕНДАЦИИ ДЛЯ РАЗВИТИЯ");
+    append_line(out, '-');
+
+    string line;
+    for (size_t i = 0; i < model.recommendations.size(); ++i) {
+        line.clear();
+        append_int(line, static_cast<long long>(i + 1));
+        line += ". ";
+        line += model.recommendations[i];
+        if (max_length != 0 && line.size() > max_length) {
+            line.resize(max_length - 3);
+            line += "...";
+        }
+        append_wide_row(out, line);
+    }
+}
+
+static void append_signature(string& out) {
+    out += "| ";
+    append_left(out, "Подпись HR-менеджера: ___________________", 40);
+    out += " | ";
+    append_left(out, "Дата: ___________________", REPORT_WIDTH - 40 - 7);
+    out += "|\n";
+    append_line(out, '=');
+}
+
+// cout создается до смены глобальной локали и печатает числа с точкой
+void ConsoleReportRenderer::write(const ReportModel& model, string& out) const {
+    const char point = '.';
+
+    out += '\n';
+    append_line(out, '=');
+    append_title(out, "ОТЧЕТ О СОТРУДНИКЕ");
+    append_line(out, '=');
+
+    append_title(out, "ОСНОВНАЯ ИНФОРМАЦИЯ");
+    append_line(out, '-');
+    append_text_row(out, "ФИО:", 20, model.fullname);
+    append_text_row(out, "Отдел:", 20, model.department);
+    append_text_row(out, "Дата генерации:", 20, model.generated_at);
+    append_line(out, '=');
+
+    append_activity(out, model, point);
+    append_line(out, '=');
+
+    if (!model.projects.empty()) {
+        const size_t shown = 10;
+        append_title(out, "ДЕТАЛИ ПРОЕКТОВ");
+        append_line(out, '-');
+        append_projects(out, model, "Дата", shown, 25);
+        if (model.projects.size() > shown) {
+            string more = "... и еще ";
+            append_int(more, static_cast<long long>(model.projects.size() - shown));
+            more += " проектов";
+            append_wide_row(out, more);
+        }
+        append_line(out, '=');
+    }
+
+    append_score(out, model, point);
+    append_recommendations(out, model, REPORT_WIDTH - 4);
+    append_line(out, '=');
+    append_signature(out);
+}
+
+// Файл открывается после смены глобальной локали, поэтому, как и прежний вывод через
+// ofstream, берет десятичный разделитель из нее (в русской локали - запятая)
+void TextReportRenderer::write(const ReportModel& model, string& out) const {
+    const char point = use_facet<numpunct<char>>(locale()).decimal_point();
+
+    append_line(out, '=');
+    append_title(out, "ОТЧЕТ HR О СОТРУДНИКЕ");
+    append_line(out, '=');
+    append_text_row(out, "Дата генерации:", 20, model.generated_at);
+    append_text_row(out, "Сгенерировано:", 20, "HR-менеджером");
+    append_line(out, '=');
+    out += '\n';
+
+    append_line(out, '=');
+    append_title(out, "ОСНОВНАЯ ИНФОРМАЦИЯ");
+    append_line(out, '-');
+    append_text_row(out, "ФИО:", 20, model.fullname);
+    append_text_row(out, "Отдел:", 20, model.department);
+    append_line(out, '=');
+    out += '\n';
+
+    append_line(out, '=');
+    append_activity(out, model, point);
+    append_line(out, '=');
+    out += '\n';
+
+    if (!model.projects.empty()) {
+        append_line(out, '=');
+        append_title(out, "ДЕТАЛИ ПРОЕКТОВ");
+        append_line(out, '-');
+        append_projects(out, model, "Дата назначения", 0, string::npos);
+        append_line(out, '=');
+        out += '\n';
+    }
+
+    append_score(out, model, point);
+    append_recommendations(out, model, 0);
+    append_line(out, '=');
+    out += '\n';
+
+    append_line(out, '=');
+    append_signature(out);
+}
+
+// --------------------------- JSON ---------------------------
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+void append_json_string(string& out, string_view text) {
+    out += '"';
+    for (char ch : text) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (c >= 0x20 && c < 0x80) {
+                out += ch;
+            }
+            else {
+                char16_t code = c < 0x20 ? c : cp1251_to_unicode(c);
+                out += "\\u";
+                out += HEX_DIGITS[(code >> 12) & 0xF];
+                out += HEX_DIGITS[(code >> 8) & 0xF];
+                out += HEX_DIGITS[(code >> 4) & 0xF];
+                out += HEX_DIGITS[code & 0xF];
+            }
+        }
+    }
+    out += '"';
+}
+
+static void append_json_key(string& out, string_view key) {
+    out += "  \"";
+    out += key;
+    out += "\": ";
+}
+
+static void append_json_field(string& out, string_view key, string_view value) {
+    append_json_key(out, key);
+    append_json_string(out, value);
+    out += ",\n";
+}
+
+static void append_json_field(string& out, string_view key, int value) {
+    append_json_key(out, key);
+    append_int(out, value);
+    out += ",\n";
+}
+
+static void append_json_field(string& out, string_view key, double value, int precision) {
+    append_json_key(out, key);
+    char buf[32];
+    out += format_fixed(buf, value, precision, '.');
+    out += ",\n";
+}
+
+void JsonReportRenderer::write(const ReportModel& model, string& out) const {
+    out += "{\n";
+    append_json_field(out, "username", model.username);
+    append_json_field(out, "fullname", model.fullname);
+    append_json_field(out, "department", model.department);
+    append_json_field(out, "department_parameter", model.department_parameter);
+    append_json_field(out, "generated_at", model.generated_at);
+    append_json_field(out, "projects_total", model.total_projects);
+    append_json_field(out, "projects_active", model.active_projects);
+    append_json_field(out, "projects_completed", model.completed_projects);
+    append_json_field(out, "leadership_roles", model.leadership_count);
+    append_json_field(out, "completion_rate", model.completion_rate(), 1);
+    append_json_field(out, "activity_rate", model.activity_rate(), 1);
+    append_json_field(out, "leadership_rate", model.leadership_rate(), 1);
+
+    if (model.has_score) {
+        append_json_field(out, "score", model.score, 2);
+        append_json_field(out, "level", model.score_level());
+    }
+    else {
+        out += "  \"score\": null,\n  \"level\": null,\n";
+    }
+
+    append_json_key(out, "projects");
+    if (model.projects.empty()) {
+        out += "[],\n";
+    }
+    else {
+        out += "[\n";
+        for (size_t i = 0; i < model.projects.size(); ++i) {
+            const ReportProjectRow& project = model.projects[i];
+            out += "    {\"name\": ";
+            append_json_string(out, project.name);
+            out += ", \"status\": ";
+            append_json_string(out, project.status);
+            out += ", \"role\": ";
+            append_json_string(out, project.role);
+            out += ", \"assigned_date\": ";
+            append_json_string(out, project.assigned_date);
+            out += ", \"created_date\": ";
+            append_json_string(out, project.created_date);
+            out += i + 1 < model.projects.size() ? "},\n" : "}\n";
+        }
+        out += "  ],\n";
+    }
+
+    append_json_key(out, "recommendations");
+    if (model.recommendations.empty()) {
+        out += "[]\n";
+    }
+    else {
+        out += "[\n";
+        for (size_t i = 0; i < model.recommendations.size(); ++i) {
+            out += "    ";
+            append_json_string(out, model.recommendations[i]);
+            out += i + 1 < model.recommendations.size() ? ",\n" : "\n";
+        }
+        out += "  ]\n";
+    }
+    out += "}\n";
+}
+
+// --------------------------- CSV ---------------------------
+
+// Поле в кавычках, только если в нем есть разделитель, кавычка, перевод строки
+// или пробел по краям
+static void append_csv_field(string& out, string_view text) {
+    bool quote = text.find_first_of(",\"\r\n") != string_view::npos ||
+        (!text.empty() && (text.front() == ' ' || text.back() == ' '));
+    if (!quote) {
+        out += text;
+        return;
+    }
+
+    out += '"';
+    for (char ch : text) {
+        if (ch == '"') out += '"';
+        out += ch;
+    }
+    out += '"';
+}
+
+void CsvReportRenderer::write(const ReportModel& model, string& out) const {
+    char buf[32];
+
+    out += "username,fullname,department,department_parameter,generated_at,"
+        "projects_total,projects_active,projects_completed,leadership_roles,"
+        "completion_rate,activity_rate,leadership_rate,score,level\n";
+    append_csv_field(out, model.username);
+    out += ',';
+    append_csv_field(out, model.fullname);
+    out += ',';
+    append_csv_field(out, model.department);
+    out += ',';
+    append_csv_field(out, model.department_parameter);
+    out += ',';
+    append_csv_field(out, model.generated_at);
+    for (int value : { model.total_projects, model.active_projects, model.completed_projects, model.leadership_count }) {
+        out += ',';
+        append_int(out, value);
+    }
+    for (double rate : { model.completion_rate(), model.activity_rate(), model.leadership_rate() }) {
+        out += ',';
+        out += format_fixed(buf, rate, 1, '.');
+    }
+    out += ',';
+    if (model.has_score) {
+        out += format_fixed(buf, model.score, 2, '.');
+        out += ',';
+        append_csv_field(out, model.score_level());
+    }
+    else {
+        out += ',';
+    }
+    out += '\n';
+
+    out += "\nproject,status,role,assigned_date,created_date\n";
+    for (const ReportProjectRow& project : model.projects) {
+        append_csv_field(out, project.name);
+        out += ',';
+        append_csv_field(out, project.status);
+        out += ',';
+        append_csv_field(out, project.role);
+        out += ',';
+        append_csv_field(out, project.assigned_date);
+        out += ',';
+        append_csv_field(out, project.created_date);
+        out += '\n';
+    }
+
+    out += "\nrecommendation\n";
+    for (const string& recommendation : model.recommendations) {
+        append_csv_field(out, recommendation);
+        out += '\n';
+    }
+}
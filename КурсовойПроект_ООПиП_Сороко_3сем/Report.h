@@ -0,0 +1,122 @@
+#pragma once
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// --------------------------- Модель отчета о сотруднике ---------------------------
+// Собирается из хранилищ один раз (в главном потоке) и дальше только читается
+// рендерерами, поэтому отчеты могут записываться параллельно в пуле потоков.
+struct ReportProjectRow {
+    string name;
+    string status;
+    string role;
+    string assigned_date;
+    string created_date;
+};
+
+struct ReportModel {
+    string username;
+    string fullname;
+    string department;
+    string department_parameter;
+    string generated_at;
+
+    int total_projects = 0;
+    int active_projects = 0;
+    int completed_projects = 0;
+    int leadership_count = 0;
+    vector<ReportProjectRow> projects;
+
+    bool has_score = false;
+    double score = 0;
+
+    vector<string> recommendations;
+
+    // Доли от числа проектов в процентах (0, если проектов нет)
+    double completion_rate() const;
+    double activity_rate() const;
+    double leadership_rate() const;
+    // Словесный уровень оценки ("ОТЛИЧНО", "ХОРОШО", ...)
+    const char* score_level() const;
+};
+
+// --------------------------- Рендереры отчета ---------------------------
+// Каждый рендерер пишет отчет целиком в свой буфер, выделенный один раз при создании
+// и переиспользуемый между вызовами, а затем отдает его в поток или файл одной записью.
+// Рендерер не потокобезопасен: каждому рабочему потоку нужен свой.
+enum class ReportFormat { CONSOLE, TEXT, JSON, CSV };
+
+constexpr size_t REPORT_BUFFER_CAPACITY = 16 * 1024;
+
+class ReportRenderer {
+public:
+    ReportRenderer() { buffer_.reserve(REPORT_BUFFER_CAPACITY); }
+    virtual ~ReportRenderer() = default;
+
+    // Расширение файла вместе с точкой (".txt", ".json", ...)
+    virtual const char* file_extension() const = 0;
+
+    // Отчет целиком; ссылка действительна до следующего вызова
+    const string& render(const ReportModel& model);
+    void render_to(const ReportModel& model, ostream& out);
+    bool render_to_file(const ReportModel& model, const string& path);
+
+    // Записать готовый текст отчета в файл одной операцией
+    static bool write_file(const string& path, string_view text);
+
+protected:
+    virtual void write(const ReportModel& model, string& out) const = 0;
+
+private:
+    string buffer_;
+};
+
+// Таблица для экрана (первые 10 проектов, длинные строки обрезаются)
+class ConsoleReportRenderer : public ReportRenderer {
+public:
+    const char* file_extension() const override { return ".txt"; }
+protected:
+    void write(const ReportModel& model, string& out) const override;
+};
+
+// Текстовый файл HR_REPORT_*.txt (все проекты и рекомендации целиком)
+class TextReportRenderer : public ReportRenderer {
+public:
+    const char* file_extension() const override { return ".txt"; }
+protected:
+    void write(const ReportModel& model, string& out) const override;
+};
+
+// JSON: только ASCII, кириллица CP1251 записывается как \uXXXX
+class JsonReportRenderer : public ReportRenderer {
+public:
+    const char* file_extension() const override { return ".json"; }
+protected:
+    void write(const ReportModel& model, string& out) const override;
+};
+
+// CSV (RFC 4180, разделитель - запятая): сводка, проекты и рекомендации,
+// разделенные пустой строкой
+class CsvReportRenderer : public ReportRenderer {
+public:
+    const char* file_extension() const override { return ".csv"; }
+protected:
+    void write(const ReportModel& model, string& out) const override;
+};
+
+unique_ptr<ReportRenderer> make_report_renderer(ReportFormat format);
+// То же, что file_extension() рендерера этого формата
+const char* report_file_extension(ReportFormat format);
+
+// Строка JSON в кавычках; текст в CP1251, символы вне ASCII записываются как \uXXXX
+void append_json_string(string& out, string_view text);
+
+namespace HRSystem {
+    using ::ReportModel;
+    using ::ReportFormat;
+    using ::ReportRenderer;
+}
@@ -0,0 +1,395 @@
+#include "ReportArchive.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+using namespace std;
+
+// --------------------------- Архив версий отчетов ---------------------------
+
+namespace {
+
+constexpr uint32_t VERSION_COMPRESSED = 1;
+
+// Запись индекса; номер версии n (с 1) лежит по смещению (n - 1) * sizeof(IndexRecord)
+struct IndexRecord {
+    uint64_t offset;
+    uint32_t stored_size;
+    uint32_t raw_size;
+    uint32_t flags;
+    uint32_t checksum;      // FNV-1a несжатого текста
+    char timestamp[24];     // "ГГГГ-ММ-ДД ЧЧ:ММ:СС", дополнено нулями
+};
+static_assert(sizeof(IndexRecord) == 48, "формат индекса архива не должен зависеть от компилятора");
+
+uint32_t text_checksum(string_view text) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool read_record(istream& index, size_t position, IndexRecord& record) {
+    index.seekg(static_cast<streamoff>(position * sizeof(IndexRecord)));
+    return static_cast<bool>(index.read(reinterpret_cast<char*>(&record), sizeof(record)));
+}
+
+bool write_record(ostream& index, size_t position, const IndexRecord& record) {
+    index.seekp(static_cast<streamoff>(position * sizeof(IndexRecord)));
+    return static_cast<bool>(index.write(reinterpret_cast<const char*>(&record), sizeof(record)));
+}
+
+ReportVersionInfo make_info(size_t number, const IndexRecord& record) {
+    ReportVersionInfo info;
+    info.number = number;
+    info.timestamp.assign(record.timestamp, strnlen(record.timestamp, sizeof(record.timestamp)));
+    info.size = record.raw_size;
+    info.stored_size = record.stored_size;
+    info.compressed = (record.flags & VERSION_COMPRESSED) != 0;
+    return info;
+}
+
+// fstream на чтение и запись требует существующего файла
+bool open_for_update(fstream& file, const string& path) {
+    file.open(path, ios::in | ios::out | ios::binary);
+    if (file.is_open()) return true;
+
+    ofstream create(path, ios::binary);
+    create.close();
+    file.open(path, ios::in | ios::out | ios::binary);
+    return file.is_open();
+}
+
+} // namespace
+
+string ReportArchive::data_path(const string& username) const {
+    return (filesystem::path(directory_) / (username + ".reports")).string();
+}
+
+string ReportArchive::index_path(const string& username) const {
+    return (filesystem::path(directory_) / (username + ".index")).string();
+}
+
+size_t ReportArchive::version_count(const string& username) const {
+    error_code ec;
+    uintmax_t size = filesystem::file_size(index_path(username), ec);
+    return ec ? 0 : static_cast<size_t>(size / sizeof(IndexRecord));
+}
+
+vector<ReportVersionInfo> ReportArchive::versions(const string& username) const {
+    vector<ReportVersionInfo> result;
+    recover(username);
+    size_t count = version_count(username);
+    if (count == 0) return result;
+
+    ifstream index(index_path(username), ios::binary);
+    result.reserve(count);
+    IndexRecord record;
+    for (size_t i = 0; i < count && read_record(index, i, record); ++i) {
+        result.push_back(make_info(i + 1, record));
+    }
+    return result;
+}
+
+// Блоки только дописываются в конец файла данных и сбрасываются на диск раньше записи
+// индекса, которая на них ссылается, поэтому сбой на любом шаге не портит уже записанные
+// версии. Сжатая копия предыдущей версии дописывается после ее несжатого блока, и только
+// потом запись индекса переключается на нее. Блок последней версии индекса всегда
+// последний в файле: хвост после него (обрыв прошлой записи) отбрасывается.
+size_t ReportArchive::append(const string& username, const string& timestamp, string_view text) const {
+    error_code ec;
+    filesystem::create_directories(directory_, ec);
+    recover(username);
+
+    const string data_file = data_path(username);
+    const size_t count = version_count(username);
+
+    fstream index;
+    if (!open_for_update(index, index_path(username))) return 0;
+
+    IndexRecord last{};
+    uint64_t data_end = 0;
+    if (count > 0) {
+        if (!read_record(index, count - 1, last)) return 0;
+        data_end = last.offset + last.stored_size;
+    }
+
+    fstream data;
+    if (!open_for_update(data, data_file)) return 0;
+    data.close();
+    if (filesystem::file_size(data_file, ec) != data_end) {
+        filesystem::resize_file(data_file, data_end, ec);
+        if (ec) return 0;
+    }
+    data.open(data_file, ios::in | ios::out | ios::binary);
+
+    // Предыдущая версия уходит в архив - ее сжатая копия встает в конец файла
+    bool compressed_previous = false;
+    if (compress_archived_ && count > 0 && !(last.flags & VERSION_COMPRESSED)) {
+        string raw(last.stored_size, '\0');
+        data.seekg(static_cast<streamoff>(last.offset));
+        if (data.read(raw.data(), raw.size())) {
+            string packed;
+            compress_block(raw, packed);
+            if (packed.size() < raw.size()) {
+                data.seekp(static_cast<streamoff>(data_end));
+                if (!data.write(packed.data(), packed.size()) || !data.flush()) return 0;
+
+                last.offset = data_end;
+                last.stored_size = static_cast<uint32_t>(packed.size());
+                last.flags |= VERSION_COMPRESSED;
+                if (!write_record(index, count - 1, last) || !index.flush()) return 0;
+                data_end = last.offset + last.stored_size;
+                compressed_previous = true;
+            }
+        }
+        data.clear();
+    }
+
+    data.seekp(static_cast<streamoff>(data_end));
+    if (!data.write(text.data(), text.size()) || !data.flush()) return 0;
+
+    IndexRecord record{};
+    record.offset = data_end;
+    record.stored_size = static_cast<uint32_t>(text.size());
+    record.raw_size = static_cast<uint32_t>(text.size());
+    record.flags = 0;
+    record.checksum = text_checksum(text);
+    timestamp.copy(record.timestamp, sizeof(record.timestamp) - 1);
+
+    if (!write_record(index, count, record) || !index.flush()) return 0;
+
+    if (compressed_previous) {
+        uint64_t live = 0;
+        IndexRecord stored;
+        for (size_t i = 0; i <= count && read_record(index, i, stored); ++i) live += stored.stored_size;
+        uint64_t dead = data_end + text.size() - live;
+        if (dead > COMPACT_MIN_DEAD_BYTES && dead > live) {
+            data.close();
+            index.close();
+            compact(username);
+        }
+    }
+    return count + 1;
+}
+
+// Живые блоки копируются подряд в <данные>.tmp, индекс с новыми смещениями - в <индекс>.tmp.
+// Когда оба файла записаны целиком, создается метка <логин>.compact, и только после этого
+// временные файлы переименовываются поверх рабочих; прерванную замену завершает recover()
+bool ReportArchive::compact(const string& username) const {
+    const string data_file = data_path(username);
+    const string index_file = index_path(username);
+    const string data_temp = data_file + ".tmp";
+    const string index_temp = index_file + ".tmp";
+    const size_t count = version_count(username);
+
+    bool written = false;
+    {
+        MappedFile mapping;
+        ifstream index(index_file, ios::binary);
+        ofstream data_out(data_temp, ios::binary | ios::trunc);
+        ofstream index_out(index_temp, ios::binary | ios::trunc);
+        if (mapping.open(data_file) && index && data_out && index_out) {
+            string_view data = mapping.view();
+            uint64_t offset = 0;
+            IndexRecord record;
+            size_t copied = 0;
+            for (; copied < count && read_record(index, copied, record); ++copied) {
+                if (record.offset > data.size() || record.stored_size > data.size() - record.offset) break;
+                data_out.write(data.data() + record.offset, record.stored_size);
+                record.offset = offset;
+                offset += record.stored_size;
+                index_out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            }
+            data_out.close();
+            index_out.close();
+            written = copied == count && data_out && index_out;
+        }
+    }
+
+    error_code ec;
+    if (written) {
+        ofstream marker((filesystem::path(directory_) / (username + ".compact")).string(), ios::trunc);
+        written = marker.is_open();
+    }
+    if (!written) {
+        filesystem::remove(data_temp, ec);
+        filesystem::remove(index_temp, ec);
+        return false;
+    }
+    recover(username);
+    return true;
+}
+
+// Метка есть - оба временных файла уплотнения готовы, замену можно довести до конца.
+// Временные файлы без метки недописаны; они будут перезаписаны следующим уплотнением
+void ReportArchive::recover(const string& username) const {
+    const string marker = (filesystem::path(directory_) / (username + ".compact")).string();
+    error_code ec;
+    if (!filesystem::exists(marker, ec)) return;
+
+    const string data_file = data_path(username);
+    const string index_file = index_path(username);
+    if (filesystem::exists(data_file + ".tmp", ec)) filesystem::rename(data_file + ".tmp", data_file, ec);
+    if (!ec && filesystem::exists(index_file + ".tmp", ec)) filesystem::rename(index_file + ".tmp", index_file, ec);
+    if (!ec) filesystem::remove(marker, ec);
+}
+
+bool ReportArchive::open_version(const string& username, size_t number, MappedFile& mapping, string& buffer,
+    string_view& text, ReportVersionInfo* info) const {
+    if (number == 0) return false;
+    recover(username);
+
+    ifstream index(index_path(username), ios::binary);
+    IndexRecord record;
+    if (!index || !read_record(index, number - 1, record)) return false;
+
+    if (!mapping.open(data_path(username))) return false;
+    string_view data = mapping.view();
+    if (record.offset > data.size() || record.stored_size > data.size() - record.offset) return false;
+    string_view stored = data.substr(static_cast<size_t>(record.offset), record.stored_size);
+
+    if (record.flags & VERSION_COMPRESSED) {
+        if (!decompress_block(stored, record.raw_size, buffer)) return false;
+        text = buffer;
+    }
+    else {
+        text = stored;
+    }
+    if (text_checksum(text) != record.checksum) return false;
+
+    if (info) *info = make_info(number, record);
+    return true;
+}
+
+bool ReportArchive::read(const string& username, size_t number, string& text, ReportVersionInfo* info) const {
+    MappedFile mapping;
+    string buffer;
+    string_view view;
+    if (!open_version(username, number, mapping, buffer, view, info)) return false;
+
+    text.assign(view);
+    return true;
+}
+
+bool ReportArchive::read_latest(const string& username, string& text, ReportVersionInfo* info) const {
+    return read(username, version_count(username), text, info);
+}
+
+// --------------------------- Сжатие блока ---------------------------
+// Последовательность команд: байт-заголовок (старшие 4 бита - число литералов,
+// младшие - длина совпадения минус 4; значение 15 продолжается байтами по 255),
+// литералы, затем смещение совпадения (2 байта, младший первым). Последняя команда
+// содержит только литералы. Отчеты с рамками из '=' и выравниванием пробелами
+// сжимаются в несколько раз.
+
+static constexpr size_t MIN_MATCH = 4;
+static constexpr size_t MAX_OFFSET = 65535;
+static constexpr int HASH_BITS = 12;
+
+static uint32_t read32(const unsigned char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static void write_length(string& output, size_t length) {
+    while (length >= 255) {
+        output += static_cast<char>(255);
+        length -= 255;
+    }
+    output += static_cast<char>(length);
+}
+
+static void write_sequence(string& output, const unsigned char* literals, size_t literal_count,
+    size_t match_length, size_t offset) {
+    size_t match_code = match_length == 0 ? 0 : match_length - MIN_MATCH;
+    unsigned char token = static_cast<unsigned char>((min<size_t>(literal_count, 15) << 4) | min<size_t>(match_code, 15));
+    output += static_cast<char>(token);
+    if (literal_count >= 15) write_length(output, literal_count - 15);
+    output.append(reinterpret_cast<const char*>(literals), literal_count);
+
+    if (match_length == 0) return;
+    output += static_cast<char>(offset & 0xFF);
+    output += static_cast<char>(offset >> 8);
+    if (match_code >= 15) write_length(output, match_code - 15);
+}
+
+void ReportArchive::compress_block(string_view input, string& output) {
+    output.clear();
+    output.reserve(input.size() / 2 + 16);
+
+    const unsigned char* src = reinterpret_cast<const unsigned char*>(input.data());
+    const size_t n = input.size();
+    int32_t table[1 << HASH_BITS];
+    fill(begin(table), end(table), -1);
+
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + MIN_MATCH <= n) {
+        uint32_t hash = (read32(src + i) * 2654435761u) >> (32 - HASH_BITS);
+        int32_t candidate = table[hash];
+        table[hash] = static_cast<int32_t>(i);
+
+        if (candidate < 0 || i - candidate > MAX_OFFSET || read32(src + candidate) != read32(src + i)) {
+            ++i;
+            continue;
+        }
+
+        size_t length = MIN_MATCH;
+        while (i + length < n && src[candidate + length] == src[i + length]) ++length;
+
+        write_sequence(output, src + anchor, i - anchor, length, i - candidate);
+        i += length;
+        anchor = i;
+    }
+    write_sequence(output, src + anchor, n - anchor, 0, 0);
+}
+
+static bool read_length(const unsigned char*& ip, const unsigned char* end, size_t& length) {
+    unsigned char byte;
+    do {
+        if (ip == end) return false;
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool ReportArchive::decompress_block(string_view input, size_t raw_size, string& output) {
+    output.assign(raw_size, '\0');
+    const unsigned char* ip = reinterpret_cast<const unsigned char*>(input.data());
+    const unsigned char* end = ip + input.size();
+    size_t op = 0;
+
+    while (ip < end) {
+        unsigned char token = *ip++;
+
+        size_t literal_count = token >> 4;
+        if (literal_count == 15 && !read_length(ip, end, literal_count)) return false;
+        if (literal_count > static_cast<size_t>(end - ip) || literal_count > raw_size - op) return false;
+        memcpy(&output[op], ip, literal_count);
+        ip += literal_count;
+        op += literal_count;
+
+        if (ip == end) break;
+
+        if (end - ip < 2) return false;
+        size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        size_t match_length = token & 0x0F;
+        if (match_length == 15 && !read_length(ip, end, match_length)) return false;
+        match_length += MIN_MATCH;
+
+        if (offset == 0 || offset > op || match_length > raw_size - op) return false;
+        // Совпадение может перекрывать само себя (повтор символа), поэтому побайтно
+        for (size_t k = 0; k < match_length; ++k, ++op) {
+            output[op] = output[op - offset];
+        }
+    }
+    return op == raw_size;
+}
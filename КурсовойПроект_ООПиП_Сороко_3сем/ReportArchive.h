@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Utilities.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// --------------------------- Архив версий отчетов ---------------------------
+// Каждая сохраненная версия текстового отчета дописывается в архив сотрудника:
+//   <каталог>/<логин>.reports - блоки с текстами версий подряд;
+//   <каталог>/<логин>.index   - записи фиксированного размера (смещение, размеры, время),
+//                               по одной на версию.
+// Версия с номером n читается одним переходом к записи n индекса и к ее блоку, без
+// чтения остальных. Последняя версия хранится как есть; если включено сжатие,
+// предыдущая сжимается (LZ77 по блоку), когда ее сменяет новая: сжатый блок дописывается
+// в конец файла данных, а место несжатого освобождает уплотнение архива.
+// Архивы разных сотрудников не пересекаются, поэтому версии разных сотрудников
+// можно дописывать из разных потоков.
+struct ReportVersionInfo {
+    size_t number = 0;          // с 1
+    string timestamp;
+    uint32_t size = 0;          // размер текста
+    uint32_t stored_size = 0;   // размер в архиве
+    bool compressed = false;
+};
+
+class ReportArchive {
+public:
+    explicit ReportArchive(string directory = REPORT_ARCHIVE_DIR, bool compress_archived = true)
+        : directory_(move(directory)), compress_archived_(compress_archived) {}
+
+    const string& directory() const { return directory_; }
+    bool compress_archived() const { return compress_archived_; }
+
+    size_t version_count(const string& username) const;
+    vector<ReportVersionInfo> versions(const string& username) const;
+
+    // Дописать новую версию; возвращает ее номер (0 - ошибка записи)
+    size_t append(const string& username, const string& timestamp, string_view text) const;
+
+    // Текст версии number (с 1) без копирования: несжатая версия - срез отображенного
+    // в mapping файла данных, сжатая распаковывается в buffer. text действителен, пока
+    // живы mapping и buffer. false - нет такой версии или архив поврежден
+    bool open_version(const string& username, size_t number, MappedFile& mapping, string& buffer,
+        string_view& text, ReportVersionInfo* info = nullptr) const;
+
+    // То же с копией текста
+    bool read(const string& username, size_t number, string& text, ReportVersionInfo* info = nullptr) const;
+    bool read_latest(const string& username, string& text, ReportVersionInfo* info = nullptr) const;
+
+    string data_path(const string& username) const;
+    string index_path(const string& username) const;
+
+    // Сжатие блока (формат LZ77: литералы и ссылки назад до 64 КБ) и обратное преобразование
+    static void compress_block(string_view input, string& output);
+    static bool decompress_block(string_view input, size_t raw_size, string& output);
+
+private:
+    string directory_;
+    bool compress_archived_;
+
+    // Уплотнение: несжатых блоков, которые сменили сжатые копии, больше этого
+    // и больше, чем живых данных
+    static constexpr uint64_t COMPACT_MIN_DEAD_BYTES = 64 * 1024;
+
+    bool compact(const string& username) const;
+    void recover(const string& username) const;
+};
+
+namespace HRSystem {
+    using ::ReportVersionInfo;
+    using ::ReportArchive;
+}
@@ -0,0 +1,185 @@
+#include "ReportCatalog.h"
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+using namespace std;
+
+// --------------------------- Каталог файлов отчетов ---------------------------
+
+static const string_view REPORT_PREFIX = "HR_REPORT_";
+// "_ГГГГ-ММ-ДД_ЧЧ-ММ-СС"
+static const size_t REPORT_STAMP_LENGTH = 20;
+
+string_view ReportCatalog::extension_of(string_view filename) {
+    size_t dot = filename.rfind('.');
+    return dot == string_view::npos ? string_view() : filename.substr(dot);
+}
+
+// Логин может содержать '_', поэтому время отделяется с конца имени
+bool ReportCatalog::parse_report_filename(string_view filename, string& username, string& timestamp) {
+    if (filename.substr(0, REPORT_PREFIX.size()) != REPORT_PREFIX) return false;
+
+    string_view rest = filename.substr(REPORT_PREFIX.size());
+    rest.remove_suffix(extension_of(rest).size());
+    if (rest.size() <= REPORT_STAMP_LENGTH) return false;
+
+    string_view stamp = rest.substr(rest.size() - REPORT_STAMP_LENGTH);
+    static const char SHAPE[] = "_0000-00-00_00-00-00";
+    for (size_t i = 0; i < REPORT_STAMP_LENGTH; ++i) {
+        bool digit = stamp[i] >= '0' && stamp[i] <= '9';
+        if (SHAPE[i] == '0' ? !digit : stamp[i] != SHAPE[i]) return false;
+    }
+
+    username.assign(rest.substr(0, rest.size() - REPORT_STAMP_LENGTH));
+    timestamp.assign(stamp.substr(1));
+    timestamp[10] = ' ';
+    timestamp[13] = ':';
+    timestamp[16] = ':';
+    return true;
+}
+
+void ReportCatalog::load_from_file() {
+    by_user_.clear();
+    entry_count_ = 0;
+
+    error_code ec;
+    if (!filesystem::exists(journal_.path(), ec)) {
+        rebuild();
+        return;
+    }
+
+    journal_.replay([this](string_view record) {
+        string_view parts[3];
+        if (split_fields(record, '|', parts, 3) < 3) return;
+
+        string username(parts[1]);
+        string filename(parts[2]);
+        if (parts[0] == "+") insert_entry(username, filename);
+        else if (parts[0] == "-") erase_entry(username, filename);
+    });
+    compact_if_needed();
+}
+
+void ReportCatalog::rebuild() {
+    by_user_.clear();
+    entry_count_ = 0;
+
+    error_code ec;
+    for (filesystem::directory_iterator it(".", ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+
+        string filename = it->path().filename().string();
+        string username, timestamp;
+        if (parse_report_filename(filename, username, timestamp)) {
+            insert_entry(username, filename);
+        }
+    }
+    write_snapshot();
+}
+
+const ReportFileEntry* ReportCatalog::latest(const string& username, string_view extension) const {
+    auto it = by_user_.find(username);
+    if (it == by_user_.end()) return nullptr;
+
+    const auto& entries = it->second;
+    for (auto entry = entries.rbegin(); entry != entries.rend(); ++entry) {
+        if (extension_of(entry->filename) == extension) return &*entry;
+    }
+    return nullptr;
+}
+
+vector<string> ReportCatalog::files_of(const string& username, string_view extension) const {
+    vector<string> files;
+    auto it = by_user_.find(username);
+    if (it == by_user_.end()) return files;
+
+    for (const auto& entry : it->second) {
+        if (extension_of(entry.filename) == extension) files.push_back(entry.filename);
+    }
+    return files;
+}
+
+bool ReportCatalog::replace(const string& username, const string& filename) {
+    return replace_all({ { username, filename } });
+}
+
+bool ReportCatalog::replace_all(const vector<pair<string, string>>& saved) {
+    vector<string> records;
+    for (const auto& [username, filename] : saved) {
+        string_view extension = extension_of(filename);
+        for (const string& old_file : files_of(username, extension)) {
+            if (old_file != filename && erase_entry(username, old_file)) {
+                records.push_back("-|" + username + "|" + old_file);
+            }
+        }
+        if (insert_entry(username, filename)) {
+            records.push_back("+|" + username + "|" + filename);
+        }
+    }
+
+    bool ok = journal_.append_all(records);
+    compact_if_needed();
+    return ok;
+}
+
+void ReportCatalog::forget(const string& username, const string& filename) {
+    if (erase_entry(username, filename)) {
+        journal_.append("-|" + username + "|" + filename);
+        compact_if_needed();
+    }
+}
+
+// Записи одного сотрудника упорядочены по времени; новый отчет обычно встает в конец
+bool ReportCatalog::insert_entry(const string& username, const string& filename) {
+    string parsed_username, timestamp;
+    if (!parse_report_filename(filename, parsed_username, timestamp)) return false;
+
+    auto& entries = by_user_[username];
+    for (const auto& entry : entries) {
+        if (entry.filename == filename) return false;
+    }
+
+    auto position = upper_bound(entries.begin(), entries.end(), timestamp,
+        [](const string& value, const ReportFileEntry& entry) { return value < entry.timestamp; });
+    entries.insert(position, ReportFileEntry{ filename, move(timestamp) });
+    ++entry_count_;
+    return true;
+}
+
+bool ReportCatalog::erase_entry(const string& username, const string& filename) {
+    auto it = by_user_.find(username);
+    if (it == by_user_.end()) return false;
+
+    auto& entries = it->second;
+    auto entry = find_if(entries.begin(), entries.end(),
+        [&](const ReportFileEntry& e) { return e.filename == filename; });
+    if (entry == entries.end()) return false;
+
+    entries.erase(entry);
+    if (entries.empty()) by_user_.erase(it);
+    --entry_count_;
+    return true;
+}
+
+void ReportCatalog::write_snapshot() {
+    vector<string> records;
+    records.reserve(entry_count_);
+    for (const auto& [username, entries] : by_user_) {
+        for (const auto& entry : entries) {
+            records.push_back("+|" + username + "|" + entry.filename);
+        }
+    }
+
+    // Не truncate + append_all: сбой между ними оставил бы пустой, но существующий
+    // каталог, и восстановление по каталогу отчетов (rebuild) бы не запустилось
+    journal_.rewrite(records);
+}
+
+// Журнал переписывается, когда удаленных записей в нем больше, чем живых
+void ReportCatalog::compact_if_needed() {
+    size_t records = journal_.record_count();
+    if (records > JOURNAL_MIN_RECORDS && records > entry_count_ * 2) {
+        write_snapshot();
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Utilities.h"
+#include "Journal.h"
+
+using namespace std;
+
+// --------------------------- Каталог файлов отчетов ---------------------------
+// Логин -> файлы HR_REPORT_<логин>_<дата>_<время><расширение>, упорядоченные по времени.
+// Каталог хранится журналом записей "+|логин|файл" / "-|логин|файл"; если журнала нет,
+// он один раз восстанавливается обходом текущего каталога (std::filesystem).
+// Последний отчет ищется без обхода каталога и сравнения имен.
+struct ReportFileEntry {
+    string filename;
+    string timestamp;   // "ГГГГ-ММ-ДД ЧЧ:ММ:СС" из имени файла
+};
+
+class ReportCatalog {
+public:
+    explicit ReportCatalog(string catalog_path = REPORTS_CATALOG_FILE) : journal_(move(catalog_path)) {
+        load_from_file();
+    }
+
+    void load_from_file();
+    // Пересобрать каталог по файлам текущего каталога и переписать журнал
+    void rebuild();
+
+    // Последний отчет сотрудника с данным расширением (".txt", ...), nullptr - нет отчетов
+    const ReportFileEntry* latest(const string& username, string_view extension) const;
+    // Все отчеты сотрудника с данным расширением, от старых к новым
+    vector<string> files_of(const string& username, string_view extension) const;
+    size_t size() const { return entry_count_; }
+
+    // Новый отчет заменяет в каталоге прежние отчеты того же формата
+    // (сами файлы удаляет вызывающий). Для пакета - одна запись в журнал.
+    bool replace(const string& username, const string& filename);
+    bool replace_all(const vector<pair<string, string>>& saved);   // (логин, файл)
+
+    // Убрать запись о файле, которого больше нет на диске
+    void forget(const string& username, const string& filename);
+
+    // HR_REPORT_<логин>_ГГГГ-ММ-ДД_ЧЧ-ММ-СС<расширение> -> логин и время
+    static bool parse_report_filename(string_view filename, string& username, string& timestamp);
+    static string_view extension_of(string_view filename);
+
+private:
+    AppendJournal journal_;
+    StringMap<vector<ReportFileEntry>> by_user_;
+    size_t entry_count_ = 0;
+
+    static constexpr size_t JOURNAL_MIN_RECORDS = 64;
+
+    bool insert_entry(const string& username, const string& filename);
+    bool erase_entry(const string& username, const string& filename);
+    void write_snapshot();
+    void compact_if_needed();
+};
+
+namespace HRSystem {
+    using ::ReportFileEntry;
+    using ::ReportCatalog;
+}
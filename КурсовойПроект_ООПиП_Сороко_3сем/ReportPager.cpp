@@ -0,0 +1,108 @@
+#include "ReportPager.h"
+#include "Utilities.h"
+#include <algorithm>
+
+using namespace std;
+
+// --------------------------- Постраничный просмотр отчета ---------------------------
+
+ReportPager::ReportPager(string_view text, size_t page_lines)
+    : text_(text), page_lines_(page_lines == 0 ? DEFAULT_PAGE_LINES : page_lines) {
+    page_starts_.push_back(0);
+}
+
+size_t ReportPager::line_count() {
+    if (line_count_ == string_view::npos) {
+        line_count_ = static_cast<size_t>(count(text_.begin(), text_.end(), '\n'));
+        if (!text_.empty() && text_.back() != '\n') ++line_count_;
+    }
+    return line_count_;
+}
+
+size_t ReportPager::page_count() {
+    size_t lines = line_count();
+    return lines == 0 ? 1 : (lines + page_lines_ - 1) / page_lines_;
+}
+
+// Начала страниц дописываются по одной, отсчитывая page_lines_ строк от последней известной
+size_t ReportPager::page_start(size_t index) {
+    while (page_starts_.size() <= index) {
+        size_t position = page_starts_.back();
+        if (position >= text_.size()) return text_.size();
+
+        for (size_t k = 0; k < page_lines_ && position < text_.size(); ++k) {
+            size_t end = text_.find('\n', position);
+            position = end == string_view::npos ? text_.size() : end + 1;
+        }
+        page_starts_.push_back(position);
+    }
+    return page_starts_[index];
+}
+
+string_view ReportPager::page(size_t index) {
+    size_t start = page_start(index);
+    size_t end = page_start(index + 1);
+    return text_.substr(start, end - start);
+}
+
+size_t ReportPager::line_of_offset(size_t offset) {
+    // Последнее известное начало может быть концом текста, а не полной страницей
+    if (offset >= text_.size()) return line_count();
+
+    while (page_starts_.back() <= offset && page_starts_.back() < text_.size()) {
+        page_start(page_starts_.size());
+    }
+
+    auto next = upper_bound(page_starts_.begin(), page_starts_.end(), offset);
+    size_t page_index = static_cast<size_t>(next - page_starts_.begin()) - 1;
+    size_t start = page_starts_[page_index];
+    return page_index * page_lines_ +
+        static_cast<size_t>(count(text_.begin() + start, text_.begin() + offset, '\n'));
+}
+
+static bool is_rule(string_view line, char symbol) {
+    return line.size() >= 2 && line.find_first_not_of(symbol) == string_view::npos;
+}
+
+vector<ReportSection> ReportPager::sections() const {
+    vector<ReportSection> result;
+    string_view previous;
+    size_t line_number = 0;
+
+    string_view rest = text_;
+    while (!rest.empty()) {
+        size_t end = rest.find('\n');
+        string_view line = rest.substr(0, end);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        // Строка с заголовком таблицы тоже подчеркнута, но в ней есть внутренние '|'
+        if (line_number > 0 && is_rule(line, '-') && previous.size() >= 2 &&
+            previous.front() == '|' && previous.back() == '|' &&
+            previous.find('|', 1) == previous.size() - 1) {
+            result.push_back({ string(trim(previous.substr(1, previous.size() - 2))), line_number - 1 });
+        }
+
+        previous = line;
+        ++line_number;
+        if (end == string_view::npos) break;
+        rest.remove_prefix(end + 1);
+    }
+    return result;
+}
+
+size_t ReportPager::find(string_view needle, size_t from) const {
+    if (needle.empty() || from >= text_.size() || needle.size() > text_.size() - from) {
+        return string_view::npos;
+    }
+
+    const char first = fold_case_cp1251(needle[0]);
+    const size_t last = text_.size() - needle.size();
+    for (size_t i = from; i <= last; ++i) {
+        if (fold_case_cp1251(text_[i]) != first) continue;
+
+        size_t k = 1;
+        while (k < needle.size() && fold_case_cp1251(text_[i + k]) == fold_case_cp1251(needle[k])) ++k;
+        if (k == needle.size()) return i;
+    }
+    return string_view::npos;
+}
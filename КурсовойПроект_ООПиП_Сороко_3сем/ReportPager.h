@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// --------------------------- Постраничный просмотр отчета ---------------------------
+// Работает прямо по тексту отчета (обычно - отображенному в память файлу), ничего из
+// него не копируя. Начала страниц находятся по мере листания и запоминаются
+// (по одному смещению на страницу), поэтому переход назад и повторный показ страницы
+// не просматривают текст заново.
+struct ReportSection {
+    string title;
+    size_t line = 0;    // с 0
+};
+
+class ReportPager {
+public:
+    static constexpr size_t DEFAULT_PAGE_LINES = 40;
+
+    explicit ReportPager(string_view text, size_t page_lines = DEFAULT_PAGE_LINES);
+
+    size_t page_lines() const { return page_lines_; }
+    // Подсчет строк - один проход по тексту при первом вызове
+    size_t line_count();
+    size_t page_count();
+
+    // Текст страницы index (с 0) вместе с переводами строк; пусто за концом отчета
+    string_view page(size_t index);
+    size_t page_of_line(size_t line) const { return line / page_lines_; }
+
+    // Номер строки, содержащей смещение offset
+    size_t line_of_offset(size_t offset);
+
+    // Заголовки разделов: строка "|  ЗАГОЛОВОК  |", за которой идет линия из '-'
+    vector<ReportSection> sections() const;
+
+    // Поиск без учета регистра (ASCII и кириллица CP1251) начиная со смещения from;
+    // string_view::npos - не найдено
+    size_t find(string_view needle, size_t from) const;
+
+private:
+    string_view text_;
+    size_t page_lines_;
+    vector<size_t> page_starts_;    // известные начала страниц, page_starts_[0] == 0
+    size_t line_count_ = string_view::npos;
+
+    size_t page_start(size_t index);
+};
+
+namespace HRSystem {
+    using ::ReportSection;
+    using ::ReportPager;
+}
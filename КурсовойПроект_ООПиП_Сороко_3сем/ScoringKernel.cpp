@@ -0,0 +1,215 @@
+#include "ScoringKernel.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SCORING_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC и Clang генерируют AVX2 только в функциях, явно помеченных целевым набором;
+// MSVC разрешает интринсики в любой функции
+#if defined(__GNUC__)
+#define SCORING_TARGET_SSE2 __attribute__((target("sse2")))
+#define SCORING_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SCORING_TARGET_SSE2
+#define SCORING_TARGET_AVX2
+#endif
+
+using namespace std;
+
+// --------------------------- Определение набора инструкций ---------------------------
+
+#ifdef SCORING_X86
+static ScoringIsa detect_scoring_isa() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool avx2 = false;
+    // AVX2 пригоден, только если ОС сохраняет регистры YMM при переключении задач
+    if (osxsave && avx && max_leaf >= 7 && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    bool sse2 = __builtin_cpu_supports("sse2");
+    bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2) return ScoringIsa::AVX2;
+    if (sse2) return ScoringIsa::SSE2;
+    return ScoringIsa::SCALAR;
+}
+#endif
+
+ScoringIsa scoring_isa() {
+#ifdef SCORING_X86
+    static const ScoringIsa isa = detect_scoring_isa();
+    return isa;
+#else
+    return ScoringIsa::SCALAR;
+#endif
+}
+
+const char* scoring_isa_name(ScoringIsa isa) {
+    switch (isa) {
+    case ScoringIsa::SSE2: return "SSE2";
+    case ScoringIsa::AVX2: return "AVX2";
+    default: return "scalar";
+    }
+}
+
+// --------------------------- Скалярная ветка ---------------------------
+// Эталон: та же формула, что в SystemConfig::calculatePerformanceForDepartment,
+// плюс округление до сотых. Ею же досчитываются хвосты векторных веток.
+
+static void score_scalar(const double* department_weights, double teamwork_weight, double tasks_weight,
+    const unsigned char* department_ids,
+    const double* department_scores, const double* teamwork_scores, const double* tasks_scores,
+    double* final_scores, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        double score = (department_scores[i] * department_weights[department_ids[i]] / 100.0) +
+            (teamwork_scores[i] * teamwork_weight / 100.0) +
+            (tasks_scores[i] * tasks_weight / 100.0);
+        final_scores[i] = round(score * 100) / 100;
+    }
+}
+
+#ifdef SCORING_X86
+
+// --------------------------- SSE2 ---------------------------
+// В SSE2 нет roundpd: целая часть |y| < 2^52 получается прибавлением и вычитанием 2^52
+// (округление к ближайшему) с поправкой вниз; |y| - trunc(|y|) вычисляется точно,
+// поэтому сравнение с 0.5 дает то же, что std::round. Большие, бесконечные и NaN
+// значения уже целые или не округляются - для них остается y.
+
+SCORING_TARGET_SSE2
+static inline __m128d round_half_away_sse2(__m128d y) {
+    const __m128d sign_mask = _mm_set1_pd(-0.0);
+    const __m128d two52 = _mm_set1_pd(4503599627370496.0);
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d half = _mm_set1_pd(0.5);
+
+    __m128d sign = _mm_and_pd(y, sign_mask);
+    __m128d a = _mm_andnot_pd(sign_mask, y);
+    __m128d t = _mm_sub_pd(_mm_add_pd(a, two52), two52);
+    t = _mm_sub_pd(t, _mm_and_pd(_mm_cmpgt_pd(t, a), one));
+    t = _mm_add_pd(t, _mm_and_pd(_mm_cmpge_pd(_mm_sub_pd(a, t), half), one));
+    t = _mm_or_pd(t, sign);
+
+    __m128d small = _mm_cmplt_pd(a, two52);
+    return _mm_or_pd(_mm_and_pd(small, t), _mm_andnot_pd(small, y));
+}
+
+SCORING_TARGET_SSE2
+static void score_sse2(const double* department_weights, double teamwork_weight, double tasks_weight,
+    const unsigned char* department_ids,
+    const double* department_scores, const double* teamwork_scores, const double* tasks_scores,
+    double* final_scores, size_t count) {
+    const __m128d hundred = _mm_set1_pd(100.0);
+    const __m128d tw = _mm_set1_pd(teamwork_weight);
+    const __m128d kw = _mm_set1_pd(tasks_weight);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d w = _mm_set_pd(department_weights[department_ids[i + 1]], department_weights[department_ids[i]]);
+        __m128d d = _mm_div_pd(_mm_mul_pd(_mm_loadu_pd(department_scores + i), w), hundred);
+        __m128d t = _mm_div_pd(_mm_mul_pd(_mm_loadu_pd(teamwork_scores + i), tw), hundred);
+        __m128d k = _mm_div_pd(_mm_mul_pd(_mm_loadu_pd(tasks_scores + i), kw), hundred);
+        __m128d score = _mm_add_pd(_mm_add_pd(d, t), k);
+        __m128d rounded = round_half_away_sse2(_mm_mul_pd(score, hundred));
+        _mm_storeu_pd(final_scores + i, _mm_div_pd(rounded, hundred));
+    }
+    score_scalar(department_weights, teamwork_weight, tasks_weight, department_ids,
+        department_scores, teamwork_scores, tasks_scores, final_scores, i, count);
+}
+
+// --------------------------- AVX2 ---------------------------
+// Все SCORING_WEIGHT_COUNT весов помещаются в два регистра, поэтому вес строки
+// выбирается перестановкой внутри регистров (vpermd + blend): vgatherdpd на части
+// процессоров микрокодный и медленнее SSE2. Отсечение дробной части - roundpd к нулю,
+// для |y| >= 2^52 оно ничего не меняет.
+
+SCORING_TARGET_AVX2
+static inline __m256d round_half_away_avx2(__m256d y) {
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d half = _mm256_set1_pd(0.5);
+
+    __m256d sign = _mm256_and_pd(y, sign_mask);
+    __m256d a = _mm256_andnot_pd(sign_mask, y);
+    __m256d t = _mm256_round_pd(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    t = _mm256_add_pd(t, _mm256_and_pd(_mm256_cmp_pd(_mm256_sub_pd(a, t), half, _CMP_GE_OQ), one));
+    return _mm256_or_pd(t, sign);
+}
+
+SCORING_TARGET_AVX2
+static void score_avx2(const double* department_weights, double teamwork_weight, double tasks_weight,
+    const unsigned char* department_ids,
+    const double* department_scores, const double* teamwork_scores, const double* tasks_scores,
+    double* final_scores, size_t count) {
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d tw = _mm256_set1_pd(teamwork_weight);
+    const __m256d kw = _mm256_set1_pd(tasks_weight);
+    const __m256i weights_low = _mm256_castpd_si256(_mm256_loadu_pd(department_weights));
+    const __m256i weights_high = _mm256_castpd_si256(_mm256_loadu_pd(department_weights + 4));
+    const __m256i three = _mm256_set1_epi64x(3);
+    const __m256i one = _mm256_set1_epi64x(1);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int packed_ids;
+        memcpy(&packed_ids, department_ids + i, sizeof(packed_ids));
+        __m256i ids = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed_ids));
+        // Для веса с номером j внутри регистра нужны 32-битные половины 2j и 2j + 1
+        __m256i lane = _mm256_slli_epi64(_mm256_and_si256(ids, three), 1);
+        __m256i permutation = _mm256_or_si256(lane, _mm256_slli_epi64(_mm256_add_epi64(lane, one), 32));
+        __m256d w = _mm256_blendv_pd(
+            _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(weights_low, permutation)),
+            _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(weights_high, permutation)),
+            _mm256_castsi256_pd(_mm256_cmpgt_epi64(ids, three)));
+
+        __m256d d = _mm256_div_pd(_mm256_mul_pd(_mm256_loadu_pd(department_scores + i), w), hundred);
+        __m256d t = _mm256_div_pd(_mm256_mul_pd(_mm256_loadu_pd(teamwork_scores + i), tw), hundred);
+        __m256d k = _mm256_div_pd(_mm256_mul_pd(_mm256_loadu_pd(tasks_scores + i), kw), hundred);
+        __m256d score = _mm256_add_pd(_mm256_add_pd(d, t), k);
+        __m256d rounded = round_half_away_avx2(_mm256_mul_pd(score, hundred));
+        _mm256_storeu_pd(final_scores + i, _mm256_div_pd(rounded, hundred));
+    }
+    score_scalar(department_weights, teamwork_weight, tasks_weight, department_ids,
+        department_scores, teamwork_scores, tasks_scores, final_scores, i, count);
+}
+
+#endif
+
+// --------------------------- Диспетчер ---------------------------
+
+void score_bulk(const double* department_weights, double teamwork_weight, double tasks_weight,
+    const unsigned char* department_ids,
+    const double* department_scores, const double* teamwork_scores, const double* tasks_scores,
+    double* final_scores, size_t count, ScoringIsa isa) {
+#ifdef SCORING_X86
+    ScoringIsa available = scoring_isa();
+    if (isa == ScoringIsa::AVX2 && available == ScoringIsa::AVX2) {
+        score_avx2(department_weights, teamwork_weight, tasks_weight, department_ids,
+            department_scores, teamwork_scores, tasks_scores, final_scores, count);
+        return;
+    }
+    if (isa != ScoringIsa::SCALAR && available != ScoringIsa::SCALAR) {
+        score_sse2(department_weights, teamwork_weight, tasks_weight, department_ids,
+            department_scores, teamwork_scores, tasks_scores, final_scores, count);
+        return;
+    }
+#endif
+    score_scalar(department_weights, teamwork_weight, tasks_weight, department_ids,
+        department_scores, teamwork_scores, tasks_scores, final_scores, 0, count);
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+
+using namespace std;
+
+// --------------------------- Пакетный расчет оценок ---------------------------
+// Итоговая оценка по столбцам (structure of arrays):
+//   out[i] = round(((dept[i] * w[id[i]] / 100) + (team[i] * tw / 100) + (tasks[i] * kw / 100)) * 100) / 100
+// Порядок операций тот же, что в SystemConfig::calculatePerformanceForDepartment,
+// а округление до сотых - как std::round (половина от нуля), поэтому результат
+// векторных веток побитово совпадает со скалярным расчетом.
+
+// Набор инструкций, которым считает score_bulk
+enum class ScoringIsa { SCALAR, SSE2, AVX2 };
+
+// Лучший набор, поддерживаемый процессором (определяется один раз)
+ScoringIsa scoring_isa();
+const char* scoring_isa_name(ScoringIsa isa);
+
+// Число весов отделов, которое ожидает score_bulk (по числу DepartmentId)
+constexpr size_t SCORING_WEIGHT_COUNT = 8;
+
+// department_weights - SCORING_WEIGHT_COUNT весов специализированного параметра,
+// индексируемых кодом отдела (department_ids[i] < SCORING_WEIGHT_COUNT).
+// Если запрошенный набор не поддерживается процессором, используется лучший доступный.
+void score_bulk(const double* department_weights, double teamwork_weight, double tasks_weight,
+    const unsigned char* department_ids,
+    const double* department_scores, const double* teamwork_scores, const double* tasks_scores,
+    double* final_scores, size_t count, ScoringIsa isa = scoring_isa());
+
+namespace HRSystem {
+    using ::ScoringIsa;
+    using ::scoring_isa;
+    using ::score_bulk;
+}
@@ -0,0 +1,140 @@
+#include "Stats.h"
+#include "Utilities.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+// --------------------------- Счетчики горячих путей ---------------------------
+
+// Точки добавляются в голову списка и не удаляются (живут до конца программы)
+static atomic<StatSite*> g_sites{ nullptr };
+
+static mutex g_enabled_mutex;
+static string g_enabled_since;
+
+StatSite::StatSite(const char* site_name) : name(site_name) {
+    StatSite* head = g_sites.load(memory_order_relaxed);
+    do {
+        next = head;
+    } while (!g_sites.compare_exchange_weak(head, this, memory_order_release, memory_order_relaxed));
+}
+
+void StatSite::record(uint64_t ns) {
+    calls.fetch_add(1, memory_order_relaxed);
+    total_ns.fetch_add(ns, memory_order_relaxed);
+    uint64_t previous = max_ns.load(memory_order_relaxed);
+    while (previous < ns && !max_ns.compare_exchange_weak(previous, ns, memory_order_relaxed)) {
+    }
+}
+
+void set_stats_enabled(bool enabled) {
+    lock_guard<mutex> lock(g_enabled_mutex);
+    if (enabled && !stats_enabled()) g_enabled_since = now_string();
+    g_stats_enabled.store(enabled, memory_order_relaxed);
+}
+
+void reset_stats() {
+    for (StatSite* site = g_sites.load(memory_order_acquire); site; site = site->next) {
+        site->calls.store(0, memory_order_relaxed);
+        site->total_ns.store(0, memory_order_relaxed);
+        site->max_ns.store(0, memory_order_relaxed);
+        site->bytes.store(0, memory_order_relaxed);
+    }
+    lock_guard<mutex> lock(g_enabled_mutex);
+    if (stats_enabled()) g_enabled_since = now_string();
+}
+
+// --------------------------- Отчет ---------------------------
+
+namespace {
+
+struct SiteSnapshot {
+    const char* name;
+    uint64_t calls;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t bytes;
+};
+
+void append_padded(string& out, string_view text, size_t width, bool right) {
+    size_t padding = text.size() < width ? width - text.size() : 0;
+    if (right) out.append(padding, ' ');
+    out.append(text);
+    if (!right) out.append(padding, ' ');
+}
+
+void append_number(string& out, uint64_t value, size_t width) {
+    char buf[32];
+    auto [end, ec] = to_chars(buf, buf + sizeof(buf), value);
+    append_padded(out, string_view(buf, end - buf), width, true);
+}
+
+void append_number(string& out, double value, size_t width) {
+    char buf[64];
+    auto [end, ec] = to_chars(buf, buf + sizeof(buf), value, chars_format::fixed, 3);
+    append_padded(out, string_view(buf, ec == errc() ? end - buf : 0), width, true);
+}
+
+}
+
+string stats_report() {
+    vector<SiteSnapshot> sites;
+    size_t name_width = strlen("Точка");
+    for (StatSite* site = g_sites.load(memory_order_acquire); site; site = site->next) {
+        uint64_t calls = site->calls.load(memory_order_relaxed);
+        if (calls == 0) continue;
+        sites.push_back({ site->name, calls, site->total_ns.load(memory_order_relaxed),
+            site->max_ns.load(memory_order_relaxed), site->bytes.load(memory_order_relaxed) });
+        name_width = max(name_width, strlen(site->name));
+    }
+    sort(sites.begin(), sites.end(),
+        [](const SiteSnapshot& a, const SiteSnapshot& b) { return a.total_ns > b.total_ns; });
+
+    string out = "Статистика горячих путей на " + now_string();
+    {
+        lock_guard<mutex> lock(g_enabled_mutex);
+        if (stats_enabled()) out += " (сбор с " + g_enabled_since + ")";
+        else out += " (сбор выключен)";
+    }
+    out += "\n";
+
+    const size_t widths[] = { name_width + 2, 10, 14, 14, 14, 16 };
+    append_padded(out, "Точка", widths[0], false);
+    append_padded(out, "Вызовов", widths[1], true);
+    append_padded(out, "Всего, мс", widths[2], true);
+    append_padded(out, "Среднее, мкс", widths[3], true);
+    append_padded(out, "Макс., мкс", widths[4], true);
+    append_padded(out, "Записано, байт", widths[5], true);
+    out += "\n";
+    size_t total_width = 0;
+    for (size_t w : widths) total_width += w;
+    out.append(total_width, '-');
+    out += "\n";
+
+    for (const auto& site : sites) {
+        append_padded(out, site.name, widths[0], false);
+        append_number(out, site.calls, widths[1]);
+        append_number(out, site.total_ns / 1e6, widths[2]);
+        append_number(out, site.total_ns / 1e3 / site.calls, widths[3]);
+        append_number(out, site.max_ns / 1e3, widths[4]);
+        append_number(out, site.bytes, widths[5]);
+        out += "\n";
+    }
+    if (sites.empty()) out += "Вызовов не было\n";
+    return out;
+}
+
+bool write_stats_file(const string& path) {
+    string report = stats_report();
+    ofstream file(path, ios::trunc);
+    if (!file) return false;
+
+    file.write(report.data(), static_cast<streamsize>(report.size()));
+    file.close();
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+// --------------------------- Счетчики горячих путей ---------------------------
+// Точка замера - статический StatSite внутри функции (загрузка, сохранение, поиск,
+// сортировка, расчет оценок, отчеты); при первом вызове он добавляет себя в общий список.
+// ScopedStat в начале функции считает вызов, время до выхода из нее и записанные байты.
+// Пока сбор выключен (по умолчанию), ScopedStat только читает флаг - часы не опрашиваются.
+// Сборка с HR_NO_STATS убирает замеры из кода совсем.
+//
+//   void UserStore::save_to_file() {
+//       STAT_SCOPE(stat, "UserStore::save_to_file");
+//       ...
+//       stat.add_bytes(out.tellp());
+//   }
+
+struct StatSite {
+    const char* name;
+    atomic<uint64_t> calls{ 0 };
+    atomic<uint64_t> total_ns{ 0 };
+    atomic<uint64_t> max_ns{ 0 };
+    atomic<uint64_t> bytes{ 0 };
+    StatSite* next = nullptr;
+
+    explicit StatSite(const char* site_name);
+    void record(uint64_t ns);
+};
+
+inline atomic<bool> g_stats_enabled{ false };
+
+inline bool stats_enabled() {
+    return g_stats_enabled.load(memory_order_relaxed);
+}
+void set_stats_enabled(bool enabled);
+
+class ScopedStat {
+    StatSite* site_;
+    chrono::steady_clock::time_point start_;
+public:
+    explicit ScopedStat(StatSite& site) : site_(stats_enabled() ? &site : nullptr) {
+        if (site_) start_ = chrono::steady_clock::now();
+    }
+    ~ScopedStat() {
+        if (site_) {
+            site_->record(static_cast<uint64_t>(
+                chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start_).count()));
+        }
+    }
+    ScopedStat(const ScopedStat&) = delete;
+    ScopedStat& operator=(const ScopedStat&) = delete;
+
+    // Отрицательное значение (tellp() после ошибки записи) не учитывается
+    void add_bytes(long long count) {
+        if (site_ && count > 0) site_->bytes.fetch_add(static_cast<uint64_t>(count), memory_order_relaxed);
+    }
+};
+
+struct NullStat {
+    void add_bytes(long long) {}
+};
+
+#ifndef HR_NO_STATS
+#define HR_STAT_CONCAT_(a, b) a##b
+#define HR_STAT_CONCAT(a, b) HR_STAT_CONCAT_(a, b)
+#define STAT_SCOPE(var, name) \
+    static StatSite HR_STAT_CONCAT(stat_site_, __LINE__){ name }; \
+    ScopedStat var(HR_STAT_CONCAT(stat_site_, __LINE__))
+#else
+#define STAT_SCOPE(var, name) [[maybe_unused]] NullStat var
+#endif
+
+// Таблица по всем точкам, где были вызовы, по убыванию суммарного времени.
+// Числа форматируются без учета локали
+string stats_report();
+bool write_stats_file(const string& path);
+void reset_stats();
+
+namespace HRSystem {
+    using ::StatSite;
+    using ::ScopedStat;
+    using ::stats_enabled;
+    using ::set_stats_enabled;
+    using ::stats_report;
+    using ::write_stats_file;
+    using ::reset_stats;
+}
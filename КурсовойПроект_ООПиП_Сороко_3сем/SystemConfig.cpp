@@ -1,14 +1,24 @@
 #include "SystemConfig.h"
 #include "Utilities.h"
+#include "MappedFile.h"
+#include "ScoringKernel.h"
+#include "Stats.h"
+#include <filesystem>
 #include <iomanip>
+#include <sstream>
 
 using namespace std;
 
 SystemConfig::SystemConfig() {
     loadConfig();
+    refreshDepartmentWeights();
     loadPerformanceScores();
 }
 
+SystemConfig::~SystemConfig() {
+    waitForScoresCompaction();
+}
+
 double SystemConfig::getCodeQualityWeight() const {
     return codeQualityWeight;
 }
@@ -41,108 +51,133 @@ double SystemConfig::getQABugDetectionWeight() const {
     return qaBugDetectionWeight;
 }
 
-//     
-double SystemConfig::getDepartmentWeight(const string& department) const {
-    string dept = toLower(department);
+// Разбор строки отдела по ключевым словам
+DepartmentId SystemConfig::classifyDepartment(const string& department) {
+    string dept = folded_cp1251(department);
 
-    if (dept.find("") != string::npos || dept.find("dev") != string::npos) {
-        return codeQualityWeight;
+    if (dept.find("разработ") != string::npos || dept.find("dev") != string::npos) {
+        return DepartmentId::DEVELOPMENT;
     }
-    else if (dept.find("") != string::npos || dept.find("design") != string::npos) {
-        return designCreativityWeight;
+    else if (dept.find("дизайн") != string::npos || dept.find("design") != string::npos) {
+        return DepartmentId::DESIGN;
     }
-    else if (dept.find("") != string::npos || dept.find("marketing") != string::npos) {
-        return marketingROIWeight;
+    else if (dept.find("маркетинг") != string::npos || dept.find("marketing") != string::npos) {
+        return DepartmentId::MARKETING;
     }
-    else if (dept.find("") != string::npos || dept.find("sales") != string::npos) {
-        return salesConversionWeight;
+    else if (dept.find("продаж") != string::npos || dept.find("sales") != string::npos) {
+        return DepartmentId::SALES;
     }
-    else if (dept.find("") != string::npos || dept.find("support") != string::npos) {
-        return supportSatisfactionWeight;
+    else if (dept.find("поддержк") != string::npos || dept.find("support") != string::npos) {
+        return DepartmentId::SUPPORT;
     }
-    else if (dept.find("qa") != string::npos || dept.find("") != string::npos) {
-        return qaBugDetectionWeight;
+    else if (dept.find("qa") != string::npos || dept.find("тестиров") != string::npos) {
+        return DepartmentId::QA;
     }
     else if (dept == "hr") {
-        return getHRWeight(); //    HR
+        return DepartmentId::HR;
     }
     else {
-        return codeQualityWeight; //  
+        return DepartmentId::OTHER;
     }
 }
 
-//     
-string SystemConfig::getDepartmentParameterName(const string& department) const {
-    string dept = toLower(department);
-
-    if (dept.find("") != string::npos || dept.find("dev") != string::npos) {
-        return " ";
-    }
-    else if (dept.find("") != string::npos || dept.find("design") != string::npos) {
-        return "";
-    }
-    else if (dept.find("") != string::npos || dept.find("marketing") != string::npos) {
-        return "ROI ";
-    }
-    else if (dept.find("") != string::npos || dept.find("sales") != string::npos) {
-        return " ";
-    }
-    else if (dept.find("") != string::npos || dept.find("support") != string::npos) {
-        return " ";
-    }
-    else if (dept.find("qa") != string::npos || dept.find("") != string::npos) {
-        return " ";
-    }
-    else if (dept == "hr") {
-        return " ";
-    }
-    else {
-        return " ";
+// Различных строк отдела немного, поэтому каждая разбирается один раз
+DepartmentId SystemConfig::getDepartmentId(const string& department) const {
+    auto it = departmentIdCache.find(department);
+    if (it != departmentIdCache.end()) {
+        return it->second;
     }
+    DepartmentId id = classifyDepartment(department);
+    departmentIdCache.emplace(department, id);
+    return id;
+}
+
+void SystemConfig::refreshDepartmentWeights() {
+    departmentWeights[static_cast<size_t>(DepartmentId::DEVELOPMENT)] = codeQualityWeight;
+    departmentWeights[static_cast<size_t>(DepartmentId::DESIGN)] = designCreativityWeight;
+    departmentWeights[static_cast<size_t>(DepartmentId::MARKETING)] = marketingROIWeight;
+    departmentWeights[static_cast<size_t>(DepartmentId::SALES)] = salesConversionWeight;
+    departmentWeights[static_cast<size_t>(DepartmentId::SUPPORT)] = supportSatisfactionWeight;
+    departmentWeights[static_cast<size_t>(DepartmentId::QA)] = qaBugDetectionWeight;
+    departmentWeights[static_cast<size_t>(DepartmentId::HR)] = getHRWeight(); // Специальный вес для HR
+    departmentWeights[static_cast<size_t>(DepartmentId::OTHER)] = codeQualityWeight; // По умолчанию
+}
+
+// Получение специализированного веса для отдела
+double SystemConfig::getDepartmentWeight(const string& department) const {
+    return getDepartmentWeight(getDepartmentId(department));
+}
+
+// Получение названия параметра для отдела
+const string& SystemConfig::getDepartmentParameterName(DepartmentId id) const {
+    static const string names[DEPARTMENT_COUNT] = {
+        "Качество кода",
+        "Креативность",
+        "ROI кампаний",
+        "Конверсия продаж",
+        "Удовлетворенность клиентов",
+        "Обнаружение багов",
+        "Эффективность найма",
+        "Специализированный параметр",
+    };
+    return names[static_cast<size_t>(id)];
+}
+
+string SystemConfig::getDepartmentParameterName(const string& department) const {
+    return getDepartmentParameterName(getDepartmentId(department));
 }
 
 void SystemConfig::setCodeQualityWeight(double weight) {
     codeQualityWeight = weight;
+    refreshDepartmentWeights();
     saveConfig();
 }
 
 void SystemConfig::setTeamworkWeight(double weight) {
     teamworkWeight = weight;
+    refreshDepartmentWeights();
     saveConfig();
 }
 
 void SystemConfig::setTasksWeight(double weight) {
     tasksWeight = weight;
+    refreshDepartmentWeights();
     saveConfig();
 }
 
 void SystemConfig::setDesignCreativityWeight(double weight) {
     designCreativityWeight = weight;
+    refreshDepartmentWeights();
     saveConfig();
 }
 
 void SystemConfig::setMarketingROIWeight(double weight) {
     marketingROIWeight = weight;
+    refreshDepartmentWeights();
     saveConfig();
 }
 
 void SystemConfig::setSalesConversionWeight(double weight) {
     salesConversionWeight = weight;
+    refreshDepartmentWeights();
     saveConfig();
 }
 
 void SystemConfig::setSupportSatisfactionWeight(double weight) {
     supportSatisfactionWeight = weight;
+    refreshDepartmentWeights();
     saveConfig();
 }
 
 void SystemConfig::setQABugDetectionWeight(double weight) {
     qaBugDetectionWeight = weight;
+    refreshDepartmentWeights();
     saveConfig();
 }
 
-//  
+// Сохранение конфигурации
 void SystemConfig::saveConfig() const {
+    STAT_SCOPE(stat, "SystemConfig::saveConfig");
     ofstream fout("config.txt");
     if (fout) {
         fout << codeQualityWeight << "\n";
@@ -153,14 +188,17 @@ void SystemConfig::saveConfig() const {
         fout << salesConversionWeight << "\n";
         fout << supportSatisfactionWeight << "\n";
         fout << qaBugDetectionWeight << "\n";
+        fout << scoresCompactionFactor << "\n";
+        stat.add_bytes(fout.tellp());
     }
 }
 
-//  
+// Загрузка конфигурации
 bool SystemConfig::loadConfig() {
+    STAT_SCOPE(stat, "SystemConfig::loadConfig");
     ifstream fin("config.txt");
     if (!fin) {
-        //   ,     
+        // Если файла нет, создаем с значениями по умолчанию
         saveConfig();
         return false;
     }
@@ -169,7 +207,7 @@ bool SystemConfig::loadConfig() {
     fin >> teamworkWeight;
     fin >> tasksWeight;
 
-    //   ,   
+    // Загружаем дополнительные параметры, если они есть
     if (!fin.eof()) {
         fin >> designCreativityWeight;
     }
@@ -185,31 +223,38 @@ bool SystemConfig::loadConfig() {
     if (!fin.eof()) {
         fin >> qaBugDetectionWeight;
     }
+    // Порог уплотнения журнала оценок (в старых файлах его нет)
+    double factor;
+    if (fin >> factor && factor > 0) {
+        scoresCompactionFactor = factor;
+    }
 
     return true;
 }
 
-//   ( )
+// Меню настройки (для администратора)
 void SystemConfig::configMenu() {
     int choice;
     string input;
 
     do {
-        cout << "\n===    ===\n";
-        cout << "===   ===\n";
-        cout << "1.    \n";
-        cout << "2.     ( )\n";
-        cout << "3.     ( )\n";
-        cout << "\n===     ===\n";
-        cout << "4.     ()\n";
-        cout << "5.    ()\n";
-        cout << "6.   ROI  ()\n";
-        cout << "7.     ()\n";
-        cout << "8.     ()\n";
-        cout << "9.     (QA)\n";
-        cout << "\n10.  \n";
-        cout << "0.    \n";
-        cout << " : ";
+        cout << "\n=== Настройка параметров системы ===\n";
+        cout << "=== Общие параметры ===\n";
+        cout << "1. Показать все текущие параметры\n";
+        cout << "2. Изменить вес командной работы (для всех)\n";
+        cout << "3. Изменить вес выполненных задач (для всех)\n";
+        cout << "\n=== Специализированные параметры для отделов ===\n";
+        cout << "4. Изменить вес качества кода (Разработка)\n";
+        cout << "5. Изменить вес креативности (Дизайн)\n";
+        cout << "6. Изменить вес ROI кампаний (Маркетинг)\n";
+        cout << "7. Изменить вес конверсии продаж (Продажи)\n";
+        cout << "8. Изменить вес удовлетворенности клиентов (Поддержка)\n";
+        cout << "9. Изменить вес обнаружения багов (QA)\n";
+        cout << "\n=== Хранение оценок ===\n";
+        cout << "11. Изменить порог уплотнения журнала оценок\n";
+        cout << "\n10. Сохранить изменения\n";
+        cout << "0. Выход в главное меню\n";
+        cout << "Выберите пункт: ";
         getline(cin, input);
 
         try {
@@ -226,253 +271,442 @@ void SystemConfig::configMenu() {
 
         case 2: {
             double newWeight;
-            cout << "   : " << teamworkWeight << "\n";
-            cout << "  : ";
+            cout << "Текущий вес командной работы: " << teamworkWeight << "\n";
+            cout << "Введите новый вес: ";
             getline(cin, input);
             try {
                 newWeight = stod(input);
                 teamworkWeight = newWeight;
-                cout << "    : " << teamworkWeight << "\n";
+                cout << "Вес командной работы изменен на: " << teamworkWeight << "\n";
             }
             catch (...) {
-                cout << ":   \n";
+                cout << "Ошибка: введите корректное число\n";
             }
             break;
         }
 
         case 3: {
             double newWeight;
-            cout << "   : " << tasksWeight << "\n";
-            cout << "  : ";
+            cout << "Текущий вес выполненных задач: " << tasksWeight << "\n";
+            cout << "Введите новый вес: ";
             getline(cin, input);
             try {
                 newWeight = stod(input);
                 tasksWeight = newWeight;
-                cout << "    : " << tasksWeight << "\n";
+                cout << "Вес выполненных задач изменен на: " << tasksWeight << "\n";
             }
             catch (...) {
-                cout << ":   \n";
+                cout << "Ошибка: введите корректное число\n";
             }
             break;
         }
 
         case 4: {
             double newWeight;
-            cout << "    ( ): " << codeQualityWeight << "\n";
-            cout << "  : ";
+            cout << "Текущий вес качества кода (для разработки): " << codeQualityWeight << "\n";
+            cout << "Введите новый вес: ";
             getline(cin, input);
             try {
                 newWeight = stod(input);
                 codeQualityWeight = newWeight;
-                cout << "    : " << codeQualityWeight << "\n";
+                cout << "Вес качества кода изменен на: " << codeQualityWeight << "\n";
             }
             catch (...) {
-                cout << ":   \n";
+                cout << "Ошибка: введите корректное число\n";
             }
             break;
         }
 
         case 5: {
             double newWeight;
-            cout << "   ( ): " << designCreativityWeight << "\n";
-            cout << "  : ";
+            cout << "Текущий вес креативности (для дизайна): " << designCreativityWeight << "\n";
+            cout << "Введите новый вес: ";
             getline(cin, input);
             try {
                 newWeight = stod(input);
                 designCreativityWeight = newWeight;
-                cout << "   : " << designCreativityWeight << "\n";
+                cout << "Вес креативности изменен на: " << designCreativityWeight << "\n";
             }
             catch (...) {
-                cout << ":   \n";
+                cout << "Ошибка: введите корректное число\n";
             }
             break;
         }
 
         case 6: {
             double newWeight;
-            cout << "  ROI  ( ): " << marketingROIWeight << "\n";
-            cout << "  : ";
+            cout << "Текущий вес ROI кампаний (для маркетинга): " << marketingROIWeight << "\n";
+            cout << "Введите новый вес: ";
             getline(cin, input);
             try {
                 newWeight = stod(input);
                 marketingROIWeight = newWeight;
-                cout << " ROI   : " << marketingROIWeight << "\n";
+                cout << "Вес ROI кампаний изменен на: " << marketingROIWeight << "\n";
             }
             catch (...) {
-                cout << ":   \n";
+                cout << "Ошибка: введите корректное число\n";
             }
             break;
         }
 
         case 7: {
             double newWeight;
-            cout << "    ( ): " << salesConversionWeight << "\n";
-            cout << "  : ";
+            cout << "Текущий вес конверсии продаж (для продаж): " << salesConversionWeight << "\n";
+            cout << "Введите новый вес: ";
             getline(cin, input);
             try {
                 newWeight = stod(input);
                 salesConversionWeight = newWeight;
-                cout << "    : " << salesConversionWeight << "\n";
+                cout << "Вес конверсии продаж изменен на: " << salesConversionWeight << "\n";
             }
             catch (...) {
-                cout << ":   \n";
+                cout << "Ошибка: введите корректное число\n";
             }
             break;
         }
 
         case 8: {
             double newWeight;
-            cout << "    ( ): " << supportSatisfactionWeight << "\n";
-            cout << "  : ";
+            cout << "Текущий вес удовлетворенности клиентов (для поддержки): " << supportSatisfactionWeight << "\n";
+            cout << "Введите новый вес: ";
             getline(cin, input);
             try {
                 newWeight = stod(input);
                 supportSatisfactionWeight = newWeight;
-                cout << "    : " << supportSatisfactionWeight << "\n";
+                cout << "Вес удовлетворенности клиентов изменен на: " << supportSatisfactionWeight << "\n";
             }
             catch (...) {
-                cout << ":   \n";
+                cout << "Ошибка: введите корректное число\n";
             }
             break;
         }
 
         case 9: {
             double newWeight;
-            cout << "    ( QA): " << qaBugDetectionWeight << "\n";
-            cout << "  : ";
+            cout << "Текущий вес обнаружения багов (для QA): " << qaBugDetectionWeight << "\n";
+            cout << "Введите новый вес: ";
             getline(cin, input);
             try {
                 newWeight = stod(input);
                 qaBugDetectionWeight = newWeight;
-                cout << "    : " << qaBugDetectionWeight << "\n";
+                cout << "Вес обнаружения багов изменен на: " << qaBugDetectionWeight << "\n";
             }
             catch (...) {
-                cout << ":   \n";
+                cout << "Ошибка: введите корректное число\n";
             }
             break;
         }
 
         case 10:
             saveConfig();
-            cout << " !\n";
+            cout << "Настройки сохранены!\n";
+            break;
+
+        case 11: {
+            double newFactor;
+            cout << "Журнал оценок уплотняется, когда в нем записей больше, чем\n"
+                << "порог * число оценок. Текущий порог: " << scoresCompactionFactor << "\n";
+            cout << "Введите новый порог: ";
+            getline(cin, input);
+            if (parse_decimal(trim(string_view(input)), newFactor) && newFactor > 0) {
+                scoresCompactionFactor = newFactor;
+                cout << "Порог уплотнения изменен на: " << scoresCompactionFactor << "\n";
+            }
+            else {
+                cout << "Ошибка: введите положительное число\n";
+            }
             break;
+        }
 
         case 0:
-            cout << "  ...\n";
+            cout << "Выход из настроек...\n";
             break;
 
         default:
-            cout << " .  .\n";
+            cout << "Неверный выбор. Попробуйте снова.\n";
         }
+        refreshDepartmentWeights();
 
     } while (choice != 0);
 }
 
-//   
+// Показать все параметры
 void SystemConfig::showAllParameters() const {
-    cout << "\n===    ===\n";
-    cout << "\n  (  ):\n";
-    cout << "  : " << teamworkWeight << "\n";
-    cout << "  : " << tasksWeight << "\n";
-
-    cout << "\n   :\n";
-    cout << "   (): " << codeQualityWeight << "\n";
-    cout << "  (): " << designCreativityWeight << "\n";
-    cout << " ROI  (): " << marketingROIWeight << "\n";
-    cout << "   (): " << salesConversionWeight << "\n";
-    cout << "   (): " << supportSatisfactionWeight << "\n";
-    cout << "   (QA): " << qaBugDetectionWeight << "\n";
+    cout << "\n=== Текущие параметры системы ===\n";
+    cout << "\nОбщие параметры (для всех отделов):\n";
+    cout << "Вес командной работы: " << teamworkWeight << "\n";
+    cout << "Вес выполненных задач: " << tasksWeight << "\n";
+
+    cout << "\nСпециализированные параметры по отделам:\n";
+    cout << "Вес качества кода (Разработка): " << codeQualityWeight << "\n";
+    cout << "Вес креативности (Дизайн): " << designCreativityWeight << "\n";
+    cout << "Вес ROI кампаний (Маркетинг): " << marketingROIWeight << "\n";
+    cout << "Вес конверсии продаж (Продажи): " << salesConversionWeight << "\n";
+    cout << "Вес удовлетворенности клиентов (Поддержка): " << supportSatisfactionWeight << "\n";
+    cout << "Вес обнаружения багов (QA): " << qaBugDetectionWeight << "\n";
 
     double total = teamworkWeight + tasksWeight;
-    cout << "\n  (  100%   ):\n";
-    cout << ": " << (codeQualityWeight + total) << "%\n";
-    cout << ": " << (designCreativityWeight + total) << "%\n";
-    cout << ": " << (marketingROIWeight + total) << "%\n";
-    cout << ": " << (salesConversionWeight + total) << "%\n";
-    cout << ": " << (supportSatisfactionWeight + total) << "%\n";
+    cout << "\nОбщий вес (должен быть 100% для каждого отдела):\n";
+    cout << "Разработка: " << (codeQualityWeight + total) << "%\n";
+    cout << "Дизайн: " << (designCreativityWeight + total) << "%\n";
+    cout << "Маркетинг: " << (marketingROIWeight + total) << "%\n";
+    cout << "Продажи: " << (salesConversionWeight + total) << "%\n";
+    cout << "Поддержка: " << (supportSatisfactionWeight + total) << "%\n";
     cout << "QA: " << (qaBugDetectionWeight + total) << "%\n";
+
+    cout << "\nПорог уплотнения журнала оценок: " << scoresCompactionFactor << "\n";
 }
 
-//      
+// Проверка корректности весов для конкретного отдела
 bool SystemConfig::validateDepartmentWeights(const string& department) const {
-    double deptWeight = getDepartmentWeight(department);
+    return validateDepartmentWeights(getDepartmentId(department));
+}
+
+bool SystemConfig::validateDepartmentWeights(DepartmentId id) const {
+    double deptWeight = getDepartmentWeight(id);
     return (deptWeight + teamworkWeight + tasksWeight) == 100.0;
 }
 
-//     
+// Расчет эффективности с учетом отдела
 double SystemConfig::calculatePerformanceForDepartment(const string& department,
     double departmentScore,
     double teamworkScore,
     double tasksScore) const {
-    double deptWeight = getDepartmentWeight(department);
+    STAT_SCOPE(stat, "SystemConfig::calculatePerformanceForDepartment");
+    return calculatePerformanceForDepartment(getDepartmentId(department),
+        departmentScore, teamworkScore, tasksScore);
+}
+
+double SystemConfig::calculatePerformanceForDepartment(DepartmentId id,
+    double departmentScore,
+    double teamworkScore,
+    double tasksScore) const {
+    double deptWeight = getDepartmentWeight(id);
 
     return (departmentScore * deptWeight / 100.0) +
         (teamworkScore * teamworkWeight / 100.0) +
         (tasksScore * tasksWeight / 100.0);
 }
 
-//       
-string SystemConfig::toLower(const string& str) const {
-    string result = str;
-    transform(result.begin(), result.end(), result.begin(),
-        [](unsigned char c) { return tolower(c); });
-    return result;
+// Пакетный расчет: веса берутся из departmentWeights, коды отделов - байты DepartmentId
+static_assert(DEPARTMENT_COUNT == SCORING_WEIGHT_COUNT, "ядро оценок рассчитано на все отделы");
+static_assert(sizeof(DepartmentId) == 1, "коды отделов передаются в ядро как байты");
+
+void SystemConfig::calculatePerformanceBulk(const DepartmentId* departmentIds,
+    const double* departmentScores,
+    const double* teamworkScores,
+    const double* tasksScores,
+    double* finalScores,
+    size_t count) const {
+    STAT_SCOPE(stat, "SystemConfig::calculatePerformanceBulk");
+    score_bulk(departmentWeights.data(), teamworkWeight, tasksWeight,
+        reinterpret_cast<const unsigned char*>(departmentIds),
+        departmentScores, teamworkScores, tasksScores, finalScores, count);
+}
+
+void SystemConfig::calculatePerformanceBulk(ScoreTable& table) const {
+    table.final_scores.resize(table.size());
+    calculatePerformanceBulk(table.department_ids.data(),
+        table.department_scores.data(),
+        table.teamwork_scores.data(),
+        table.tasks_scores.data(),
+        table.final_scores.data(),
+        table.size());
 }
 
-//    HR (    )
+// Специальный вес для HR (рассчитывается на основе других параметров)
 double SystemConfig::getHRWeight() const {
-    //  HR      
+    // Для HR используем среднее из всех специализированных параметров
     return (codeQualityWeight + designCreativityWeight + marketingROIWeight +
         salesConversionWeight + supportSatisfactionWeight + qaBugDetectionWeight) / 6.0;
 }
 
-//   
+// --------------------------- Хранение оценок ---------------------------
+
+// Запись журнала "логин|оценка|время"; время справочное, порядок задает сам журнал
+static string formatScoreRecord(const string& username, double score) {
+    ostringstream record;
+    record << username << "|" << fixed << setprecision(2) << score << "|" << now_string();
+    return record.str();
+}
+
+// Базовый файл в формате "логин|оценка"
+static bool writeScoresFile(const string& path, const map<string, double>& scores) {
+    STAT_SCOPE(stat, "SystemConfig::writeScoresFile");
+    ofstream fout(path, ios::trunc);
+    if (!fout) return false;
+    for (const auto& [username, score] : scores) {
+        fout << username << "|" << fixed << setprecision(2) << score << "\n";
+    }
+    stat.add_bytes(fout.tellp());
+    fout.close();
+    return static_cast<bool>(fout);
+}
+
+// Замена базового файла: снимок пишется в .tmp и переименовывается поверх, так что
+// при сбое на диске остается либо прежний файл, либо новый целиком
+static bool replaceScoresFile(const map<string, double>& scores) {
+    const string tempPath = PERFORMANCE_SCORES_FILE + ".tmp";
+    error_code ec;
+    if (!writeScoresFile(tempPath, scores)) {
+        filesystem::remove(tempPath, ec);
+        return false;
+    }
+    filesystem::rename(tempPath, PERFORMANCE_SCORES_FILE, ec);
+    if (ec) {
+        filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool SystemConfig::applyScoreRecord(string_view record) {
+    string_view fields[3];
+    if (split_fields(record, '|', fields, 3) < 2) return false;
+
+    // Оценки сохраняются в русской локали ("53,00"), parse_decimal принимает и точку
+    double score;
+    if (!parse_decimal(fields[1], score)) return false;
+    performance_scores_[string(fields[0])] = score;
+    return true;
+}
+
+// Загрузка сохраненных оценок: базовый файл, затем журналы по порядку (побеждает последняя запись)
 void SystemConfig::loadPerformanceScores() {
-    ifstream fin("performance_scores.txt");
-    if (!fin) return;
-
-    string line;
-    while (getline(fin, line)) {
-        auto parts = split(line, '|');
-        if (parts.size() >= 2) {
-            string username = trim(parts[0]);
-            try {
-                double score = stod(trim(parts[1]));
-                performance_scores_[username] = score;
-            }
-            catch (...) {
-                //   
-            }
-        }
+    STAT_SCOPE(stat, "SystemConfig::loadPerformanceScores");
+    waitForScoresCompaction();
+    performance_scores_.clear();
+
+    MappedFile file;
+    if (file.open(PERFORMANCE_SCORES_FILE)) {
+        // Некорректные строки пропускаем
+        file.for_each_line([this](string_view line) { applyScoreRecord(line); });
+        file.close();
+    }
+
+    // Журнал, отложенный прерванным уплотнением, старше текущего
+    AppendJournal rotated(PERFORMANCE_SCORES_JOURNAL_FILE + ".old");
+    rotated.replay([this](string_view record) { applyScoreRecord(record); });
+    scoresJournal.replay([this](string_view record) { applyScoreRecord(record); });
+
+    if (rotated.record_count() > 0 || scoresJournalTooLong()) {
+        compactPerformanceScores();
     }
 }
 
-//  
-void SystemConfig::savePerformanceScores() const {
-    ofstream fout("performance_scores.txt");
-    if (fout) {
-        for (const auto& [username, score] : performance_scores_) {
-            fout << username << "|" << fixed << setprecision(2) << score << "\n";
+bool SystemConfig::scoresJournalTooLong() const {
+    size_t records = scoresJournal.record_count();
+    return records > SCORES_JOURNAL_MIN_RECORDS &&
+        records > performance_scores_.size() * scoresCompactionFactor;
+}
+
+// Сохранение оценок (полная перезапись, журнал после нее не нужен). Журналы очищаются
+// только после того, как новый базовый файл встал на место
+void SystemConfig::savePerformanceScores() {
+    STAT_SCOPE(stat, "SystemConfig::savePerformanceScores");
+    waitForScoresCompaction();
+    if (!replaceScoresFile(performance_scores_)) {
+        cerr << "Ошибка: не удалось записать файл оценок: " << PERFORMANCE_SCORES_FILE << "\n";
+        return;
+    }
+    scoresJournal.truncate();
+    error_code ec;
+    filesystem::remove(PERFORMANCE_SCORES_JOURNAL_FILE + ".old", ec);
+}
+
+// Журнал переименовывается в .old, новые записи идут в пустой журнал, а снимок оценок
+// пишется в фоне. Если процесс прервется до конца записи, при загрузке .old
+// будет применен поверх старого базового файла.
+void SystemConfig::compactPerformanceScores() {
+    STAT_SCOPE(stat, "SystemConfig::compactPerformanceScores");
+    waitForScoresCompaction();
+
+    const string rotatedPath = PERFORMANCE_SCORES_JOURNAL_FILE + ".old";
+    error_code ec;
+    if (filesystem::exists(rotatedPath, ec) || ec) {
+        savePerformanceScores();
+        return;
+    }
+    filesystem::rename(PERFORMANCE_SCORES_JOURNAL_FILE, rotatedPath, ec);
+    if (ec) {
+        savePerformanceScores();
+        return;
+    }
+    scoresJournal.truncate();
+
+    scoresCompaction = thread([snapshot = performance_scores_, rotatedPath]() {
+        if (replaceScoresFile(snapshot)) {
+            error_code ec;
+            filesystem::remove(rotatedPath, ec);
         }
+        // При ошибке .old остается и будет применен при следующей загрузке
+    });
+}
+
+void SystemConfig::waitForScoresCompaction() {
+    if (scoresCompaction.joinable()) {
+        scoresCompaction.join();
     }
 }
 
-//     
+double SystemConfig::getScoresCompactionFactor() const {
+    return scoresCompactionFactor;
+}
+
+void SystemConfig::setScoresCompactionFactor(double factor) {
+    if (factor <= 0) return;
+    scoresCompactionFactor = factor;
+    saveConfig();
+}
+
+// Сохранение оценки для конкретного пользователя: одна запись в журнал
 void SystemConfig::savePerformanceScore(const string& username, double score) {
+    STAT_SCOPE(stat, "SystemConfig::savePerformanceScore");
     performance_scores_[username] = score;
-    savePerformanceScores();
+    if (!scoresJournal.append(formatScoreRecord(username, score))) {
+        savePerformanceScores();
+    }
+    else if (scoresJournalTooLong()) {
+        compactPerformanceScores();
+    }
+    if (scoreListener) scoreListener(username, score);
+}
+
+// Пакетное сохранение: все записи дописываются в журнал за одно открытие файла
+void SystemConfig::setPerformanceScores(const vector<pair<string, double>>& scores) {
+    STAT_SCOPE(stat, "SystemConfig::setPerformanceScores");
+    vector<string> records;
+    records.reserve(scores.size());
+    for (const auto& [username, score] : scores) {
+        performance_scores_[username] = score;
+        records.push_back(formatScoreRecord(username, score));
+    }
+    if (!scoresJournal.append_all(records)) {
+        savePerformanceScores();
+    }
+    else if (scoresJournalTooLong()) {
+        compactPerformanceScores();
+    }
+    if (scoreListener) {
+        for (const auto& [username, score] : scores) scoreListener(username, score);
+    }
+}
+
+void SystemConfig::setScoreListener(function<void(const string& username, double score)> listener) {
+    scoreListener = move(listener);
 }
 
-//   
+// Получение оценки пользователя
 double SystemConfig::getPerformanceScore(const string& username) const {
+    STAT_SCOPE(stat, "SystemConfig::getPerformanceScore");
     auto it = performance_scores_.find(username);
     if (it != performance_scores_.end()) {
         return it->second;
     }
-    return -1.0; // -1 ,    
+    return -1.0; // -1 означает, что оценка не найдена
 }
 
-//   
+// Проверка наличия оценки
 bool SystemConfig::hasPerformanceScore(const string& username) const {
     return performance_scores_.find(username) != performance_scores_.end();
 }
\ No newline at end of file
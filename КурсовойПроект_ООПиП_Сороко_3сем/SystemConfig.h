@@ -3,47 +3,114 @@
 #include <fstream>
 #include <string>
 #include <map>
+#include <array>
 #include <algorithm>
 #include <cctype>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "Utilities.h"
+#include "Journal.h"
 
 using namespace std;
 
+// Отдел сотрудника, определенный по строке department (см. SystemConfig::getDepartmentId)
+enum class DepartmentId : unsigned char {
+    DEVELOPMENT, DESIGN, MARKETING, SALES, SUPPORT, QA, HR, OTHER
+};
+constexpr size_t DEPARTMENT_COUNT = 8;
+
+// Исходные данные для пакетного расчета оценок, по столбцам (structure of arrays):
+// строка i - отдел и три оценки одного сотрудника; final_scores заполняет
+// SystemConfig::calculatePerformanceBulk
+struct ScoreTable {
+    vector<DepartmentId> department_ids;
+    vector<double> department_scores;
+    vector<double> teamwork_scores;
+    vector<double> tasks_scores;
+    vector<double> final_scores;
+
+    void reserve(size_t n) {
+        department_ids.reserve(n);
+        department_scores.reserve(n);
+        teamwork_scores.reserve(n);
+        tasks_scores.reserve(n);
+    }
+    void add(DepartmentId id, double departmentScore, double teamworkScore, double tasksScore) {
+        department_ids.push_back(id);
+        department_scores.push_back(departmentScore);
+        teamwork_scores.push_back(teamworkScore);
+        tasks_scores.push_back(tasksScore);
+    }
+    size_t size() const { return department_ids.size(); }
+};
+
 class SystemConfig {
 private:
-    double codeQualityWeight = 30.0;           //   
-    double teamworkWeight = 30.0;              //    ()
-    double tasksWeight = 40.0;                 //    ()
-
-    //     
-    double designCreativityWeight = 30.0;      //    
-    double marketingROIWeight = 30.0;          //  ROI  
-    double salesConversionWeight = 30.0;       //    
-    double supportSatisfactionWeight = 30.0;   //    
-    double qaBugDetectionWeight = 30.0;        //     QA
+    double codeQualityWeight = 30.0;           // Вес для разработчиков
+    double teamworkWeight = 30.0;              // Вес командной работы (общий)
+    double tasksWeight = 40.0;                 // Вес выполненных задач (общий)
+
+    // Дополнительные параметры для разных отделов
+    double designCreativityWeight = 30.0;      // Вес креативности для дизайнеров
+    double marketingROIWeight = 30.0;          // Вес ROI для маркетологов
+    double salesConversionWeight = 30.0;       // Вес конверсии для продавцов
+    double supportSatisfactionWeight = 30.0;   // Вес удовлетворенности для поддержки
+    double qaBugDetectionWeight = 30.0;        // Вес обнаружения багов для QA
     map<string, double> performance_scores_;
+    function<void(const string&, double)> scoreListener;
+
+    // Журнал оценок: каждое изменение дописывается записью "логин|оценка|время",
+    // при загрузке побеждает последняя запись. performance_scores.txt переписывается
+    // только при уплотнении - в фоновом потоке, когда записей в журнале больше,
+    // чем scoresCompactionFactor * число оценок
+    AppendJournal scoresJournal{ PERFORMANCE_SCORES_JOURNAL_FILE };
+    double scoresCompactionFactor = 2.0;
+    static constexpr size_t SCORES_JOURNAL_MIN_RECORDS = 64;
+    thread scoresCompaction;
+
+    // Веса специализированного параметра, индексируемые DepartmentId
+    // (пересчитываются при любом изменении весов)
+    array<double, DEPARTMENT_COUNT> departmentWeights{};
+    // Кэш классификации: строка отдела -> DepartmentId.
+    // Меняется из const-метода getDepartmentId без блокировки: строки отделов
+    // переводятся в DepartmentId только в основном потоке, до передачи работы в
+    // ThreadPool (ScoreTable хранит готовые id, ReportModel - уже найденное название
+    // параметра). Задачам пула нельзя вызывать getDepartmentId(string) и перегрузки,
+    // принимающие строку отдела
+    mutable StringMap<DepartmentId> departmentIdCache;
 
 public:
     SystemConfig();
+    ~SystemConfig();
 
-    //    
+    // Геттеры для общих параметров
     double getCodeQualityWeight() const;
     double getTeamworkWeight() const;
     double getTasksWeight() const;
 
-    //    
+    // Геттеры для специализированных параметров
     double getDesignCreativityWeight() const;
     double getMarketingROIWeight() const;
     double getSalesConversionWeight() const;
     double getSupportSatisfactionWeight() const;
     double getQABugDetectionWeight() const;
 
-    //     
+    // Отдел по строке department; строка разбирается один раз, дальше берется из кэша.
+    // Только из основного потока (см. departmentIdCache)
+    DepartmentId getDepartmentId(const std::string& department) const;
+
+    // Получение специализированного веса для отдела
     double getDepartmentWeight(const std::string& department) const;
+    double getDepartmentWeight(DepartmentId id) const {
+        return departmentWeights[static_cast<size_t>(id)];
+    }
 
-    //     
+    // Получение названия параметра для отдела
     string getDepartmentParameterName(const std::string& department) const;
+    const string& getDepartmentParameterName(DepartmentId id) const;
 
-    // 
+    // Сеттеры
     void setCodeQualityWeight(double weight);
     void setTeamworkWeight(double weight);
     void setTasksWeight(double weight);
@@ -53,38 +120,73 @@ public:
     void setSupportSatisfactionWeight(double weight);
     void setQABugDetectionWeight(double weight);
 
-    //    
+    // Сохранение и загрузка конфигурации
     void saveConfig() const;
     bool loadConfig();
 
-    //   ( )
+    // Меню настройки (для администратора)
     void configMenu();
 
-    //   
+    // Показать все параметры
     void showAllParameters() const;
 
-    //      
+    // Проверка корректности весов для конкретного отдела
     bool validateDepartmentWeights(const std::string& department) const;
+    bool validateDepartmentWeights(DepartmentId id) const;
 
-    //     
+    // Расчет эффективности с учетом отдела
     double calculatePerformanceForDepartment(const std::string& department,
         double departmentScore,
         double teamworkScore,
         double tasksScore) const;
-    //      
+    double calculatePerformanceForDepartment(DepartmentId id,
+        double departmentScore,
+        double teamworkScore,
+        double tasksScore) const;
+
+    // Пакетный расчет с округлением до сотых (векторное ядро ScoringKernel);
+    // побитово совпадает с round(calculatePerformanceForDepartment(...) * 100) / 100
+    void calculatePerformanceBulk(const DepartmentId* departmentIds,
+        const double* departmentScores,
+        const double* teamworkScores,
+        const double* tasksScores,
+        double* finalScores,
+        size_t count) const;
+    void calculatePerformanceBulk(ScoreTable& table) const;
+    // Методы для работы с оценками эффективности
     void savePerformanceScore(const string& username, double score);
+    void setPerformanceScores(const vector<pair<string, double>>& scores);
     double getPerformanceScore(const string& username) const;
     bool hasPerformanceScore(const string& username) const;
     void loadPerformanceScores();
-    void savePerformanceScores() const;
+    // Полная перезапись performance_scores.txt и очистка журнала
+    void savePerformanceScores();
+    // Уплотнение журнала в фоновом потоке (при ошибке - синхронно)
+    void compactPerformanceScores();
+    void waitForScoresCompaction();
 
-private:
-    //       
-    string toLower(const std::string& str) const;
+    // Порог уплотнения журнала оценок (хранится в config.txt)
+    double getScoresCompactionFactor() const;
+    void setScoresCompactionFactor(double factor);
 
-    //    HR (    )
+    // Вызывается после каждого изменения оценки (savePerformanceScore, setPerformanceScores)
+    void setScoreListener(function<void(const string& username, double score)> listener);
+
+private:
+    // Специальный вес для HR (рассчитывается на основе других параметров)
     double getHRWeight() const;
+
+    // Разбор строки отдела по ключевым словам (без кэша)
+    static DepartmentId classifyDepartment(const std::string& department);
+
+    // Заполнить departmentWeights по текущим весам
+    void refreshDepartmentWeights();
+
+    bool applyScoreRecord(string_view record);
+    bool scoresJournalTooLong() const;
 };
 namespace HRSystem {
+    using ::DepartmentId;
+    using ::ScoreTable;
     using ::SystemConfig;
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "ThreadPool.h"
+#include <iostream>
+
+using namespace std;
+
+// --------------------------- Пул потоков ---------------------------
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = thread::hardware_concurrency();
+        if (threads == 0) threads = 4;
+    }
+
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    task_ready_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<mutex> lock(mutex_);
+        tasks_.push(move(task));
+    }
+    task_ready_.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock<mutex> lock(mutex_);
+    all_done_.wait(lock, [this] { return tasks_.empty() && running_ == 0; });
+}
+
+// Поток берет задачи, пока пул не остановлен и очередь не пуста
+void ThreadPool::worker_loop() {
+    for (;;) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(mutex_);
+            task_ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) return;
+
+            task = move(tasks_.front());
+            tasks_.pop();
+            ++running_;
+        }
+
+        try {
+            task();
+        }
+        catch (const exception& e) {
+            cerr << "Ошибка в фоновой задаче: " << e.what() << "\n";
+        }
+
+        {
+            lock_guard<mutex> lock(mutex_);
+            --running_;
+            if (tasks_.empty() && running_ == 0) all_done_.notify_all();
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// --------------------------- Пул потоков ---------------------------
+// Фиксированное число рабочих потоков и общая очередь задач.
+// Задачи не должны обращаться к хранилищам: им передаются заранее собранные данные.
+class ThreadPool {
+public:
+    // threads == 0 - по числу аппаратных потоков
+    explicit ThreadPool(size_t threads = 0);
+    // Дожидается выполнения всех поставленных задач
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size(); }
+
+    void submit(function<void()> task);
+
+    // Ждать, пока очередь опустеет и все начатые задачи завершатся
+    void wait();
+
+private:
+    vector<thread> workers_;
+    queue<function<void()>> tasks_;
+    mutex mutex_;
+    condition_variable task_ready_;
+    condition_variable all_done_;
+    size_t running_ = 0;
+    bool stopping_ = false;
+
+    void worker_loop();
+};
+
+namespace HRSystem {
+    using ::ThreadPool;
+}
@@ -0,0 +1,162 @@
+#include "TrigramIndex.h"
+#include "Utilities.h"
+#include <algorithm>
+
+using namespace std;
+
+// --------------------------- Триграммный индекс поиска подстроки ---------------------------
+
+static constexpr size_t COMPACT_MIN_DEAD = 1024;
+
+static uint32_t trigram_at(string_view text, size_t i) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(text[i])) << 16) |
+        (static_cast<uint32_t>(static_cast<unsigned char>(text[i + 1])) << 8) |
+        static_cast<uint32_t>(static_cast<unsigned char>(text[i + 2]));
+}
+
+void TrigramIndexCore::fold(string_view text, string& out) {
+    out.resize(text.size());
+    fold_case_cp1251(text.data(), text.size(), out.data());
+}
+
+// Без повторов: в списке документа одна триграмма встречается один раз
+void TrigramIndexCore::collect_trigrams(string_view folded, vector<uint32_t>& trigrams) {
+    trigrams.clear();
+    if (folded.size() < 3) return;
+
+    trigrams.reserve(folded.size() - 2);
+    for (size_t i = 0; i + 3 <= folded.size(); ++i) {
+        trigrams.push_back(trigram_at(folded, i));
+    }
+    sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+// Новые документы получают наибольший номер, поэтому добавление в конец списка
+// сохраняет его упорядоченность; повторная индексация (set_text) вставляет на место
+void TrigramIndexCore::index_text(uint32_t id) {
+    vector<uint32_t> trigrams;
+    collect_trigrams(folded_[id], trigrams);
+    for (uint32_t trigram : trigrams) {
+        vector<uint32_t>& list = postings_[trigram];
+        if (list.empty() || list.back() < id) {
+            list.push_back(id);
+        }
+        else {
+            auto it = lower_bound(list.begin(), list.end(), id);
+            if (it == list.end() || *it != id) list.insert(it, id);
+        }
+    }
+}
+
+void TrigramIndexCore::unindex_text(uint32_t id) {
+    vector<uint32_t> trigrams;
+    collect_trigrams(folded_[id], trigrams);
+    for (uint32_t trigram : trigrams) {
+        auto found = postings_.find(trigram);
+        if (found == postings_.end()) continue;
+
+        vector<uint32_t>& list = found->second;
+        auto it = lower_bound(list.begin(), list.end(), id);
+        if (it != list.end() && *it == id) list.erase(it);
+        if (list.empty()) postings_.erase(found);
+    }
+}
+
+uint32_t TrigramIndexCore::add_document(string_view text) {
+    uint32_t id = static_cast<uint32_t>(folded_.size());
+    folded_.emplace_back();
+    fold(text, folded_.back());
+    live_.push_back(true);
+    ++live_count_;
+    index_text(id);
+    return id;
+}
+
+void TrigramIndexCore::set_text(uint32_t id, string_view text) {
+    if (id >= folded_.size() || !live_[id]) return;
+
+    string folded;
+    fold(text, folded);
+    if (folded == folded_[id]) return;
+
+    unindex_text(id);
+    folded_[id] = move(folded);
+    index_text(id);
+}
+
+void TrigramIndexCore::remove_document(uint32_t id) {
+    if (id >= folded_.size() || !live_[id]) return;
+
+    unindex_text(id);
+    folded_[id].clear();
+    folded_[id].shrink_to_fit();
+    live_[id] = false;
+    --live_count_;
+}
+
+void TrigramIndexCore::clear_documents() {
+    folded_.clear();
+    live_.clear();
+    live_count_ = 0;
+    postings_.clear();
+}
+
+void TrigramIndexCore::reserve_documents(size_t count) {
+    folded_.reserve(count);
+    live_.reserve(count);
+}
+
+bool TrigramIndexCore::needs_compaction() const {
+    size_t dead = folded_.size() - live_count_;
+    return dead > COMPACT_MIN_DEAD && dead > live_count_;
+}
+
+vector<uint32_t> TrigramIndexCore::search_ids(string_view query) const {
+    vector<uint32_t> result;
+    string needle;
+    fold(query, needle);
+
+    // Короткий запрос не дает ни одной триграммы - проверяем все тексты
+    // (пустой, как и find(""), совпадает с любым)
+    if (needle.size() < 3) {
+        for (uint32_t id = 0; id < folded_.size(); ++id) {
+            if (live_[id] && folded_[id].find(needle) != string::npos) result.push_back(id);
+        }
+        return result;
+    }
+
+    vector<uint32_t> trigrams;
+    collect_trigrams(needle, trigrams);
+
+    vector<const vector<uint32_t>*> lists;
+    lists.reserve(trigrams.size());
+    for (uint32_t trigram : trigrams) {
+        auto found = postings_.find(trigram);
+        if (found == postings_.end()) return result;
+        lists.push_back(&found->second);
+    }
+    sort(lists.begin(), lists.end(),
+        [](const vector<uint32_t>* a, const vector<uint32_t>* b) { return a->size() < b->size(); });
+
+    // Кандидаты - самый короткий список; остальные только отсеивают их.
+    // Поиск в длинных списках идет вперед от прошлой позиции, т.к. кандидаты возрастают
+    vector<vector<uint32_t>::const_iterator> cursors;
+    cursors.reserve(lists.size());
+    for (const auto* list : lists) cursors.push_back(list->begin());
+
+    for (uint32_t id : *lists[0]) {
+        bool candidate = true;
+        for (size_t k = 1; k < lists.size(); ++k) {
+            cursors[k] = lower_bound(cursors[k], lists[k]->end(), id);
+            if (cursors[k] == lists[k]->end()) return result;
+            if (*cursors[k] != id) {
+                candidate = false;
+                break;
+            }
+        }
+        // Все триграммы есть, но не обязательно подряд - проверяем подстроку
+        if (candidate && folded_[id].find(needle) != string::npos) result.push_back(id);
+    }
+    return result;
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// --------------------------- Триграммный индекс поиска подстроки ---------------------------
+// Тексты документов приводятся к нижнему регистру (fold_case_cp1251) один раз при вставке.
+// Для каждой тройки подряд идущих байтов хранится отсортированный список документов,
+// в которых она встречается. Запрос пересекает списки своих триграмм, начиная с самого
+// короткого, и проверяет подстрокой только оставшихся кандидатов.
+// Запросы короче трех символов проверяются по всем (уже приведенным) текстам.
+// Несколько полей документа передаются одним текстом через '\n' - запрос с ним не совпадет.
+class TrigramIndexCore {
+public:
+    size_t document_count() const { return live_count_; }
+
+protected:
+    // Идентификаторы растут в порядке вставки, поэтому результаты идут в том же порядке
+    uint32_t add_document(string_view text);
+    void set_text(uint32_t id, string_view text);
+    void remove_document(uint32_t id);
+    void clear_documents();
+    void reserve_documents(size_t count);
+
+    // Идентификаторы документов, содержащих query, по возрастанию
+    vector<uint32_t> search_ids(string_view query) const;
+
+    // Удаленных больше, чем живых: пора перенумеровать (см. TrigramIndex::compact)
+    bool needs_compaction() const;
+    const string& folded_text(uint32_t id) const { return folded_[id]; }
+    bool is_live(uint32_t id) const { return live_[id]; }
+    uint32_t id_limit() const { return static_cast<uint32_t>(folded_.size()); }
+
+private:
+    vector<string> folded_;
+    vector<bool> live_;
+    size_t live_count_ = 0;
+    unordered_map<uint32_t, vector<uint32_t>> postings_;
+
+    static void fold(string_view text, string& out);
+    static void collect_trigrams(string_view folded, vector<uint32_t>& trigrams);
+    void index_text(uint32_t id);
+    void unindex_text(uint32_t id);
+};
+
+// Индекс над объектами, которыми владеет хранилище (User, Project): указатель <-> номер
+template <typename T>
+class TrigramIndex : public TrigramIndexCore {
+public:
+    void insert(const T* doc, string_view text) {
+        if (!doc || id_of_.count(doc)) return;
+        uint32_t id = add_document(text);
+        docs_.push_back(doc);
+        id_of_.emplace(doc, id);
+    }
+
+    // Новый текст того же документа; место в порядке выдачи сохраняется
+    void update(const T* doc, string_view text) {
+        auto it = id_of_.find(doc);
+        if (it == id_of_.end()) return insert(doc, text);
+        set_text(it->second, text);
+    }
+
+    // Документ заменен другим объектом на том же месте (UserStore::update_user)
+    void replace(const T* old_doc, const T* new_doc, string_view text) {
+        auto it = id_of_.find(old_doc);
+        if (it == id_of_.end()) return insert(new_doc, text);
+        uint32_t id = it->second;
+        id_of_.erase(it);
+        docs_[id] = new_doc;
+        id_of_.emplace(new_doc, id);
+        set_text(id, text);
+    }
+
+    void erase(const T* doc) {
+        auto it = id_of_.find(doc);
+        if (it == id_of_.end()) return;
+        remove_document(it->second);
+        docs_[it->second] = nullptr;
+        id_of_.erase(it);
+        if (needs_compaction()) compact();
+    }
+
+    void clear() {
+        clear_documents();
+        docs_.clear();
+        id_of_.clear();
+    }
+
+    void reserve(size_t count) {
+        reserve_documents(count);
+        docs_.reserve(count);
+        id_of_.reserve(count);
+    }
+
+    vector<const T*> search(string_view query) const {
+        vector<const T*> result;
+        for (uint32_t id : search_ids(query)) {
+            result.push_back(docs_[id]);
+        }
+        return result;
+    }
+
+private:
+    vector<const T*> docs_;     // по номеру; nullptr - удален
+    unordered_map<const T*, uint32_t> id_of_;
+
+    // Перенумеровать живые документы подряд, сохранив их порядок
+    void compact() {
+        vector<pair<const T*, string>> live;
+        live.reserve(document_count());
+        for (uint32_t id = 0; id < id_limit(); ++id) {
+            if (is_live(id)) live.emplace_back(docs_[id], folded_text(id));
+        }
+        clear();
+        reserve(live.size());
+        for (const auto& [doc, text] : live) insert(doc, text);
+    }
+};
+
+namespace HRSystem {
+    using ::TrigramIndex;
+}
@@ -2,10 +2,16 @@
 #include <windows.h>
 #include <algorithm> 
 #include <cctype>
+#include <cmath>
 #include <iomanip> 
 #include "UserClasses.h"
 #include "Projects.h" 
+#include "ThreadPool.h"
+#include "ReportPager.h"
+#include "Stats.h"
+#include <filesystem>
 #include <functional>
+#include <chrono>
 #include <conio.h>
 #include <locale>
 #include <codecvt>
@@ -19,9 +25,9 @@
 
 using namespace std;
 
-// ---------------------------      ---------------------------
+// --------------------------- Функции для работы с паролями ---------------------------
 
-//      ( )
+// Функция для безопасного ввода пароля (со звездочками)
 string input_password(const string& prompt) {
     cout << prompt;
     string password;
@@ -45,7 +51,7 @@ string input_password(const string& prompt) {
     return password;
 }
 
-//    
+// Простая функция хеширования пароля
 string hash_password(const string& password) {
     size_t hashed = std::hash<string>{}(password);
     return to_string(hashed);
@@ -58,10 +64,10 @@ bool verify_password(const string& input_password, const string& stored_hash) {
 }
 
 void User::view_profile() const {
-    cout << "----  ----\n";
-    cout << ": " << fullname_ << "\n";
-    cout << ": " << department_ << "\n";
-    cout << ": " << role_to_string(role_) << "\n";
+    cout << "---- Профиль ----\n";
+    cout << "ФИО: " << fullname_ << "\n";
+    cout << "Отдел: " << department_ << "\n";
+    cout << "Роль: " << role_to_string(role_) << "\n";
 }
 
 ostream& operator<<(ostream& os, const User& u) {
@@ -81,12 +87,12 @@ void HRManagerUser::hr_add_employee() {}
 void HRManagerUser::hr_add_project() {}
 
 void HRManagerUser::hr_calc_performance(const string& username) {
-    cout << "[HR]     '" << username << "'\n";
+    cout << "[HR] Расчет эффективности для сотрудника '" << username << "'\n";
 }
 
 void HRManagerUser::hr_generate_report(const string& username) {
-    cout << "[HR]     '" << username << "'\n";
-    cout << "   '  '\n";
+    cout << "[HR] Генерация отчета для сотрудника '" << username << "'\n";
+    cout << "Используйте пункт меню 'Сгенерировать отчет сотрудника'\n";
 }
 
 void HRManagerUser::employee_view_reports() const {}
@@ -94,61 +100,386 @@ void HRManagerUser::employee_view_reports() const {}
 void EmployeeUser::employee_view_reports() const {}
 
 void EmployeeUser::employee_view_rating() const {
-    cout << "[EMPLOYEE]   \n";
-    cout << "   '  '\n";
+    cout << "[EMPLOYEE] Просмотр моего рейтинга\n";
+    cout << "Используйте пункт меню 'Посмотреть мой рейтинг'\n";
 }
 
-// ---------------------------   ---------------------------
+// --------------------------- Хеш-индекс логинов ---------------------------
 
-//      
+size_t UsernameIndex::hash_of(const string& username) {
+    return std::hash<string>{}(username);
+}
+
+// Возвращает индекс слота с этим логином или slots_.size(), если логина нет
+size_t UsernameIndex::find_slot(const string& username, size_t hash) const {
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        const Slot& slot = slots_[i];
+        if (!slot.user && !slot.tombstone) return slots_.size();
+        if (slot.user && slot.hash == hash && slot.user->username() == username) return i;
+    }
+}
+
+User* UsernameIndex::find(const string& username) const {
+    size_t i = find_slot(username, hash_of(username));
+    return i < slots_.size() ? slots_[i].user : nullptr;
+}
+
+bool UsernameIndex::insert(User* user) {
+    if (!user) return false;
+
+    // Держим заполнение (вместе с надгробиями) не выше 1/2
+    if ((used_ + 1) * 2 > slots_.size()) {
+        rehash(size_ * 4 > slots_.size() ? slots_.size() * 2 : slots_.size());
+    }
+
+    size_t hash = hash_of(user->username());
+    if (find_slot(user->username(), hash) < slots_.size()) return false;
+
+    const size_t mask = slots_.size() - 1;
+    size_t i = hash & mask;
+    while (slots_[i].user) i = (i + 1) & mask;
+
+    if (!slots_[i].tombstone) ++used_;
+    slots_[i] = { hash, user, false };
+    ++size_;
+    return true;
+}
+
+bool UsernameIndex::erase(const User* user) {
+    if (!user) return false;
+
+    size_t i = find_slot(user->username(), hash_of(user->username()));
+    if (i == slots_.size() || slots_[i].user != user) return false;
+
+    slots_[i].user = nullptr;
+    slots_[i].tombstone = true;
+    --size_;
+    return true;
+}
+
+void UsernameIndex::clear() {
+    slots_.assign(16, Slot{});
+    size_ = 0;
+    used_ = 0;
+}
+
+void UsernameIndex::rehash(size_t capacity) {
+    vector<Slot> old = move(slots_);
+    slots_.assign(capacity, Slot{});
+    size_ = 0;
+    used_ = 0;
+
+    const size_t mask = capacity - 1;
+    for (const auto& slot : old) {
+        if (!slot.user) continue;
+        size_t i = slot.hash & mask;
+        while (slots_[i].user) i = (i + 1) & mask;
+        slots_[i] = slot;
+        ++size_;
+        ++used_;
+    }
+}
+
+// --------------------------- Индекс рейтинга ---------------------------
+
+// Тот же порядок, что давала сортировка в get_employees_sorted_by_rating
+bool RatingIndex::precedes(const Entry& a, const Entry& b) {
+    bool a_rated = a.rating >= 0;
+    bool b_rated = b.rating >= 0;
+    if (a_rated != b_rated) return a_rated;
+    if (a_rated && a.rating != b.rating) return a.rating > b.rating;
+    if (a.user->fullname() != b.user->fullname()) return a.user->fullname() < b.user->fullname();
+    if (a.user->username() != b.user->username()) return a.user->username() < b.user->username();
+    return less<const User*>{}(a.user, b.user);
+}
+
+uint32_t RatingIndex::next_priority() {
+    random_state_ ^= random_state_ << 13;
+    random_state_ ^= random_state_ >> 17;
+    random_state_ ^= random_state_ << 5;
+    return random_state_;
+}
+
+// Делит дерево t на ключи, предшествующие key, и все остальные
+void RatingIndex::split(uint32_t t, const Entry& key, uint32_t& less, uint32_t& not_less) {
+    if (t == NIL) {
+        less = not_less = NIL;
+        return;
+    }
+    if (precedes(nodes_[t].entry, key)) {
+        split(nodes_[t].right, key, nodes_[t].right, not_less);
+        less = t;
+    }
+    else {
+        split(nodes_[t].left, key, less, nodes_[t].left);
+        not_less = t;
+    }
+    update(t);
+}
+
+// Все ключи a предшествуют ключам b
+uint32_t RatingIndex::merge(uint32_t a, uint32_t b) {
+    if (a == NIL) return b;
+    if (b == NIL) return a;
+    if (nodes_[a].priority > nodes_[b].priority) {
+        nodes_[a].right = merge(nodes_[a].right, b);
+        update(a);
+        return a;
+    }
+    nodes_[b].left = merge(a, nodes_[b].left);
+    update(b);
+    return b;
+}
+
+uint32_t RatingIndex::insert_node(uint32_t t, uint32_t node) {
+    if (t == NIL) return node;
+    if (nodes_[node].priority > nodes_[t].priority) {
+        split(t, nodes_[node].entry, nodes_[node].left, nodes_[node].right);
+        update(node);
+        return node;
+    }
+    if (precedes(nodes_[node].entry, nodes_[t].entry)) {
+        nodes_[t].left = insert_node(nodes_[t].left, node);
+    }
+    else {
+        nodes_[t].right = insert_node(nodes_[t].right, node);
+    }
+    update(t);
+    return t;
+}
+
+// removed - узел найден по ключу и вынут из дерева
+uint32_t RatingIndex::erase_node(uint32_t t, const Entry& key, bool& removed) {
+    if (t == NIL) return NIL;
+    if (nodes_[t].entry.user == key.user) {
+        removed = true;
+        return merge(nodes_[t].left, nodes_[t].right);
+    }
+    if (precedes(key, nodes_[t].entry)) {
+        nodes_[t].left = erase_node(nodes_[t].left, key, removed);
+    }
+    else {
+        nodes_[t].right = erase_node(nodes_[t].right, key, removed);
+    }
+    if (removed) update(t);
+    return t;
+}
+
+// Запасной путь для erase: обход всего дерева, если спуск по ключу узел не нашел
+// (поля пользователя изменили, не переставив запись в индексе)
+uint32_t RatingIndex::unlink_node(uint32_t t, uint32_t node, bool& removed) {
+    if (t == NIL) return NIL;
+    if (t == node) {
+        removed = true;
+        return merge(nodes_[t].left, nodes_[t].right);
+    }
+    nodes_[t].left = unlink_node(nodes_[t].left, node, removed);
+    if (!removed) nodes_[t].right = unlink_node(nodes_[t].right, node, removed);
+    if (removed) update(t);
+    return t;
+}
+
+void RatingIndex::clear() {
+    nodes_.clear();
+    free_nodes_.clear();
+    node_of_.clear();
+    root_ = NIL;
+    rated_count_ = 0;
+}
+
+void RatingIndex::insert(const User* user, double rating) {
+    if (!user) return;
+    erase(user);
+
+    uint32_t node;
+    if (!free_nodes_.empty()) {
+        node = free_nodes_.back();
+        free_nodes_.pop_back();
+    }
+    else {
+        node = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    nodes_[node] = { { user, rating }, next_priority(), NIL, NIL, 1 };
+    node_of_[user] = node;
+    root_ = insert_node(root_, node);
+    if (rating >= 0) ++rated_count_;
+}
+
+bool RatingIndex::erase(const User* user) {
+    auto it = node_of_.find(user);
+    if (it == node_of_.end()) return false;
+
+    uint32_t node = it->second;
+    bool removed = false;
+    root_ = erase_node(root_, nodes_[node].entry, removed);
+    if (!removed) root_ = unlink_node(root_, node, removed);
+
+    // После обоих проходов узла в дереве нет, и только теперь слот можно отдать
+    // следующей вставке: иначе переиспользованный узел оказался бы в дереве дважды
+    if (nodes_[node].entry.rating >= 0) --rated_count_;
+    free_nodes_.push_back(node);
+    node_of_.erase(it);
+    return true;
+}
+
+size_t RatingIndex::rank_of(const User* user) const {
+    auto it = node_of_.find(user);
+    if (it == node_of_.end()) return 0;
+
+    const Entry& key = nodes_[it->second].entry;
+    size_t preceding = 0;
+    uint32_t t = root_;
+    while (t != NIL && nodes_[t].entry.user != user) {
+        if (precedes(key, nodes_[t].entry)) {
+            t = nodes_[t].left;
+        }
+        else {
+            preceding += size_of(nodes_[t].left) + 1;
+            t = nodes_[t].right;
+        }
+    }
+    return t == NIL ? 0 : preceding + size_of(nodes_[t].left) + 1;
+}
+
+const RatingIndex::Entry& RatingIndex::at(size_t position) const {
+    uint32_t t = root_;
+    for (;;) {
+        size_t left = size_of(nodes_[t].left);
+        if (position < left) {
+            t = nodes_[t].left;
+        }
+        else if (position == left) {
+            return nodes_[t].entry;
+        }
+        else {
+            position -= left + 1;
+            t = nodes_[t].right;
+        }
+    }
+}
+
+vector<RatingIndex::Entry> RatingIndex::slice(size_t first, size_t count) const {
+    vector<Entry> result;
+    if (first >= size()) return result;
+    result.reserve(min(count, size() - first));
+
+    // Путь к позиции first: в стеке остаются узлы, которые идут после нее по порядку
+    vector<uint32_t> path;
+    uint32_t t = root_;
+    while (t != NIL) {
+        size_t left = size_of(nodes_[t].left);
+        if (first < left) {
+            path.push_back(t);
+            t = nodes_[t].left;
+        }
+        else if (first == left) {
+            path.push_back(t);
+            break;
+        }
+        else {
+            first -= left + 1;
+            t = nodes_[t].right;
+        }
+    }
+
+    while (!path.empty() && result.size() < count) {
+        t = path.back();
+        path.pop_back();
+        result.push_back(nodes_[t].entry);
+        for (t = nodes_[t].right; t != NIL; t = nodes_[t].left) {
+            path.push_back(t);
+        }
+    }
+    return result;
+}
+
+// --------------------------- Хранилище пользователей ---------------------------
+
+// Порядок вставки совпадает с порядком старого линейного поиска:
+// администратор, затем HR, затем сотрудники (при дублях побеждает первый)
+void UserStore::rebuild_username_index() {
+    username_index_.clear();
+    if (admin_user_) username_index_.insert(admin_user_.get());
+    for (auto& hr : hr_users_) username_index_.insert(hr.get());
+    for (auto& up : users_) username_index_.insert(up.get());
+}
+
+// ФИО и логин одним текстом; '\n' не дает запросу совпасть на стыке полей
+string UserStore::name_search_text(const User* user) {
+    string text;
+    text.reserve(user->fullname().size() + 1 + user->username().size());
+    text += user->fullname();
+    text += '\n';
+    text += user->username();
+    return text;
+}
+
+// В индексе только users_ - HR и администратор в поиск сотрудников не попадают
+void UserStore::rebuild_name_index() {
+    name_index_.clear();
+    name_index_.reserve(users_.size());
+    for (auto& up : users_) name_index_.insert(up.get(), name_search_text(up.get()));
+}
+
+// Загружает пользователей из файла в память
 void UserStore::load_from_file() {
+    STAT_SCOPE(stat, "UserStore::load_from_file");
     users_.clear();
     hr_users_.clear();
     admin_user_.reset();
 
-    ifstream in(USERS_FILE);
-    if (in) {
-        string line;
-        while (getline(in, line)) {
-            line = trim(line);
-            if (line.empty()) continue;
-            auto u = UserFactory::create_user_from_record(line);
+    MappedFile file;
+    if (file.open(USERS_FILE)) {
+        file.for_each_line([this](string_view line) {
+            string_view fields[5];
+            size_t count = split_fields(line, '|', fields, 5);
+            auto u = UserFactory::create_user_from_fields(fields, count);
             if (u && u->role() != Role::HR && u->role() != Role::ADMIN) {
                 users_.push_back(move(u));
             }
-        }
+        });
     }
 
     load_hr_from_file();
 
     load_admin_from_file();
+
+    rebuild_username_index();
+    rebuild_name_index();
+    rebuild_rating_index();
 }
 
 void UserStore::load_hr_from_file() {
-    ifstream in(HR_USERS_FILE);
-    if (!in) {
+    STAT_SCOPE(stat, "UserStore::load_hr_from_file");
+    MappedFile file;
+    if (!file.open(HR_USERS_FILE)) {
         ofstream out(HR_USERS_FILE, ios::app);
         return;
     }
 
-    string line;
-    while (getline(in, line)) {
-        line = trim(line);
-        if (line.empty()) continue;
-        auto parts = split(line, '|');
-        if (parts.size() >= 5) {
+    file.for_each_line([this](string_view line) {
+        string_view fields[5];
+        if (split_fields(line, '|', fields, 5) >= 5) {
             auto u = make_unique<HRManagerUser>(
-                trim(parts[0]),
-                trim(parts[1]), 
-                trim(parts[2]), 
-                trim(parts[3])  
+                string(fields[0]),
+                string(fields[1]),
+                string(fields[2]),
+                string(fields[3])
             );
             hr_users_.push_back(move(u));
         }
-    }
+    });
 }
 
 void UserStore::save_to_file() {
+    if (in_batch()) {
+        users_dirty_ = true;
+        return;
+    }
+
+    STAT_SCOPE(stat, "UserStore::save_to_file");
     ofstream out(USERS_FILE, ios::trunc);
     if (!out) {
         cerr << "Unable to open users file for writing: " << USERS_FILE << "\n";
@@ -160,26 +491,15 @@ void UserStore::save_to_file() {
             out << uptr->serialize() << "\n";
         }
     }
+    stat.add_bytes(out.tellp());
 }
 
 User* UserStore::find_by_username(const string& username) {
-   
-    if (admin_user_ && admin_user_->username() == username) {
-        return admin_user_.get();
-    }
-
-    for (auto& hr : hr_users_) {
-        if (hr->username() == username) return hr.get();
-    }
-
-    for (auto& up : users_) {
-        if (up->username() == username) return up.get();
-    }
-
-    return nullptr;
+    STAT_SCOPE(stat, "UserStore::find_by_username");
+    return username_index_.find(username);
 }
 
-//    (     )
+// Добавление нового пользователя (в память и запись в файл)
 bool UserStore::add_user(unique_ptr<User> user) {
     if (!user) return false;
     if (find_by_username(user->username()) != nullptr) return false;
@@ -191,20 +511,29 @@ bool UserStore::add_user(unique_ptr<User> user) {
             user->fullname(),
             user->department()
         );
+        username_index_.insert(hr_user.get());
         hr_users_.push_back(move(hr_user));
+        save_hr_to_file();
     }
     else {
+        username_index_.insert(user.get());
+        name_index_.insert(user.get(), name_search_text(user.get()));
+        index_rating(user.get());
         users_.push_back(move(user));
+        save_to_file();
     }
 
-    save_all_files();
     return true;
 }
 
-//    
+// Удалить пользователя по логину
 bool UserStore::remove_user_by_username(const string& username) {
     for (size_t i = 0; i < users_.size(); ++i) {
         if (users_[i]->username() == username) {
+            username_index_.erase(users_[i].get());
+            name_index_.erase(users_[i].get());
+            unindex_rating(users_[i].get());
+            users_rollback_.retire(move(users_[i]));
             users_.erase(users_.begin() + i);
             save_to_file();
             return true;
@@ -216,6 +545,8 @@ bool UserStore::remove_user_by_username(const string& username) {
 bool UserStore::remove_hr_user_by_username(const string& username) {
     for (size_t i = 0; i < hr_users_.size(); ++i) {
         if (hr_users_[i]->username() == username) {
+            username_index_.erase(hr_users_[i].get());
+            hr_rollback_.retire(move(hr_users_[i]));
             hr_users_.erase(hr_users_.begin() + i);
             save_hr_to_file();
             return true;
@@ -228,6 +559,12 @@ bool UserStore::update_user(unique_ptr<User> updated) {
     if (!updated) return false;
     for (size_t i = 0; i < users_.size(); ++i) {
         if (users_[i]->username() == updated->username()) {
+            username_index_.erase(users_[i].get());
+            username_index_.insert(updated.get());
+            name_index_.replace(users_[i].get(), updated.get(), name_search_text(updated.get()));
+            unindex_rating(users_[i].get());
+            index_rating(updated.get());
+            users_rollback_.retire(move(users_[i]));
             users_[i] = move(updated);
             save_to_file();
             return true;
@@ -239,8 +576,18 @@ bool UserStore::update_user(unique_ptr<User> updated) {
 bool UserStore::update_employee(const string & username, const string & new_fullname, const string & new_department) {
     for (auto& user : users_) {
         if (user->username() == username) {
+            users_rollback_.on_rollback([target = user.get(), fullname = user->fullname(),
+                department = user->department()] {
+                target->set_fullname(fullname);
+                target->set_department(department);
+            });
+
+            // ФИО входит в ключ рейтинга
+            unindex_rating(user.get());
             user->set_fullname(new_fullname);
             user->set_department(new_department);
+            name_index_.update(user.get(), name_search_text(user.get()));
+            index_rating(user.get());
             save_to_file();
             return true;
         }
@@ -271,39 +618,26 @@ vector<const User*> UserStore::get_pending_users() const {
 }
 
 User* UserStore::get_employee(const string& username) const {
-    for (const auto& user : users_) {
-        if ((user->role() == Role::EMPLOYEE || user->role() == Role::PENDING) &&
-            user->username() == username) {
-            return user.get();
-        }
+    STAT_SCOPE(stat, "UserStore::get_employee");
+    User* user = username_index_.find(username);
+    if (user && (user->role() == Role::EMPLOYEE || user->role() == Role::PENDING)) {
+        return user;
     }
     return nullptr;
 }
 
 vector<const User*> UserStore::search_employees_by_name(const string& keyword) const {
-    vector<const User*> result;
-    string keyword_lower = keyword;
-    transform(keyword_lower.begin(), keyword_lower.end(), keyword_lower.begin(), ::tolower);
-
-    for (const auto& user : users_) {
-        if (user->role() == Role::EMPLOYEE || user->role() == Role::PENDING) {
-            string fullname_lower = user->fullname();
-            transform(fullname_lower.begin(), fullname_lower.end(), fullname_lower.begin(), ::tolower);
-
-            string username_lower = user->username();
-            transform(username_lower.begin(), username_lower.end(), username_lower.begin(), ::tolower);
-
-            if (fullname_lower.find(keyword_lower) != string::npos ||
-                username_lower.find(keyword_lower) != string::npos) {
-                result.push_back(user.get());
-            }
-        }
-    }
+    STAT_SCOPE(stat, "UserStore::search_employees_by_name");
+    vector<const User*> result = name_index_.search(keyword);
+    result.erase(remove_if(result.begin(), result.end(), [](const User* user) {
+        return user->role() != Role::EMPLOYEE && user->role() != Role::PENDING;
+    }), result.end());
     return result;
 }
 
-//  
+// Сортировка сотрудников
 vector<const User*> UserStore::get_employees_sorted_by_name(bool ascending) const {
+    STAT_SCOPE(stat, "UserStore::get_employees_sorted_by_name");
     vector<const User*> result = get_all_employees();
 
     sort(result.begin(), result.end(), [ascending](const User* a, const User* b) {
@@ -318,7 +652,7 @@ vector<const User*> UserStore::get_employees_sorted_by_name(bool ascending) cons
     return result;
 }
 
-//      
+// Метод для получения всех обычных пользователей
 vector<User*> UserStore::get_employees() const {
     vector<User*> employees;
 
@@ -330,67 +664,153 @@ vector<User*> UserStore::get_employees() const {
     return employees;
 }
 
-//      
-vector<pair<const User*, double>> UserStore::get_employees_sorted_by_rating(SystemConfig* config) const {
-    vector<pair<const User*, double>> employees_with_ratings;
+// --------------------------- Рейтинг сотрудников ---------------------------
+
+// Оценка из SystemConfig, округленная до сотых; -1, если сотрудник не оценен
+double UserStore::rating_of(const User* user) const {
+    double rating = ratings_config_->getPerformanceScore(user->username());
+    if (rating >= 0) {
+        rating = round(rating * 100) / 100;
+    }
+    return rating;
+}
+
+void UserStore::rebuild_rating_index() const {
+    STAT_SCOPE(stat, "UserStore::rebuild_rating_index");
+    rating_index_.clear();
+    department_ratings_.clear();
+    if (!ratings_config_) return;
 
     for (const auto& user : users_) {
         if (user->role() == Role::EMPLOYEE || user->role() == Role::PENDING) {
-            double rating = config->getPerformanceScore(user->username());
-            if (rating >= 0) {
-                rating = round(rating * 100) / 100;
-            }
-            employees_with_ratings.push_back({ user.get(), rating });
+            double rating = rating_of(user.get());
+            rating_index_.insert(user.get(), rating);
+            department_ratings_[user->department()].insert(user.get(), rating);
         }
     }
+}
 
-    sort(employees_with_ratings.begin(), employees_with_ratings.end(),
-        [](const pair<const User*, double>& a, const pair<const User*, double>& b) {
+void UserStore::index_rating(const User* user) {
+    if (ratings_config_ && (user->role() == Role::EMPLOYEE || user->role() == Role::PENDING)) {
+        double rating = rating_of(user);
+        rating_index_.insert(user, rating);
+        department_ratings_[user->department()].insert(user, rating);
+    }
+}
 
-            if (a.second >= 0 && b.second >= 0) {
-                if (a.second != b.second) {
-                    return a.second > b.second;
-                }
-               
-                return a.first->fullname() < b.first->fullname();
-            }
-            else if (a.second >= 0) {
-                return true;
-            }
+// Вызывается до изменения отдела пользователя: запись ищется по текущему отделу
+void UserStore::unindex_rating(const User* user) {
+    if (!rating_index_.erase(user)) return;
 
-            else if (b.second >= 0) {
-                return false;
-            }
+    auto it = department_ratings_.find(user->department());
+    if (it != department_ratings_.end()) {
+        it->second.erase(user);
+        if (it->second.size() == 0) department_ratings_.erase(it);
+    }
+}
 
-            return a.first->fullname() < b.first->fullname();
-        });
+void UserStore::attach_ratings(const SystemConfig* config) const {
+    if (ratings_config_ == config) return;
+    ratings_config_ = config;
+    rebuild_rating_index();
+}
+
+// Оценка сотрудника изменилась: запись переставляется в индексе, O(log n)
+void UserStore::update_rating(const string& username, double score) {
+    if (!ratings_config_) return;
+
+    User* user = username_index_.find(username);
+    if (!user || !rating_index_.contains(user)) return;
 
+    if (score >= 0) {
+        score = round(score * 100) / 100;
+    }
+    rating_index_.insert(user, score);
+    department_ratings_[user->department()].insert(user, score);
+}
+
+// Получить всех сотрудников отсортированных по рейтингу (обход индекса, без сортировки)
+vector<pair<const User*, double>> UserStore::get_employees_sorted_by_rating(SystemConfig* config) const {
+    STAT_SCOPE(stat, "UserStore::get_employees_sorted_by_rating");
+    attach_ratings(config);
+
+    vector<pair<const User*, double>> employees_with_ratings;
+    employees_with_ratings.reserve(rating_index_.size());
+    rating_index_.for_each([&](const RatingIndex::Entry& entry) {
+        employees_with_ratings.push_back({ entry.user, entry.rating });
+    });
     return employees_with_ratings;
 }
 
-//     
+// Получить место сотрудника в рейтинге
 pair<int, int> UserStore::get_employee_rank(const string& username, SystemConfig* config) const {
-    auto sorted_employees = get_employees_sorted_by_rating(config);
+    STAT_SCOPE(stat, "UserStore::get_employee_rank");
+    attach_ratings(config);
 
-    int total_employees = sorted_employees.size();
-    int position = -1;
+    int total_employees = static_cast<int>(rating_index_.size());
+    size_t rank = rating_index_.rank_of(username_index_.find(username));
+    int position = rank > 0 ? static_cast<int>(rank) : -1;
 
-    for (size_t i = 0; i < sorted_employees.size(); ++i) {
-        if (sorted_employees[i].first->username() == username) {
-            position = static_cast<int>(i) + 1;
-            break;
-        }
+    return { position, total_employees };
+}
+
+static vector<pair<const User*, double>> to_rating_pairs(const vector<RatingIndex::Entry>& entries) {
+    vector<pair<const User*, double>> result;
+    result.reserve(entries.size());
+    for (const auto& entry : entries) {
+        result.push_back({ entry.user, entry.rating });
     }
+    return result;
+}
 
-    return { position, total_employees };
+vector<pair<const User*, double>> UserStore::get_top_rated(size_t k, SystemConfig* config) const {
+    STAT_SCOPE(stat, "UserStore::get_top_rated");
+    attach_ratings(config);
+    return to_rating_pairs(rating_index_.slice(0, min(k, rating_index_.rated_count())));
+}
+
+// Фильтр по отделу не требует прохода по сотрудникам: у каждого отдела свой индекс
+vector<pair<const User*, double>> UserStore::get_top_rated_in_department(const string& department,
+    size_t k, SystemConfig* config) const {
+    STAT_SCOPE(stat, "UserStore::get_top_rated_in_department");
+    attach_ratings(config);
+
+    auto it = department_ratings_.find(department);
+    if (it == department_ratings_.end()) return {};
+    return to_rating_pairs(it->second.slice(0, min(k, it->second.rated_count())));
+}
+
+vector<pair<const User*, double>> UserStore::get_bottom_rated(size_t k, SystemConfig* config) const {
+    STAT_SCOPE(stat, "UserStore::get_bottom_rated");
+    attach_ratings(config);
+
+    size_t rated = rating_index_.rated_count();
+    size_t count = min(k, rated);
+    auto result = to_rating_pairs(rating_index_.slice(rated - count, count));
+    reverse(result.begin(), result.end());
+    return result;
+}
+
+map<string, vector<pair<const User*, double>>> UserStore::get_top_rated_by_department(size_t k,
+    SystemConfig* config) const {
+    STAT_SCOPE(stat, "UserStore::get_top_rated_by_department");
+    attach_ratings(config);
+
+    map<string, vector<pair<const User*, double>>> result;
+    for (const auto& [department, index] : department_ratings_) {
+        if (index.rated_count() == 0) continue;
+        result.emplace(department, to_rating_pairs(index.slice(0, min(k, index.rated_count()))));
+    }
+    return result;
 }
 
 void UserStore::load_admin_from_file() {
+    STAT_SCOPE(stat, "UserStore::load_admin_from_file");
     admin_user_.reset();
 
     ifstream in(ADMIN_USERS_FILE);
     if (!in) {
-        cout << "\n   .    ...\n";
+        cout << "\nФайл администратора не найден. Создание администратора по умолчанию...\n";
         create_default_admin();
         return;
     }
@@ -398,7 +818,7 @@ void UserStore::load_admin_from_file() {
     in.seekg(0, ios::end);
     if (in.tellg() == 0) {
         in.close();
-        cout << "\n  .    ...\n";
+        cout << "\nФайл администратора пустой. Создание администратора по умолчанию...\n";
         create_default_admin();
         return;
     }
@@ -409,41 +829,47 @@ void UserStore::load_admin_from_file() {
     if (getline(in, line)) {
         line = trim(line);
         if (!line.empty()) {
-            auto parts = split(line, '|');
-            if (parts.size() >= 5) {
+            string_view parts[5];
+            if (split_fields(line, '|', parts, 5) >= 5) {
                 admin_user_ = make_unique<Admin>(
-                    trim(parts[0]),  
-                    trim(parts[1]),
-                    trim(parts[2]) 
+                    string(parts[0]),
+                    string(parts[1]),
+                    string(parts[2])
                 );
                 return;
             }
         }
     }
 
-    cout << "\n  .    ...\n";
+    cout << "\nФайл администратора поврежден. Создание администратора по умолчанию...\n";
     create_default_admin();
 }
 
 void UserStore::create_default_admin() {
-    //       "admin123"
+    // Создаем администратора с дефолтным хешированным паролем "admin123"
     string default_password = "admin123";
     string password_hash = hash_password(default_password);
 
-    admin_user_ = make_unique<Admin>("admin", password_hash, " ");
+    admin_user_ = make_unique<Admin>("admin", password_hash, "Системный администратор");
 
     cout << "\n" << string(50, '=') << "\n";
-    cout << ":    !\n\n";
-    cout << ": admin\n";
-    cout << ": admin123\n";
-    cout << ":  \n\n";
-    cout << "     !\n";
+    cout << "Внимание: создан администратор по умолчанию!\n\n";
+    cout << "Логин: admin\n";
+    cout << "Пароль: admin123\n";
+    cout << "Роль: Системный администратор\n\n";
+    cout << "Рекомендуется сменить пароль после первого входа!\n";
     cout << string(50, '=') << "\n\n";
 
     save_admin_to_file();
 }
 
 void UserStore::save_admin_to_file() {
+    if (in_batch()) {
+        admin_dirty_ = true;
+        return;
+    }
+
+    STAT_SCOPE(stat, "UserStore::save_admin_to_file");
     ofstream out(ADMIN_USERS_FILE, ios::trunc);
     if (!out) {
         cerr << "Unable to open admin users file for writing: " << ADMIN_USERS_FILE << "\n";
@@ -453,12 +879,13 @@ void UserStore::save_admin_to_file() {
     if (admin_user_) {
         out << admin_user_->serialize() << "\n";
     }
+    stat.add_bytes(out.tellp());
 }
 
 bool UserStore::move_user_to_hr(const string& username) {
     for (size_t i = 0; i < users_.size(); ++i) {
         if (users_[i]->username() == username && users_[i]->role() == Role::PENDING) {
-            //  HR  
+            // Создаем HR версию пользователя
             auto hr_user = make_unique<HRManagerUser>(
                 users_[i]->username(),
                 users_[i]->password(),
@@ -466,14 +893,20 @@ bool UserStore::move_user_to_hr(const string& username) {
                 users_[i]->department()
             );
 
-            //   HR 
+            // Добавляем в HR контейнер
+            username_index_.erase(users_[i].get());
+            name_index_.erase(users_[i].get());
+            unindex_rating(users_[i].get());
+            username_index_.insert(hr_user.get());
             hr_users_.push_back(move(hr_user));
 
-            //    
+            // Удаляем из обычных пользователей
+            users_rollback_.retire(move(users_[i]));
             users_.erase(users_.begin() + i);
 
-            //    
-            save_all_files();
+            // Сохраняем изменения в файлах
+            save_to_file();
+            save_hr_to_file();
             return true;
         }
     }
@@ -481,13 +914,17 @@ bool UserStore::move_user_to_hr(const string& username) {
 }
 
 bool UserStore::is_hr_user(const string& username) const {
-    for (const auto& hr : hr_users_) {
-        if (hr->username() == username) return true;
-    }
-    return false;
+    const User* user = username_index_.find(username);
+    return user && user->role() == Role::HR;
 }
 
 void UserStore::save_hr_to_file() {
+    if (in_batch()) {
+        hr_dirty_ = true;
+        return;
+    }
+
+    STAT_SCOPE(stat, "UserStore::save_hr_to_file");
     ofstream out(HR_USERS_FILE, ios::trunc);
     if (!out) {
         cerr << "Unable to open HR users file for writing: " << HR_USERS_FILE << "\n";
@@ -497,6 +934,7 @@ void UserStore::save_hr_to_file() {
     for (const auto& hr : hr_users_) {
         out << hr->serialize() << "\n";
     }
+    stat.add_bytes(out.tellp());
 }
 void UserStore::save_all_files() {
     save_to_file();      
@@ -504,6 +942,43 @@ void UserStore::save_all_files() {
     save_admin_to_file(); 
 }
 
+void UserStore::begin_batch() {
+    ++batch_depth_;
+    users_rollback_.begin(users_);
+    hr_rollback_.begin(hr_users_);
+}
+
+// Записывает каждый измененный за пакет файл один раз
+void UserStore::commit_batch() {
+    if (batch_depth_ == 0) return;
+
+    users_rollback_.commit();
+    hr_rollback_.commit();
+    if (--batch_depth_ > 0) return;
+
+    if (users_dirty_) save_to_file();
+    if (hr_dirty_) save_hr_to_file();
+    if (admin_dirty_) save_admin_to_file();
+    users_dirty_ = hr_dirty_ = admin_dirty_ = false;
+}
+
+// Файлы во время пакета не менялись: откат возвращает прежние объекты на место
+// и перестраивает индексы. Флаги изменений внешнего пакета остаются - его commit
+// перепишет файлы текущим (уже откаченным) состоянием.
+void UserStore::rollback_batch() {
+    if (batch_depth_ == 0) return;
+
+    users_rollback_.rollback(users_);
+    hr_rollback_.rollback(hr_users_);
+    if (--batch_depth_ == 0) {
+        users_dirty_ = hr_dirty_ = admin_dirty_ = false;
+    }
+
+    rebuild_username_index();
+    rebuild_name_index();
+    rebuild_rating_index();
+}
+
 vector<const User*> UserStore::all_users() const {
     vector<const User*> result;
 
@@ -524,7 +999,7 @@ bool UserStore::is_admin_user(const string& username) const {
     return admin_user_ && admin_user_->username() == username;
 }
 
-// ---------------------------      ---------------------------
+// --------------------------- Интерфейс консоли и рабочий поток ---------------------------
 
 void Application::run() {
     
@@ -532,7 +1007,7 @@ void Application::run() {
     while (running) {
         system("cls");
         show_main_menu();
-        int choice = input_int(": ");
+        int choice = input_int("Выберите: ");
         bool has_admin = (store_->find_by_username("admin") != nullptr);
         switch (choice) {
         case 1:
@@ -543,24 +1018,24 @@ void Application::run() {
             break;
         
         case 0:
-            cout << "...  \n";
+            cout << "Выход... До свидания\n";
             running = false;
             break;
         default:
-            cout << " .\n";
+            cout << "Неверный выбор.\n";
         }
     }
     
 }
 
 void Application::show_main_menu() {
-    cout << "\n======  HR-  IT- ======\n";
-    cout << "1) \n";
-    cout << "2) \n";
-    cout << "0) \n";
+    cout << "\n====== АИС HR-менеджмента для IT-предприятия ======\n";
+    cout << "1) Войти\n";
+    cout << "2) Зарегистрироваться\n";
+    cout << "0) Выход\n";
 }
 
-//------------------------------------   ( Application)---------------------------------------
+//------------------------------------ Корректность ввода (в Application)---------------------------------------
 int Application::input_int(const string& prompt) {
     while (true) {
         cout << prompt;
@@ -571,7 +1046,7 @@ int Application::input_int(const string& prompt) {
             return v;
         }
         catch (...) {
-            cout << ",  ...\n";
+            cout << "Пожалуйста, введите число...\n";
         }
     }
 }
@@ -585,12 +1060,12 @@ string Application::input_line(const string& prompt, bool allow_empty) {
         if (!getline(cin, s)) {    
             cin.clear(); 
             cin.ignore(10, '\n');
-            cout << "\033[31m !  .\033[0m\n";
+            cout << "\033[31mОшибка ввода! Повторите попытку.\033[0m\n";
             continue;
         }
 
         s = trim(s);
-        //     allow_empty = true
+        // Разрешаем пустую строку если allow_empty = true
         if (allow_empty && s.empty()) {
             return s;
         }
@@ -606,12 +1081,12 @@ string Application::input_line(const string& prompt, bool allow_empty) {
         }
 
         if (s.empty()) {
-            cout << "\033[31m:  !\033[0m\n";
+            cout << "\033[31mОшибка: пустая строка!\033[0m\n";
             continue;
         }
 
         if (!hasLetter) {
-            cout << "\033[31m:       !\033[0m\n";
+            cout << "\033[31mОшибка: строка должна содержать хотя бы одну букву!\033[0m\n";
             continue;
         }
 
@@ -623,28 +1098,28 @@ string Application::input_line(const string& prompt, bool allow_empty) {
 // ----------- Login flow -----------
 
 void Application::handle_login() {
-    string login = input_line(": ");
+    string login = input_line("Логин: ");
     if (login.empty()) {
-        cout << "   ,    ...\n";
+        cout << "Вы ввели пустой логин, возврат в главное меню...\n";
         return;
     }
 
     User* user = store_->find_by_username(login);
     if (!user) {
-        cout << "  .  ? (y/n): ";
+        cout << "Пользователь не найден. Хотите зарегистрироваться? (y/n): ";
         string ans; getline(cin, ans);
         if (!ans.empty() && (ans[0] == 'y' || ans[0] == 'Y')) {
             handle_register_with_login(login);
         }
         else {
-            cout << "   ...\n";
+            cout << "Возврат в главное меню...\n";
         }
         return;
     }
 
     bool ok = attempt_password(user->password());
     if (!ok) {
-        cout << "   .    ...\n";
+        cout << "Слишком много неудачных попыток. Возврат в главное меню...\n";
         return;
     }
 
@@ -658,7 +1133,7 @@ void Application::handle_login() {
         hr_session(hr);
     }
     else if (r == Role::PENDING) {
-        cout << "      .    HR   .\n";
+        cout << "Ваша учетная запись находится в стадии рассмотрения. для получения прав HR требуется одобрение администратора.\n";
         EmployeeUser emp(user->username(), user->password(), user->fullname(), user->department());
         employee_session(emp);
     }
@@ -673,14 +1148,14 @@ void Application::handle_login() {
 bool Application::attempt_password(const string& true_password_hash) {
     const int MAX_ATTEMPTS = 3;
     for (int attempt = 1; attempt <= MAX_ATTEMPTS; ++attempt) {
-        string pw = input_password(": ");
+        string pw = input_password("Пароль: ");
 
         if (verify_password(pw, true_password_hash)) {
-            cout << "   (" << now_string() << ")\n";
+            cout << "Аутентификация прошла успешно (" << now_string() << ")\n";
             return true;
         }
         else {
-            cout << " .  : " << (MAX_ATTEMPTS - attempt) << "\n";
+            cout << "Неверный пароль. Осталось попыток: " << (MAX_ATTEMPTS - attempt) << "\n";
         }
     }
     return false;
@@ -706,9 +1181,9 @@ bool UserStore::is_password_already_used(const string& password_hash) const {
 }
 
 void Application::handle_register() {
-    string login = input_line(": ");
+    string login = input_line("Логин: ");
     if (login.empty()) {
-        cout << "   ,    ...\n";
+        cout << "Вы ввели пустой логин, возврат в главное меню...\n";
         return;
     }
     handle_register_with_login(login);
@@ -717,79 +1192,75 @@ void Application::handle_register() {
 void Application::handle_register_with_login(const string& desired_login) {
     string login = desired_login;
     while (store_->find_by_username(login) != nullptr) {
-        cout << " '" << login << "'  .      'q'  : ";
+        cout << "Логин '" << login << "' уже существует. Введите другой логин или введите 'q' для отмены: ";
         string alt; getline(cin, alt);
         alt = trim(alt);
         if (alt.empty() || alt == "q" || alt == "Q") {
-            cout << " .    ...\n";
+            cout << "Регистрация отменена. Возврат в главное меню...\n";
             return;
         }
         login = alt;
     }
 
-    //     
+    // Проверка на зарезервированные логины 
     if (login == "admin" || login == "administrator" || login == "root") {
-        cout << "   .   .\n";
+        cout << "Данный логин зарезервирован системой. Выберите другой логин.\n";
         return handle_register(); 
     }
 
     string password;
     while (true) {
-        password = input_password(": ");
+        password = input_password("Пароль: ");
         if (password.empty()) {
-            cout << "    .\n";
+            cout << "Пароль не может быть пустым.\n";
             continue;
         }
         if (password.length() < 6) {
-            cout << "    6 .\n";
+            cout << "Пароль должен содержать минимум 6 символов.\n";
             continue;
         }
-        //   
+        // Хешируем пароль 
         string password_hash = hash_password(password);
 
-        // ,     
+        // Проверяем, используется ли уже такой пароль
         if (store_->is_password_already_used(password_hash)) {
-            cout << "\033[31m:      !\033[0m\n";
-            cout << ",   .\n";
+            cout << "\033[31mОшибка: этот пароль уже используется другим пользователем!\033[0m\n";
+            cout << "Пожалуйста, придумайте другой пароль.\n";
             continue;
         }
 
-        string password2 = input_password(" : ");
+        string password2 = input_password("Подтвердите пароль: ");
         if (password != password2) {
-            cout << "  .  .\n";
+            cout << "Пароли не совпадают. Попробуйте заново.\n";
             continue;
         }
         break;
     }
 
-    string fullname = input_line(" : ");
+    string fullname = input_line("Ваше ФИО: ");
     string department = choose_department();
 
     Role role = Role::EMPLOYEE;
-    if (!department.empty()) {
-        string dep_upper = department;
-        transform(dep_upper.begin(), dep_upper.end(), dep_upper.begin(), ::toupper);
-        if (dep_upper == "HR") {
-            role = Role::PENDING;
-        }
+    if (equals_fold_cp1251(department, "HR")) {
+        role = Role::PENDING;
     }
 
     string password_hash = hash_password(password);
 
     auto u_ptr = UserFactory::create_user(login, password_hash, fullname, department, role);
     if (!u_ptr) {
-        cout << "  \n";
+        cout << "Ошибка создания пользователя\n";
         return;
     }
 
     if (store_->add_user(move(u_ptr))) {
-        cout << "  ,      .\n";
+        cout << "Регистрация прошла успешно, теперь вы можете войти в систему.\n";
         store_->load_from_file();
         if (role == Role::PENDING) {
-            cout << "   HR   .\n";
+            cout << "Для подтверждения роли HR требуется одобрение администратора.\n";
         }
        
-        cout << "\n    ? (y/n): ";
+        cout << "\nХотите войти в систему сейчас? (y/n): ";
         string answer;
         getline(cin, answer);
 
@@ -808,7 +1279,7 @@ void Application::handle_register_with_login(const string& desired_login) {
                     hr_session(hr);
                 }
                 else if (r == Role::PENDING) {
-                    cout << "      .\n";
+                    cout << "Ваша учетная запись находится в стадии рассмотрения.\n";
                     EmployeeUser emp(login, password_hash, fullname, department);
                     employee_session(emp);
                 }
@@ -822,124 +1293,177 @@ void Application::handle_register_with_login(const string& desired_login) {
 
     
     else {
-        cout << "   (  ),    .\n";
+        cout << "Регистрация не удалась (возможно логин занят), возвращаемся в главное меню.\n";
     }
 }
 
 string Application::choose_department() {
     vector<string> depts = {
-        "HR", "", "QA", "", "", "", ""
+        "HR", "Разработка", "QA", "Дизайн", "Маркетинг", "Продажи", "Поддержка"
     };
-    cout << " :\n";
+    cout << "Выберите отдел:\n";
     for (size_t i = 0; i < depts.size(); ++i) {
         cout << (i + 1) << ") " << depts[i] << "\n";
     }
 
-    int sel = input_int(" : ");
+    int sel = input_int("Ваш выбор: ");
     if (sel >= 1 && static_cast<size_t>(sel) <= depts.size()) return depts[sel - 1];
     else {
         do {
-            cout << " .   ." << endl;
-            sel = input_int(" : ");
+            cout << "Неверный выбор. Введите корректное число." << endl;
+            sel = input_int("Ваш выбор: ");
         } while (sel < 1 || static_cast<size_t>(sel) > depts.size());
         return depts[sel - 1];
     }
 }
 
-// -----------   (  ) -----------
+// ----------- Сессии пользователей (меню после входа) -----------
 void Application::admin_session(Admin& admin) {
     
     bool in_session = true;
     while (in_session) {
         system("cls");
-        cout << "\n---   ---\n";
-        cout << "1)   \n";
-        cout << "2)   HR  \n";
-        cout << "3)  \n";
-        cout << "4)   \n";
-        cout << "5) \n";
-        int cmd = input_int(" : ");
+        cout << "\n--- Меню Администратора ---\n";
+        cout << "1) Просмотреть всех пользователей\n";
+        cout << "2) Назначить роль HR ожидающему пользователю\n";
+        cout << "3) Удалить пользователя\n";
+        cout << "4) Настроить параметры оценки\n";
+        cout << "5) Статистика производительности\n";
+        cout << "6) Выход\n";
+        int cmd = input_int("Ваш выбор: ");
         switch (cmd) {
         case 1:
             list_all_users();
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         case 2:
             assign_hr_role_flow();
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         case 3: {
-            string uname = input_line("    : ");
+            string uname = input_line("Введите логин пользователя для удаления: ");
 
             if (uname == admin.username()) {
-                cout << "   .\n";
+                cout << "Нельзя удалить текущего администратора.\n";
                 break;
             }
 
             if (store_->remove_user_by_username(uname)) {
-                cout << "  .    .\n";
+                cout << "Пользователь удален успешно. Данные в файлах обновлены.\n";
 
+                ProjectStore::Transaction tx(*project_store_);
                 auto emp_projects = project_store_->all_employee_projects();
                 for (const auto& emp_proj : emp_projects) {
                     if (emp_proj->username() == uname) {
                         project_store_->remove_employee_from_project(uname, emp_proj->project_name());
                     }
                 }
+                tx.commit();
             }
             
             if (store_->remove_hr_user_by_username(uname)) {
-                cout << "  .    .\n";
+                cout << "Пользователь удален успешно. Данные в файлах обновлены.\n";
 
                 
             }
             else {
-                cout << "  .\n";
+                cout << "Пользователь не найден.\n";
             }
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         }
         case 4:
             admin_configure_system();
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         case 5:
+            admin_stats_menu();
+            break;
+        case 6:
             in_session = false;
-            cout << "   ...";
+            cout << "Администратор вышел из системы...";
             
             Sleep(1000);
             
             break;
         default:
-            cout << " .\n";
+            cout << "Неверный выбор.\n";
             Sleep(1000);
         }
     }
     
 }
 
-//      ( )
+// Добавляем метод для настройки системы (для администратора)
 void Application::admin_configure_system() {
-    cout << "\n===    ===\n";
+    cout << "\n=== Настройка параметров системы ===\n";
     system_config_->configMenu();
 }
 
+void Application::admin_stats_menu() {
+    while (true) {
+        system("cls");
+        cout << "\n=== Статистика производительности ===\n";
+        cout << "Сбор статистики: " << (stats_enabled() ? "включен" : "выключен") << "\n";
+        cout << "1) Показать статистику\n";
+        cout << "2) Записать статистику в файл " << STATS_FILE << "\n";
+        cout << "3) " << (stats_enabled() ? "Выключить" : "Включить") << " сбор статистики\n";
+        cout << "4) Сбросить счетчики\n";
+        cout << "5) Назад\n";
+        int cmd = input_int("Ваш выбор: ");
+        switch (cmd) {
+        case 1:
+            cout << stats_report();
+            break;
+        case 2:
+            if (write_stats_file(STATS_FILE)) {
+                cout << "Статистика записана в файл " << STATS_FILE << "\n";
+            }
+            else {
+                cout << "Ошибка: не удалось записать файл " << STATS_FILE << "\n";
+            }
+            break;
+        case 3:
+            set_stats_enabled(!stats_enabled());
+            if (stats_enabled()) {
+                cout << "Сбор статистики включен. При выходе из программы она будет записана в "
+                    << STATS_FILE << "\n";
+            }
+            else {
+                cout << "Сбор статистики выключен.\n";
+            }
+            break;
+        case 4:
+            reset_stats();
+            cout << "Счетчики сброшены.\n";
+            break;
+        case 5:
+            return;
+        default:
+            cout << "Неверный выбор.\n";
+        }
+        cout << "Нажмите Enter для продолжения...";
+        cin.ignore();
+    }
+}
 
-//       
+
+// Реализация расчета эффективности с учетом отдела сотрудника
 void Application::hr_calculate_performance() {
-    cout << "\n===    ===\n";
+    cout << "\n=== РАСЧЕТ ЭФФЕКТИВНОСТИ СОТРУДНИКА ===\n";
 
     auto employees = store_->get_all_employees();
 
     if (employees.empty()) {
-        cout << "   .\n";
+        cout << "Нет сотрудников для расчета.\n";
         return;
     }
 
-    cout << "\n---   ---\n\n";
+    cout << "\n--- ВЫБЕРИТЕ СОТРУДНИКА ---\n\n";
 
     const int NUM_WIDTH = 5;
     const int FULLNAME_WIDTH = 35;
@@ -947,10 +1471,10 @@ void Application::hr_calculate_performance() {
     const int RATING_WIDTH = 15;
 
     cout << left
-        << setw(NUM_WIDTH) << ""
-        << setw(FULLNAME_WIDTH) << ""
-        << setw(DEPARTMENT_WIDTH) << ""
-        << setw(RATING_WIDTH) << " "
+        << setw(NUM_WIDTH) << "№"
+        << setw(FULLNAME_WIDTH) << "ФИО"
+        << setw(DEPARTMENT_WIDTH) << "ОТДЕЛ"
+        << setw(RATING_WIDTH) << "ТЕКУЩАЯ ОЦЕНКА"
         << "\n";
 
     int total_width = NUM_WIDTH + FULLNAME_WIDTH + DEPARTMENT_WIDTH + RATING_WIDTH;
@@ -972,7 +1496,7 @@ void Application::hr_calculate_performance() {
             rating_str += "/100";
         }
         else {
-            rating_str = " ";
+            rating_str = "НЕ ОЦЕНЕН";
         }
 
         string fullname = emp->fullname();
@@ -997,7 +1521,7 @@ void Application::hr_calculate_performance() {
 
     int choice;
     while (true) {
-        cout << "     (0 - ): ";
+        cout << "Введите номер сотрудника для расчета (0 - отмена): ";
         string input;
         getline(cin, input);
 
@@ -1005,22 +1529,22 @@ void Application::hr_calculate_performance() {
             choice = stoi(input);
 
             if (choice == 0) {
-                cout << " .\n";
+                cout << "Отмена расчета.\n";
                 return;
             }
             if (choice >= 1 && choice <= static_cast<int>(employees.size())) {
                 break;
             }
             else {
-                cout << " . ,     (1-"
+                cout << "Неверный номер. Пожалуйста, выберите номер из списка (1-"
                     << employees.size() << ").\n";
             }
         }
         catch (const invalid_argument&) {
-            cout << ":    ( ).\n";
+            cout << "Ошибка: введите корректный номер (целое число).\n";
         }
         catch (const out_of_range&) {
-            cout << ":    .\n";
+            cout << "Ошибка: введенное число слишком большое.\n";
         }
     }
 
@@ -1029,135 +1553,111 @@ void Application::hr_calculate_performance() {
     User* employee = store_->get_employee(username);
 
     if (!employee) {
-        cout << ":   .\n";
+        cout << "Ошибка: сотрудник не найден.\n";
         return;
     }
 
     cout << "\n";
     printHorizontalLine('=', 80);
-    cout << "|" << centerAlign(" : " + employee->fullname(), 78) << "|\n";
-    cout << "|" << centerAlign(": " + username + " | : " + employee->department(), 78) << "|\n";
+    cout << "|" << centerAlign("ВЫБРАН СОТРУДНИК: " + employee->fullname(), 78) << "|\n";
+    cout << "|" << centerAlign("ЛОГИН: " + username + " | ОТДЕЛ: " + employee->department(), 78) << "|\n";
     printHorizontalLine('=', 80);
 
-    // ------------------   ------------------
+    // ------------------ РАСЧЕТ ЭФФЕКТИВНОСТИ ------------------
 
     string department = employee->department();
-    string deptParamName = system_config_->getDepartmentParameterName(department);
+    DepartmentId dept_id = system_config_->getDepartmentId(department);
+    const string& deptParamName = system_config_->getDepartmentParameterName(dept_id);
 
-    cout << "\n : " << deptParamName << "\n\n";
+    cout << "\nСпециализированный параметр: " << deptParamName << "\n\n";
 
-    // 1.     
-    auto projects = project_store_->get_employee_projects(username);
-    if (projects.empty()) {
-        cout << "    .\n";
-        cout << ": / ( )\n";
+    // 1. Получаем информацию о проектах сотрудника
+    ProjectActivity activity = project_store_->get_employee_activity(username);
+    if (activity.total_projects == 0) {
+        cout << "Сотрудник не участвует в проектах.\n";
+        cout << "Эффективность: Н/Д (недостаточно данных)\n";
         return;
     }
 
-    cout << "===   ===\n";
-    int total_projects = projects.size();
-    int active_projects = 0;
-    int completed_projects = 0;
-    int leadership_count = 0;
-
-    for (const auto& project : projects) {
-        if (project->status() == "" || project->status() == "") {
-            active_projects++;
-        }
-        else if (project->status() == "" || project->status() == "") {
-            completed_projects++;
-        }
-
-        //   
-        auto all_emp_projects = project_store_->all_employee_projects();
-        for (const auto& emp_proj : all_emp_projects) {
-            if (emp_proj->username() == username &&
-                emp_proj->project_name() == project->name()) {
-                string role = emp_proj->role();
-                if (role == "" || role == "" ||
-                    role == "" || role == "" ||
-                    role == " " || role == " ") {
-                    leadership_count++;
-                }
-                break;
-            }
-        }
-    }
+    cout << "=== Анализ проектов ===\n";
+    int total_projects = activity.total_projects;
+    int active_projects = activity.active_projects;
+    int completed_projects = activity.completed_projects;
+    int leadership_count = activity.leadership_count;
 
-    cout << " : " << total_projects << "\n";
-    cout << " : " << active_projects << "\n";
-    cout << " : " << completed_projects << "\n";
-    cout << "   : " << leadership_count << "\n\n";
+    cout << "Всего проектов: " << total_projects << "\n";
+    cout << "Активных проектов: " << active_projects << "\n";
+    cout << "Завершенных проектов: " << completed_projects << "\n";
+    cout << "Проектов с руководящей ролью: " << leadership_count << "\n\n";
 
-    // 2.       
-    cout << "===     ===\n";
+    // 2. Запрашиваем данные для расчета с учетом отдела
+    cout << "=== Введите данные для расчета ===\n";
 
     double departmentScore = 0;
     while (true) {  
         try {
-            cout << " " << deptParamName << " (0-100): ";
+            cout << "Оценка " << deptParamName << " (0-100): ";
             string input;
             getline(cin, input);
             departmentScore = stod(input);
-            if (departmentScore >= 0 && departmentScore <= 100) {
+            if (is_valid_score(departmentScore)) {
                 break;
             }
             else {
-                cout << ":     0  100\n";
+                cout << "Ошибка: оценка должна быть от 0 до 100\n";
             }
         }
         catch (const invalid_argument&) {
-            cout << ":   \n";
+            cout << "Ошибка: введите корректное число\n";
         }
         catch (const out_of_range&) {
-            cout << ":    \n";
+            cout << "Ошибка: введенное число слишком большое\n";
         }
         catch (...) {
-            cout << ":  \n";
+            cout << "Ошибка: введите число\n";
         }
     }
 
-    //     
-    string departmentLower = department;
-    transform(departmentLower.begin(), departmentLower.end(), departmentLower.begin(),
-        [](unsigned char c) { return tolower(c); });
-
-    if (departmentLower.find("") != string::npos || departmentLower.find("dev") != string::npos) {
-        cout << ":    :\n";
-        cout << "-   \n";
-        cout << "-   \n";
-        cout << "-    \n";
-    }
-    else if (departmentLower.find("") != string::npos || departmentLower.find("design") != string::npos) {
-        cout << ":   :\n";
-        cout << "-  -\n";
-        cout << "-  \n";
-        cout << "-  \n";
-    }
-    else if (departmentLower.find("") != string::npos || departmentLower.find("marketing") != string::npos) {
-        cout << ": ROI   :\n";
-        cout << "-   \n";
-        cout << "-   \n";
-        cout << "-   \n";
-    }
-    else if (departmentLower.find("") != string::npos || departmentLower.find("sales") != string::npos) {
-        cout << ":    :\n";
-        cout << "-   \n";
-        cout << "-  \n";
-        cout << "-  \n";
-    }
-    else if (departmentLower.find("") != string::npos || departmentLower.find("support") != string::npos) {
-        cout << ":    :\n";
-        cout << "-    \n";
-        cout << "-   \n";
-        cout << "-  \n";
-    }
-    else if (departmentLower.find("qa") != string::npos ||
-        departmentLower.find("") != string::npos) {
-        cout << ":    :\n";
-        cout << "-    \n";
-        cout << "-  -\n";
-        cout << "-  -\n";
+    // Примеры подсказок для разных отделов
+    switch (dept_id) {
+    case DepartmentId::DEVELOPMENT:
+        cout << "Подсказка: качество кода оценивается по:\n";
+        cout << "- Количество критических багов\n";
+        cout << "- Соблюдение стандартов кодирования\n";
+        cout << "- Эффективность и читаемость кода\n";
+        break;
+    case DepartmentId::DESIGN:
+        cout << "Подсказка: креативность оценивается по:\n";
+        cout << "- Уникальность дизайн-решений\n";
+        cout << "- Соответствие трендам\n";
+        cout << "- Визуальная привлекательность\n";
+        break;
+    case DepartmentId::MARKETING:
+        cout << "Подсказка: ROI кампаний оценивается по:\n";
+        cout << "- Возврат на инвестиции\n";
+        cout << "- Эффективность рекламных кампаний\n";
+        cout << "- Привлечение новых клиентов\n";
+        break;
+    case DepartmentId::SALES:
+        cout << "Подсказка: конверсия продаж оценивается по:\n";
+        cout << "- Процент успешных сделок\n";
+        cout << "- Объем продаж\n";
+        cout << "- Удержание клиентов\n";
+        break;
+    case DepartmentId::SUPPORT:
+        cout << "Подсказка: удовлетворенность клиентов оценивается по:\n";
+        cout << "- Оценки клиентов после обращений\n";
+        cout << "- Скорость решения проблем\n";
+        cout << "- Профессионализм общения\n";
+        break;
+    case DepartmentId::QA:
+        cout << "Подсказка: обнаружение багов оценивается по:\n";
+        cout << "- Количество найденных критических багов\n";
+        cout << "- Эффективность тест-кейсов\n";
+        cout << "- Качество баг-репортов\n";
+        break;
+    default:
+        break;
     }
 
     cout << "\n";
@@ -1165,130 +1665,267 @@ void Application::hr_calculate_performance() {
     double teamworkScore = 0;
     while (true) {
         try {
-            cout << "   (0-100): ";
+            cout << "Оценка командной работы (0-100): ";
             string input;
             getline(cin, input);
             teamworkScore = stod(input);
 
-            if (teamworkScore >= 0 && teamworkScore <= 100) {
+            if (is_valid_score(teamworkScore)) {
                 break;
             }
             else {
-                cout << ":     0  100\n";
+                cout << "Ошибка: оценка должна быть от 0 до 100\n";
             }
         }
         catch (const invalid_argument&) {
-            cout << ":   \n";
+            cout << "Ошибка: введите корректное число\n";
         }
         catch (const out_of_range&) {
-            cout << ":    \n";
+            cout << "Ошибка: введенное число слишком большое\n";
         }
         catch (...) {
-            cout << ":  \n";
+            cout << "Ошибка: введите число\n";
         }
 
     }
 
-    // 3.       
-    double tasksScore = 0;
-    if (total_projects > 0) {
-        double completionRate = (static_cast<double>(completed_projects) / total_projects) * 100;
-        double leadershipBonus = leadership_count * 10;
-        double activityBonus = (static_cast<double>(active_projects) / total_projects) * 20;
-        tasksScore = min(100.0, completionRate + leadershipBonus + activityBonus);
+    // 3. Проверяем данные и рассчитываем оценку выполненных задач на основе проектов
+    PerformanceInput performance;
+    string error;
+    if (!prepare_performance(*employee, departmentScore, teamworkScore, performance, error)) {
+        cout << "Ошибка: " << error << "\n";
+        return;
     }
+    double tasksScore = performance.tasks_score;
 
-    cout << "\n===    '" << department << "' ===\n";
-    cout << " " << deptParamName << ": " << system_config_->getDepartmentWeight(department) << "%\n";
-    cout << "  : " << system_config_->getTeamworkWeight() << "%\n";
-    cout << "  : " << system_config_->getTasksWeight() << "%\n";
+    cout << "\n=== Коэффициенты для отдела '" << department << "' ===\n";
+    cout << "Вес " << deptParamName << ": " << system_config_->getDepartmentWeight(dept_id) << "%\n";
+    cout << "Вес командной работы: " << system_config_->getTeamworkWeight() << "%\n";
+    cout << "Вес выполненных задач: " << system_config_->getTasksWeight() << "%\n";
 
-    if (!system_config_->validateDepartmentWeights(department)) {
-        cout << ":     '" << department << "'   100%!\n";
-        cout << "     .\n";
+    if (!system_config_->validateDepartmentWeights(dept_id)) {
+        cout << "Внимание: сумма весов для отдела '" << department << "' не равна 100%!\n";
+        cout << "Рекомендуется настроить параметры в меню администратора.\n";
     }
 
-    cout << "\n===   ===\n";
+    cout << "\n=== Результаты расчета ===\n";
 
-    //     
+    // Округляем до сотых для вывода
     cout << deptParamName << ": " << fixed << setprecision(2) << departmentScore << "/100\n";
-    cout << "  : " << fixed << setprecision(2) << teamworkScore << "/100\n";
-    cout << "  : " << fixed << setprecision(2) << tasksScore << "/100 (  "
-        << total_projects << " )\n";
-
-    // 4.      
-    double finalScore = system_config_->calculatePerformanceForDepartment(
-        department,
-        departmentScore,
-        teamworkScore,
-        tasksScore
-    );
-
-    //     
-    finalScore = round(finalScore * 100) / 100;
-
-    cout << "\n===   ===\n";
-    cout << " : " << fixed << setprecision(2) << finalScore << "/100\n";
-    system_config_->savePerformanceScore(username, finalScore);
-    cout << "   .\n";
+    cout << "Оценка командной работы: " << fixed << setprecision(2) << teamworkScore << "/100\n";
+    cout << "Оценка выполненных задач: " << fixed << setprecision(2) << tasksScore << "/100 (на основе "
+        << total_projects << " проектов)\n";
 
-    //      (  )
+    // 4. Рассчитываем итоговую эффективность с учетом отдела (округляется до сотых)
+    double finalScore = save_performance(username, performance);
+
+    cout << "\n=== ИТОГОВАЯ ЭФФЕКТИВНОСТЬ ===\n";
+    cout << "Общий балл: " << fixed << setprecision(2) << finalScore << "/100\n";
+    cout << "Оценка сохранена в системе.\n";
+
+    // Определяем уровень с учетом отдела (используем округленное значение)
     string level;
     string recommendations;
 
     if (finalScore >= 90) {
-        level = "";
-        recommendations = "  /";
+        level = "ЭКСПЕРТ";
+        recommendations = "Кандидат на повышение/премию";
     }
     else if (finalScore >= 75) {
-        level = " ";
-        recommendations = "  ";
+        level = "ОПЫТНЫЙ СПЕЦИАЛИСТ";
+        recommendations = "Стабильно высокие показатели";
     }
     else if (finalScore >= 60) {
-        level = " ";
-        recommendations = " ";
+        level = "КОМПЕТЕНТНЫЙ СОТРУДНИК";
+        recommendations = "Соответствует ожиданиям";
     }
     else if (finalScore >= 40) {
-        level = " ";
-        recommendations = " ";
+        level = "НАЧИНАЮЩИЙ СПЕЦИАЛИСТ";
+        recommendations = "Требуется наставничество";
     }
     else {
-        level = "  ";
-        recommendations = "  ";
+        level = "ТРЕБУЕТСЯ ПОВЫШЕНИЕ КВАЛИФИКАЦИИ";
+        recommendations = "Необходим план развития";
     }
 
-    cout << ": " << level << "\n";
-    cout << ": " << recommendations << "\n";
+    cout << "Уровень: " << level << "\n";
+    cout << "Рекомендации: " << recommendations << "\n";
 
     cout << resetiosflags(ios_base::floatfield);
 }
 
+bool Application::is_valid_score(double score) {
+    // NaN проходит любое сравнение с границами, поэтому сначала isfinite
+    return isfinite(score) && score >= 0 && score <= 100;
+}
+
+double Application::round_score(double score) {
+    return round(score * 100) / 100;
+}
+
+bool Application::prepare_performance(const User& employee, double departmentScore, double teamworkScore,
+    PerformanceInput& input, string& error) const {
+    if (!is_valid_score(departmentScore) || !is_valid_score(teamworkScore)) {
+        error = "оценка должна быть от 0 до 100";
+        return false;
+    }
+
+    // Без проектов оценка не выставляется
+    ProjectActivity activity = project_store_->get_employee_activity(employee.username());
+    if (activity.total_projects == 0) {
+        error = "сотрудник не участвует в проектах";
+        return false;
+    }
+
+    double tasksScore = activity.tasks_score();
+    if (!isfinite(tasksScore)) {
+        error = "не удалось рассчитать оценку задач сотрудника";
+        return false;
+    }
+
+    input.department = system_config_->getDepartmentId(employee.department());
+    input.department_score = departmentScore;
+    input.teamwork_score = teamworkScore;
+    input.tasks_score = tasksScore;
+    return true;
+}
+
+double Application::save_performance(const string& username, const PerformanceInput& input) {
+    double finalScore = round_score(system_config_->calculatePerformanceForDepartment(
+        input.department, input.department_score, input.teamwork_score, input.tasks_score));
+    system_config_->savePerformanceScore(username, finalScore);
+    return finalScore;
+}
+
+void Application::hr_batch_calculate_performance() {
+    cout << "\n=== ПАКЕТНЫЙ РАСЧЕТ ЭФФЕКТИВНОСТИ ===\n";
+    cout << "Формат файла: логин|оценка_отдела|оценка_командной_работы (по строке на сотрудника)\n";
+    cout << "Оценка выполненных задач рассчитывается по проектам сотрудника.\n\n";
+
+    string input_file = input_line("Путь к файлу с оценками: ");
+    batch_calculate_performance(input_file);
+}
+
+// Оценки всех строк собираются в памяти и дописываются в журнал оценок за одно открытие файла
+void Application::batch_calculate_performance(const string& input_file) {
+    STAT_SCOPE(stat, "Application::batch_calculate_performance");
+    MappedFile file;
+    if (!file.open(input_file)) {
+        cout << "Ошибка: не удалось открыть файл '" << input_file << "'.\n";
+        return;
+    }
+
+    const size_t MAX_REPORTED_ERRORS = 20;
+    auto start = chrono::steady_clock::now();
+
+    // Строки файла собираются в таблицу, итоговые оценки считаются одним вызовом
+    vector<string> usernames;
+    ScoreTable table;
+    size_t line_number = 0;
+    size_t skipped = 0;
+
+    auto skip = [&](const string& reason) {
+        if (++skipped <= MAX_REPORTED_ERRORS) {
+            cout << "Строка " << line_number << ": " << reason << "\n";
+        }
+    };
+
+    file.for_each_line([&](string_view line) {
+        ++line_number;
+        line = trim(line);
+        if (line.empty() || line.front() == '#') return;
+
+        string_view fields[3];
+        size_t count = split_fields(line, '|', fields, 3);
+
+        double departmentScore = 0;
+        double teamworkScore = 0;
+        if (count < 3 ||
+            !parse_decimal(fields[1], departmentScore) || !parse_decimal(fields[2], teamworkScore)) {
+            skip("неверный формат строки");
+            return;
+        }
+
+        // Логин приводится к нижнему регистру, как в меню и в командном режиме
+        User* employee = store_->get_employee(login_of(fields[0]));
+        if (!employee) {
+            skip("сотрудник '" + string(fields[0]) + "' не найден");
+            return;
+        }
+
+        // Те же проверки, что при ручном расчете
+        PerformanceInput performance;
+        string error;
+        if (!prepare_performance(*employee, departmentScore, teamworkScore, performance, error)) {
+            skip("сотрудник '" + employee->username() + "': " + error);
+            return;
+        }
+
+        usernames.push_back(employee->username());
+        table.add(performance.department,
+            performance.department_score,
+            performance.teamwork_score,
+            performance.tasks_score);
+    });
+
+    system_config_->calculatePerformanceBulk(table);
+    vector<pair<string, double>> scores;
+    scores.reserve(usernames.size());
+    for (size_t i = 0; i < usernames.size(); ++i) {
+        // score_bulk уже округляет до сотых, как save_performance
+        scores.emplace_back(move(usernames[i]), table.final_scores[i]);
+    }
+
+    auto computed = chrono::steady_clock::now();
+    system_config_->setPerformanceScores(scores);
+    auto finished = chrono::steady_clock::now();
+
+    double compute_ms = chrono::duration<double, milli>(computed - start).count();
+    double total_ms = chrono::duration<double, milli>(finished - start).count();
+
+    if (skipped > MAX_REPORTED_ERRORS) {
+        cout << "... и еще " << (skipped - MAX_REPORTED_ERRORS) << " пропущенных строк\n";
+    }
+
+    cout << "\n=== ИТОГИ ПАКЕТНОГО РАСЧЕТА ===\n";
+    cout << "Строк в файле: " << line_number << "\n";
+    cout << "Оценено сотрудников: " << scores.size() << "\n";
+    cout << "Пропущено строк: " << skipped << "\n";
+    cout << fixed << setprecision(2);
+    cout << "Расчет: " << compute_ms << " мс, запись: " << (total_ms - compute_ms) << " мс\n";
+    if (total_ms > 0) {
+        cout << "Производительность: " << setprecision(0) << (scores.size() / (total_ms / 1000.0))
+            << " оценок/с\n";
+    }
+    cout << resetiosflags(ios_base::floatfield) << setprecision(6);
+}
+
 void Application::hr_session(HRManagerUser& hr) {
     
     bool in_session = true;
     while (in_session) {
         system("cls");
-        cout << "\n---  HR- ---\n";
-        cout << "1)   \n";
-        cout << "2)  \n";
-        cout << "3)  \n";
+        cout << "\n--- Меню HR-менеджера ---\n";
+        cout << "1) Просмотреть мой профиль\n";
+        cout << "2) Управление проектами\n";
+        cout << "3) Управление сотрудниками\n";
         
-        cout << "0) \n";
-        int cmd = input_int(" : ");
+        cout << "0) Выход\n";
+        int cmd = input_int("Ваш выбор: ");
         switch (cmd) {
         case 1:
             hr.view_profile();
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         case 2:
             hr_manage_projects(hr);
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         case 3:
             hr_manage_employees(hr);
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         
@@ -1296,11 +1933,11 @@ void Application::hr_session(HRManagerUser& hr) {
         
         case 0:
             in_session = false;
-            cout << "HR-   ...\n";
+            cout << "HR-менеджер вышел из системы...\n";
             Sleep(1000);
             break;
         default:
-            cout << " .\n";
+            cout << "Неверный выбор.\n";
             Sleep(1000);
         }
     }
@@ -1310,19 +1947,19 @@ void Application::hr_manage_projects(HRManagerUser& hr) {
     system("cls");
     bool in_menu = true;
     while (in_menu) {
-        cout << "\n---   ---\n";
-        cout << "1)   \n";
-        cout << "2)   \n";
-        cout << "3)    \n";
-        cout << "4)   \n";
-        cout << "5)  \n";
-        cout << "6)  \n";
-        cout << "7)  \n";
-        cout << "8)    \n";
-        cout << "9)  \n";
-        cout << "0)    HR\n";
-
-        int choice = input_int(" : ");
+        cout << "\n--- Управление проектами ---\n";
+        cout << "1) Добавить новый проект\n";
+        cout << "2) Просмотреть все проекты\n";
+        cout << "3) Назначить сотрудника на проект\n";
+        cout << "4) Просмотреть детали проекта\n";
+        cout << "5) Редактировать проект\n";
+        cout << "6) Удалить проект\n";
+        cout << "7) Поиск проектов\n";
+        cout << "8) Фильтр проектов по статусу\n";
+        cout << "9) Сортировка проектов\n";
+        cout << "0) Вернуться в меню HR\n";
+
+        int choice = input_int("Выберите действие: ");
         switch (choice) {
         case 1:
             hr_add_project();
@@ -1355,7 +1992,7 @@ void Application::hr_manage_projects(HRManagerUser& hr) {
             in_menu = false;
             break;
         default:
-            cout << " .\n";
+            cout << "Неверный выбор.\n";
         }
     }
 }
@@ -1365,140 +2002,245 @@ void Application::employee_session(EmployeeUser& emp) {
     bool in_session = true;
     while (in_session) {
         system("cls");
-        cout << "\n---   ---\n";
-        cout << "1)   \n";
-        cout << "2)   \n";
-        cout << "3)   \n";
-        cout << "4)    \n";
-        cout << "5)   \n";
-        cout << "6) \n";
-        int cmd = input_int(" : ");
+        cout << "\n--- Меню сотрудника ---\n";
+        cout << "1) Посмотреть мой профиль\n";
+        cout << "2) Посмотреть мои проекты\n";
+        cout << "3) Посмотреть мой отчет\n";
+        cout << "4) Посмотреть мою оценку эффективности\n";
+        cout << "5) Посмотреть мой рейтинг\n";
+        cout << "6) Выйти\n";
+        int cmd = input_int("Ваш выбор: ");
         switch (cmd) {
         case 1:
             emp.view_profile();
             employee_view_my_projects(emp);
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         case 2:
             employee_view_my_projects(emp);
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         case 3:
             hr_view_saved_report(emp.username());
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         case 4:
             show_employee_performance_score(emp.username());
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         case 5:
             show_my_rating(emp.username());
-            cout << " Enter  ...";
+            cout << "Нажмите Enter для продолжения...";
             cin.ignore();
             break;
         
         case 6:
             in_session = false;
-            cout << "   ...\n";
+            cout << "Сотрудник вышел из системы...\n";
             Sleep(1000);
             break;
         default:
-            cout << " .\n";
+            cout << "Неверный выбор.\n";
             Sleep(1000);
         }
     }
 }
 
 void Application::show_employee_performance_score(const string& username) {
-    cout << "\n===    ===\n";
+    cout << "\n=== ВАША ОЦЕНКА ЭФФЕКТИВНОСТИ ===\n";
 
     if (system_config_->hasPerformanceScore(username)) {
         double score = system_config_->getPerformanceScore(username);
-        cout << " : " << fixed << setprecision(1) << score << "/100\n";
+        cout << "Текущая оценка: " << fixed << setprecision(1) << score << "/100\n";
 
-        //  
+        // Определяем уровень
         string level;
-        if (score >= 90) level = "";
-        else if (score >= 75) level = "";
-        else if (score >= 60) level = "";
-        else if (score >= 40) level = " ";
-        else level = "";
+        if (score >= 90) level = "ОТЛИЧНО";
+        else if (score >= 75) level = "ХОРОШО";
+        else if (score >= 60) level = "УДОВЛЕТВОРИТЕЛЬНО";
+        else if (score >= 40) level = "ТРЕБУЕТСЯ УЛУЧШЕНИЕ";
+        else level = "НЕДОСТАТОЧНО";
 
-        cout << ": " << level << "\n";
-        cout << " : " << now_string() << "\n";
+        cout << "Уровень: " << level << "\n";
+        cout << "Оценка обновлена: " << now_string() << "\n";
     }
     else {
-        cout << "     HR-.\n";
-        cout << "  HR   .\n";
+        cout << "Оценка эффективности еще не рассчитана HR-менеджером.\n";
+        cout << "Обратитесь к HR для проведения оценки.\n";
     }
 }
 
-//      :
+// Добавим метод для просмотра сохраненного отчета:
 void Application::hr_view_saved_report(const string& username) {
+    // Текст последней версии не копируется: она хранится в архиве несжатой и
+    // просматривается прямо в отображенном файле
+    MappedFile mapping;
+    string buffer;
+    string_view text;
+    ReportVersionInfo info;
+    if (report_archive_.open_version(username, report_archive_.version_count(username), mapping, buffer, text, &info)) {
+        view_report("ВАШ ОТЧЕТ HR от " + info.timestamp, text);
+
+        size_t count = info.number;
+        while (count > 1) {
+            cout << "Версий в архиве: " << count << ". Номер версии для просмотра (Enter - выход): ";
+            string choice;
+            if (!getline(cin, choice)) break;
+            choice = trim(choice);
+            if (choice.empty()) break;
+
+            size_t number = 0;
+            try {
+                number = stoul(choice);
+            }
+            catch (...) {
+                cout << "Неверный номер версии.\n";
+                continue;
+            }
 
-    vector<string> report_files;
-    string search_pattern = "HR_REPORT_" + username + "_*.txt";
+            if (!report_archive_.open_version(username, number, mapping, buffer, text, &info)) {
+                cout << "Версия " << choice << " не найдена или повреждена.\n";
+                continue;
+            }
+            view_report("ОТЧЕТ HR (версия " + to_string(info.number) + " от " + info.timestamp + ")", text);
+        }
+        return;
+    }
+
+    // Отчеты, сохраненные до появления архива, есть только в виде файлов
+    const ReportFileEntry* latest = report_catalog_.latest(username, text_report_.file_extension());
+    // Файл могли удалить вручную - тогда берем предыдущий из каталога
+    while (latest && !filesystem::exists(latest->filename)) {
+        string missing = latest->filename;
+        report_catalog_.forget(username, missing);
+        latest = report_catalog_.latest(username, text_report_.file_extension());
+    }
 
-    WIN32_FIND_DATAA findFileData;
-    HANDLE hFind = FindFirstFileA(search_pattern.c_str(), &findFileData);
+    if (!latest) {
+        cout << "\n=== ОТЧЕТ НЕ НАЙДЕН ===\n";
+        cout << "Для вас еще не создан отчет HR-менеджером.\n";
+        cout << "Отчет будет доступен после его генерации HR-менеджером.\n";
+        return;
+    }
 
-    if (hFind == INVALID_HANDLE_VALUE) {
-        cout << "\n===    ===\n";
-        cout << "      HR-.\n";
-        cout << "      HR-.\n";
+    if (!mapping.open(latest->filename)) {
+        cout << "Ошибка открытия файла отчета.\n";
         return;
     }
+    view_report("ВАШ ОТЧЕТ HR: " + latest->filename, mapping.view());
+}
 
-    string latest_file;
-    SYSTEMTIME latest_time = { 0 };
+// Страница за страницей: начала страниц запоминаются по мере листания, сам текст
+// не копируется, поэтому отчет любого размера просматривается целиком
+void Application::view_report(const string& title, string_view text) {
+    ReportPager pager(text);
+    size_t page = 0;
+    string query;
+    size_t last_match = string_view::npos;
+    string status;
 
-    do {
-        if (!(findFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
-            string filename = findFileData.cFileName;
-            report_files.push_back(filename);
+    for (;;) {
+        size_t pages = pager.page_count();
+        cout << "\n";
+        printHorizontalLine('=', 80);
+        cout << "|" << centerAlign(title + " (стр. " + to_string(page + 1) + " из " + to_string(pages) + ")", 78) << "|\n";
+        printHorizontalLine('=', 80);
+
+        string_view body = pager.page(page);
+        cout.write(body.data(), static_cast<streamsize>(body.size()));
+        if (!body.empty() && body.back() != '\n') cout << "\n";
+        printHorizontalLine('-', 80);
+
+        if (!status.empty()) {
+            cout << status << "\n";
+            status.clear();
         }
-    } while (FindNextFileA(hFind, &findFileData) != 0);
+        cout << "[Enter] далее  [p] назад  [номер] страница  [s] разделы  [/текст] поиск  [q] выход: ";
 
-    FindClose(hFind);
+        string command;
+        if (!getline(cin, command)) return;
+        command = trim(command);
 
-    if (report_files.empty()) {
-        cout << "\n===    ===\n";
-        cout << "      HR-.\n";
-        return;
-    }
-    string latest_report = report_files[0];
-    for (const auto& file : report_files) {
-        if (file > latest_report) {
-            latest_report = file;
+        if (command.empty() || command == "n") {
+            // С последней страницы Enter закрывает просмотр
+            if (page + 1 >= pages) return;
+            ++page;
         }
-    }
+        else if (command == "q") {
+            return;
+        }
+        else if (command == "p") {
+            if (page > 0) --page;
+        }
+        else if (command == "s") {
+            vector<ReportSection> sections = pager.sections();
+            if (sections.empty()) {
+                status = "В отчете нет разделов.";
+                continue;
+            }
+            for (size_t i = 0; i < sections.size(); ++i) {
+                cout << (i + 1) << ". " << sections[i].title
+                    << " (стр. " << pager.page_of_line(sections[i].line) + 1 << ")\n";
+            }
+            cout << "Номер раздела (Enter - отмена): ";
+            string choice;
+            if (!getline(cin, choice)) return;
+            choice = trim(choice);
+            if (choice.empty()) continue;
+
+            size_t number = 0;
+            try {
+                number = stoul(choice);
+            }
+            catch (...) {
+            }
+            if (number == 0 || number > sections.size()) {
+                status = "Неверный номер раздела.";
+                continue;
+            }
+            page = pager.page_of_line(sections[number - 1].line);
+        }
+        else if (command[0] == '/') {
+            // "/" без текста - следующее совпадение прежнего запроса
+            bool repeat = command.size() == 1;
+            if (!repeat) query = command.substr(1);
+            if (query.empty()) {
+                status = "Введите текст для поиска: /текст";
+                continue;
+            }
 
-    cout << "\n";
-    printHorizontalLine('=', 80);
-    cout << "|" << centerAlign("  HR: " + latest_report, 78) << "|\n";
-    printHorizontalLine('=', 80);
+            size_t from = repeat && last_match != string_view::npos
+                ? last_match + 1
+                : static_cast<size_t>(pager.page(page).data() - text.data());
+            size_t match = pager.find(query, from);
+            if (match == string_view::npos && from > 0) match = pager.find(query, 0);
 
-    ifstream report_file(latest_report);
-    if (report_file) {
-        string line;
-        int line_count = 0;
-        while (getline(report_file, line) && line_count < 100) {
-            cout << line << "\n";
-            line_count++;
+            if (match == string_view::npos) {
+                status = "\"" + query + "\" не найдено.";
+                continue;
+            }
+            last_match = match;
+            size_t line = pager.line_of_offset(match);
+            page = pager.page_of_line(line);
+            status = "\"" + query + "\" найдено в строке " + to_string(line + 1) + ". [/] - следующее.";
         }
-        if (line_count >= 100) {
-            cout << string(80, '.') << "\n";
-            cout << "  100  .\n";
+        else {
+            size_t number = 0;
+            try {
+                number = stoul(command);
+            }
+            catch (...) {
+            }
+            if (number == 0 || number > pages) {
+                status = "Неизвестная команда.";
+                continue;
+            }
+            page = number - 1;
         }
-        printHorizontalLine('=', 80);
-        report_file.close();
-    }
-    else {
-        cout << "   .\n";
     }
 }
 
@@ -1506,44 +2248,36 @@ void Application::employee_view_my_projects(EmployeeUser& emp) {
     auto projects = project_store_->get_employee_projects(emp.username());
 
     if (projects.empty()) {
-        cout << "      .\n";
+        cout << "Вы не участвуете ни в одном проекте.\n";
         return;
     }
 
-    cout << "\n---   (" << projects.size() << ") ---\n";
+    cout << "\n--- Ваши проекты (" << projects.size() << ") ---\n";
     for (size_t i = 0; i < projects.size(); ++i) {
         const auto& project = projects[i];
-        string role = "";
-        auto all_emp_projects = project_store_->all_employee_projects();
-        for (const auto& emp_proj : all_emp_projects) {
-            if (emp_proj->username() == emp.username() &&
-                emp_proj->project_name() == project->name()) {
-                role = emp_proj->role();
-                break;
-            }
-        }
+        const string* role = project_store_->role_of(emp.username(), project->name());
 
         cout << (i + 1) << ") " << project->name()
-            << "\n   : " << project->description()
-            << "\n   : " << project->status()
-            << "\n    : " << role
-            << "\n     : " << project->created_date() << "\n\n";
+            << "\n   Описание: " << project->description()
+            << "\n   Статус: " << project->status()
+            << "\n   Ваша роль: " << (role ? *role : "Участник")
+            << "\n   Дата создания проекта: " << project->created_date() << "\n\n";
     }
 }
 
 void Application::show_employees_sorted_by_name() {
-    cout << "\n===   (  ) ===\n\n";
+    cout << "\n=== СПИСОК СОТРУДНИКОВ (сортировка по ФИО) ===\n\n";
     auto employees = store_->get_employees_sorted_by_name(true);
 
     if (employees.empty()) {
-        cout << "  .\n";
+        cout << "Сотрудников не найдено.\n";
         return;
     }
 
-    cout << left << setw(30) << ""
-        << setw(25) << ""
-        << setw(15) << ""
-        << setw(15) << " " << "\n";
+    cout << left << setw(30) << "ФИО"
+        << setw(25) << "Должность"
+        << setw(15) << "Отдел"
+        << setw(15) << "Дата найма" << "\n";
 
     cout << string(105, '=') << "\n";
 
@@ -1554,25 +2288,25 @@ void Application::show_employees_sorted_by_name() {
             << setw(15) << employee->department()
             << setw(15) << now_string() << "\n";
     }
-    cout << "\n : " << employees.size() << "\n";
+    cout << "\nВсего сотрудников: " << employees.size() << "\n";
 }
 
-//     
+// Показать рейтинг сотрудников по эффективности
 void Application::show_employees_rating() {
-    cout << "\n===     ===\n\n";
+    cout << "\n=== РЕЙТИНГ СОТРУДНИКОВ ПО ЭФФЕКТИВНОСТИ ===\n\n";
 
     auto employees_with_ratings = store_->get_employees_sorted_by_rating(system_config_.get());
 
     if (employees_with_ratings.empty()) {
-        cout << "  .\n";
+        cout << "Сотрудников не найдено.\n";
         return;
     }
     
-    cout << left << setw(5) << ""
-        << setw(30) << ""
-        << setw(15) << ""
-        << setw(15) << ""
-        << setw(20) << "" << "\n";
+    cout << left << setw(5) << "№"
+        << setw(30) << "ФИО"
+        << setw(15) << "Отдел"
+        << setw(15) << "Оценка"
+        << setw(20) << "Статус" << "\n";
 
     cout << string(95, '=') << "\n";
 
@@ -1590,11 +2324,11 @@ void Application::show_employees_rating() {
             total_rating += rating;
             if (rating > max_rating) max_rating = rating;
 
-            if (rating >= 90) status = "";
-            else if (rating >= 75) status = "";
-            else if (rating >= 60) status = "";
-            else if (rating >= 40) status = "";
-            else status = " ";
+            if (rating >= 90) status = "ЭКСПЕРТ";
+            else if (rating >= 75) status = "ОПЫТНЫЙ";
+            else if (rating >= 60) status = "КОМПЕТЕНТНЫЙ";
+            else if (rating >= 40) status = "НАЧИНАЮЩИЙ";
+            else status = "ТРЕБУЕТ РАЗВИТИЯ";
             cout << left << setw(5) << (i + 1)
                 << setw(30) << (employee->fullname().length() > 29 ?
                     employee->fullname().substr(0, 27) + ".." : employee->fullname())
@@ -1604,7 +2338,7 @@ void Application::show_employees_rating() {
                 << setw(20) << status << "\n";
         }
         else {
-            status = " ";
+            status = "НЕ ОЦЕНЕН";
             cout << left << setw(5) << (i + 1)
                 << setw(30) << (employee->fullname().length() > 29 ?
                     employee->fullname().substr(0, 27) + ".." : employee->fullname())
@@ -1616,87 +2350,128 @@ void Application::show_employees_rating() {
         
     }
 
-    // 
-    cout << "\n===  ===\n";
-    cout << " : " << employees_with_ratings.size() << "\n";
-    cout << ": " << rated_count << "\n";
-    cout << " : " << (employees_with_ratings.size() - rated_count) << "\n";
+    // Статистика
+    cout << "\n=== СТАТИСТИКА ===\n";
+    cout << "Всего сотрудников: " << employees_with_ratings.size() << "\n";
+    cout << "Оценено: " << rated_count << "\n";
+    cout << "Не оценено: " << (employees_with_ratings.size() - rated_count) << "\n";
 
     if (rated_count > 0) {
         double avg_rating = total_rating / rated_count;
         cout << fixed << setprecision(2);
-        cout << " : " << avg_rating << "\n";
-        cout << " : " << max_rating << "\n";
+        cout << "Средняя оценка: " << avg_rating << "\n";
+        cout << "Максимальная оценка: " << max_rating << "\n";
 
         if (rated_count > 1) {
-            cout << " 10%: " << (max_rating * 0.9) << "+ \n";
-            cout << " 25%: " << (max_rating * 0.75) << "+ \n";
-            cout << " 50%: " << (avg_rating) << " \n";
+            cout << "Лучшие 10%: " << (max_rating * 0.9) << "+ баллов\n";
+            cout << "Лучшие 25%: " << (max_rating * 0.75) << "+ баллов\n";
+            cout << "Средние 50%: " << (avg_rating) << "± баллов\n";
         }
     }
 
     cout << resetiosflags(ios_base::floatfield);
 }
 
-//   
+// Лидеры рейтинга в целом и по отделам, а также отстающие
+void Application::show_rating_leaders() {
+    int k = input_int("Сколько сотрудников показать в каждом списке: ");
+    if (k <= 0) {
+        cout << "Количество должно быть положительным.\n";
+        return;
+    }
+
+    auto print_list = [](const vector<pair<const User*, double>>& list) {
+        if (list.empty()) {
+            cout << "Оцененных сотрудников нет.\n";
+            return;
+        }
+        for (size_t i = 0; i < list.size(); ++i) {
+            const auto& [employee, rating] = list[i];
+            cout << left << setw(5) << (i + 1)
+                << setw(30) << (employee->fullname().length() > 29 ?
+                    employee->fullname().substr(0, 27) + ".." : employee->fullname())
+                << setw(15) << employee->department()
+                << fixed << setprecision(2) << rating << "\n";
+        }
+        cout << resetiosflags(ios_base::floatfield);
+    };
+
+    cout << "\n=== ЛУЧШИЕ СОТРУДНИКИ ===\n";
+    print_list(store_->get_top_rated(k, system_config_.get()));
+
+    cout << "\n=== ЛУЧШИЕ ПО ОТДЕЛАМ ===\n";
+    auto by_department = store_->get_top_rated_by_department(k, system_config_.get());
+    if (by_department.empty()) {
+        cout << "Оцененных сотрудников нет.\n";
+    }
+    for (const auto& [department, list] : by_department) {
+        cout << "\n-- " << department << " --\n";
+        print_list(list);
+    }
+
+    cout << "\n=== ТРЕБУЮТ ВНИМАНИЯ (наименьшие оценки) ===\n";
+    print_list(store_->get_bottom_rated(k, system_config_.get()));
+}
+
+// Показать мой рейтинг
 void Application::show_my_rating(const string& username) {
     User* user = store_->find_by_username(username);
     if (!user) {
-        cout << ":   .\n";
+        cout << "Ошибка: пользователь не найден.\n";
         return;
     }
 
-    cout << "\n===   ===\n\n";
+    cout << "\n=== МОЙ РЕЙТИНГ ===\n\n";
 
     auto [position, total] = store_->get_employee_rank(username, system_config_.get());
     double rating = system_config_->getPerformanceScore(username);
 
-    cout << ": " << user->fullname() << "\n";
-    cout << ": " << user->username() << "\n";
-    cout << ": " << user->department() << "\n";
+    cout << "Сотрудник: " << user->fullname() << "\n";
+    cout << "Логин: " << user->username() << "\n";
+    cout << "Отдел: " << user->department() << "\n";
 
     if (rating >= 0) {
         cout << fixed << setprecision(2);
-        cout << "\n : " << rating << "/100\n";
+        cout << "\nОценка эффективности: " << rating << "/100\n";
 
         if (position > 0) {
             double percentile = 100.0 - ((static_cast<double>(position - 1) / total) * 100);
 
-            cout << "  : " << position << "/" << total << "\n";
-            cout << ": " << fixed << setprecision(1) << percentile << "%\n";
+            cout << "Место в рейтинге: " << position << "/" << total << "\n";
+            cout << "Процент: " << fixed << setprecision(1) << percentile << "%\n";
 
             string level;
-            if (rating >= 90) level = "";
-            else if (rating >= 75) level = " ";
-            else if (rating >= 60) level = " ";
-            else if (rating >= 40) level = " ";
-            else level = "  ";
+            if (rating >= 90) level = "ЭКСПЕРТ";
+            else if (rating >= 75) level = "ОПЫТНЫЙ СПЕЦИАЛИСТ";
+            else if (rating >= 60) level = "КОМПЕТЕНТНЫЙ СОТРУДНИК";
+            else if (rating >= 40) level = "НАЧИНАЮЩИЙ СПЕЦИАЛИСТ";
+            else level = "ТРЕБУЕТСЯ ПОВЫШЕНИЕ КВАЛИФИКАЦИИ";
 
-            cout << ": " << level << "\n";
+            cout << "Уровень: " << level << "\n";
 
             if (position <= 1) {
-                cout << "     ! !\n";
+                cout << "Вы занимаете ПЕРВОЕ место в рейтинге! Поздравляем!\n";
             }
             else if (position <= 3) {
-                cout << "   -3 !  !\n";
+                cout << "Вы входите в ТОП-3 сотрудников! Отличный результат!\n";
             }
             else if (position <= total * 0.1) {
-                cout << "   -10%  !\n";
+                cout << "Вы входите в ТОП-10% сотрудников компании!\n";
             }
             else if (position <= total * 0.25) {
-                cout << "     !\n";
+                cout << "Вы входите в четверть лучших сотрудников!\n";
             }
             else if (position <= total * 0.5) {
-                cout << "   .\n";
+                cout << "Ваши показатели выше среднего.\n";
             }
             else {
-                cout << "   .    !\n";
+                cout << "Есть потенциал для роста. Продолжайте работать над собой!\n";
             }
         }
     }
     else {
-        cout << "\n    .\n";
-        cout << "   HR-   .\n";
+        cout << "\nВаша эффективность еще не рассчитана.\n";
+        cout << "Обратитесь к другому HR-менеджеру для проведения оценки.\n";
     }
 
     
@@ -1704,16 +2479,16 @@ void Application::show_my_rating(const string& username) {
     cout << resetiosflags(ios_base::floatfield);
 }
 
-// -----------   -----------
+// ----------- Административные утилиты -----------
 void Application::list_all_users() {
     auto all_users = store_->all_users();
 
     if (all_users.empty()) {
-        cout << "\n  .\n";
+        cout << "\nПользователи не найдены.\n";
         return;
     }
 
-    cout << "\n===   (" << all_users.size() << ") ===\n\n";
+    cout << "\n=== СПИСОК ПОЛЬЗОВАТЕЛЕЙ (" << all_users.size() << ") ===\n\n";
 
     const int NUM_WIDTH = 5;
     const int USERNAME_WIDTH = 20;
@@ -1722,11 +2497,11 @@ void Application::list_all_users() {
     const int ROLE_WIDTH = 15;
 
     cout << left
-        << setw(NUM_WIDTH) << ""
-        << setw(USERNAME_WIDTH) << ""
-        << setw(FULLNAME_WIDTH) << ""
-        << setw(DEPARTMENT_WIDTH) << ""
-        << setw(ROLE_WIDTH) << ""
+        << setw(NUM_WIDTH) << "№"
+        << setw(USERNAME_WIDTH) << "ЛОГИН"
+        << setw(FULLNAME_WIDTH) << "ФИО"
+        << setw(DEPARTMENT_WIDTH) << "ОТДЕЛ"
+        << setw(ROLE_WIDTH) << "РОЛЬ"
         << "\n";
 
     int total_width = NUM_WIDTH + USERNAME_WIDTH + FULLNAME_WIDTH + DEPARTMENT_WIDTH + ROLE_WIDTH;
@@ -1776,19 +2551,19 @@ void Application::assign_hr_role_flow() {
     }
 
     if (pending.empty()) {
-        cout << "     HR .\n";
+        cout << "Новых запросов на подтверждение роли HR нет.\n";
         return;
     }
 
-    cout << "    HR:\n";
+    cout << "Запросы на подтверждение роли HR:\n";
     for (size_t i = 0; i < pending.size(); ++i) {
         cout << (i + 1) << ") " << pending[i]->username()
             << " (" << pending[i]->fullname() << ")\n";
     }
 
-    int sel = input_int("    (0 - ): ");
+    int sel = input_int("Выберите пользователя для одобрения (0 - отмена): ");
     if (sel <= 0 || static_cast<size_t>(sel) > pending.size()) {
-        cout << "\n";
+        cout << "Отменено\n";
         return;
     }
 
@@ -1796,35 +2571,38 @@ void Application::assign_hr_role_flow() {
     const string target_username = target->username();
 
     if (store_->move_user_to_hr(target_username)) {
-        cout << " " << target_username
-            << "  HR.     .\n";
+        cout << "Пользователь " << target_username
+            << " теперь HR. Данные перемещены в отдельный файл.\n";
     }
     else {
-        cout << "    HR.\n";
+        cout << "Ошибка перемещения пользователя в HR.\n";
     }
 }
 
 
-// -----------   -----------
+// ----------- Управление сотрудниками -----------
 void Application::hr_manage_employees(HRManagerUser& hr) {
     system("cls");
     bool in_menu = true;
     while (in_menu) {
-        cout << "\n---   ---\n";
-        cout << "1)   \n";
-        cout << "2)   \n";
-        cout << "3)   \n";
-        cout << "4)   \n";
-        cout << "5)  \n";
-        cout << "6)  \n";
-        cout << "7)    \n"; 
-		cout << "8)    \n"; 
-        cout << "9)   \n";
-        cout << "10)    \n"; 
-        cout << "11)   \n"; 
-        cout << "0)    HR\n";
-
-        int choice = input_int(" : ");
+        cout << "\n--- Управление сотрудниками ---\n";
+        cout << "1) Добавить нового сотрудника\n";
+        cout << "2) Просмотреть всех сотрудников\n";
+        cout << "3) Просмотреть детали сотрудника\n";
+        cout << "4) Редактировать данные сотрудника\n";
+        cout << "5) Удалить сотрудника\n";
+        cout << "6) Поиск сотрудников\n";
+        cout << "7) Сортировка сотрудников по ФИО\n"; 
+		cout << "8) Назначить сотрудника на проект\n"; 
+        cout << "9) Рассчитать эффективность сотрудника\n";
+        cout << "10) Рейтинг сотрудников по эффективности\n"; 
+        cout << "11) Сгенерировать отчет сотрудника\n"; 
+        cout << "12) Пакетный расчет эффективности из файла\n";
+        cout << "13) Лидеры и отстающие рейтинга\n";
+        cout << "14) Сгенерировать отчеты по всем сотрудникам\n";
+        cout << "0) Вернуться в меню HR\n";
+
+        int choice = input_int("Выберите действие: ");
         switch (choice) {
         case 1:
             hr_add_employee();
@@ -1862,70 +2640,79 @@ void Application::hr_manage_employees(HRManagerUser& hr) {
         case 11:
             hr_generate_report();
             break;
+        case 12:
+            hr_batch_calculate_performance();
+            break;
+        case 13:
+            show_rating_leaders();
+            break;
+        case 14:
+            hr_generate_all_reports();
+            break;
         case 0:
             in_menu = false;
             break;
         default:
-            cout << " .\n";
+            cout << "Неверный выбор.\n";
         }
     }
 }
 
 void Application::hr_add_employee() {
-    cout << "\n---    ---\n";
+    cout << "\n--- Добавление нового сотрудника ---\n";
 
-    string username = input_line(" : ");
+    string username = input_line("Логин сотрудника: ");
     if (username.empty()) {
-        cout << "    .\n";
+        cout << "Логин не может быть пустым.\n";
         return;
     }
 
     if (store_->find_by_username(username) != nullptr) {
-        cout << "     .\n";
+        cout << "Сотрудник с таким логином уже существует.\n";
         return;
     }
 
     if (username == "admin" || username == "administrator" || username == "root") {
-        cout << "   .   .\n";
+        cout << "Данный логин зарезервирован системой. Выберите другой логин.\n";
         return;
     }
 
     string password;
     string password_hash;
     while (true) {
-        password = input_password(": ");
+        password = input_password("Пароль: ");
 
         if (password.empty()) {
-            cout << "    .\n";
+            cout << "Пароль не может быть пустым.\n";
             continue;
         }
 
         if (password.length() < 6) {
-            cout << "    6 .\n";
+            cout << "Пароль должен содержать минимум 6 символов.\n";
             continue;
         }
 
         password_hash = hash_password(password);
 
         if (store_->is_password_already_used(password_hash)) {
-            cout << "\033[31m:      !\033[0m\n";
-            cout << ",   .\n";
+            cout << "\033[31mОшибка: этот пароль уже используется другим пользователем!\033[0m\n";
+            cout << "Пожалуйста, придумайте другой пароль.\n";
             continue;
         }
 
-        string password2 = input_password(" : ");
+        string password2 = input_password("Подтвердите пароль: ");
 
         if (password != password2) {
-            cout << "  .  .\n";
+            cout << "Пароли не совпадают. Попробуйте заново.\n";
             continue;
         }
 
         break;
     }
 
-    string fullname = input_line(" : ");
+    string fullname = input_line("ФИО сотрудника: ");
     if (fullname.empty()) {
-        cout << "    .\n";
+        cout << "ФИО не может быть пустым.\n";
         return;
     }
 
@@ -1933,10 +2720,10 @@ void Application::hr_add_employee() {
 
     auto employee = UserFactory::create_user(username, password_hash, fullname, department, Role::EMPLOYEE);
     if (store_->add_user(move(employee))) {
-        cout << "\033[32m '" << fullname << "'  .\033[0m\n";
+        cout << "\033[32mСотрудник '" << fullname << "' успешно добавлен.\033[0m\n";
     }
     else {
-        cout << "\033[31m  .\033[0m\n";
+        cout << "\033[31mОшибка добавления сотрудника.\033[0m\n";
     }
 }
 
@@ -1944,19 +2731,19 @@ void Application::hr_view_all_employees() {
     auto employees = store_->get_all_employees();
 
     if (employees.empty()) {
-        cout << "\n .\n";
+        cout << "\nНет сотрудников.\n";
         return;
     }
 
-    cout << "\n===   ===\n\n";
+    cout << "\n=== СПИСОК СОТРУДНИКОВ ===\n\n";
     const int NUM_WIDTH = 4;
     const int FULLNAME_WIDTH = 25;
     const int DEPARTMENT_WIDTH = 15;
 
     cout << left
-        << setw(NUM_WIDTH) << ""
-        << setw(FULLNAME_WIDTH) << ""
-        << setw(DEPARTMENT_WIDTH) << ""
+        << setw(NUM_WIDTH) << "№"
+        << setw(FULLNAME_WIDTH) << "ФИО"
+        << setw(DEPARTMENT_WIDTH) << "ОТДЕЛ"
         << "\n";
 
     int total_width = NUM_WIDTH  + FULLNAME_WIDTH + DEPARTMENT_WIDTH;
@@ -1983,95 +2770,90 @@ void Application::hr_view_all_employees() {
         cout << "\n";
     }
 
-    cout << "\n: " << employees.size() << " \n";
+    cout << "\nВсего: " << employees.size() << " сотрудников\n";
 }
 
 void Application::hr_view_employee_details() {
-    cout << "\n---   ---\n";
+    cout << "\n--- Детали сотрудника ---\n";
 
     auto employees = store_->get_all_employees();
     if (employees.empty()) {
-        cout << " .\n";
+        cout << "Нет сотрудников.\n";
         return;
     }
 
-    cout << " :\n";
+    cout << "Список сотрудников:\n";
     for (size_t i = 0; i < employees.size(); ++i) {
         cout << (i + 1) << ") " << employees[i]->fullname()<< "\n";
     }
 
-    int choice = input_int("   : ");
+    int choice = input_int("Выберите сотрудника для просмотра: ");
     if (choice < 1 || choice > static_cast<int>(employees.size())) {
-        cout << " .\n";
+        cout << "Неверный выбор.\n";
         return;
     }
 
     const auto& emp = employees[choice - 1];
 
-    cout << "\n---    ---\n";
+    cout << "\n--- Информация о сотруднике ---\n";
     emp->view_profile();
 
-    //   
+    // Показать проекты сотрудника
     auto projects = project_store_->get_employee_projects(emp->username());
     if (!projects.empty()) {
-        cout << "\n :\n";
+        cout << "\nПроекты сотрудника:\n";
         for (const auto& project : projects) {
             cout << "  - " << project->name()
-                << " | : " << project->status()
-                << " | : ";
-
-            //     
-            auto all_emp_projects = project_store_->all_employee_projects();
-            for (const auto& emp_proj : all_emp_projects) {
-                if (emp_proj->username() == emp->username() &&
-                    emp_proj->project_name() == project->name()) {
-                    cout << emp_proj->role();
-                    break;
-                }
+                << " | Статус: " << project->status()
+                << " | Роль: ";
+
+            // Получаем роль сотрудника в проекте
+            if (const string* role = project_store_->role_of(emp->username(), project->name())) {
+                cout << *role;
             }
             cout << "\n";
         }
     }
     else {
-        cout << "\n      .\n";
+        cout << "\nСотрудник не участвует ни в одном проекте.\n";
     }
 }
 
 void Application::hr_edit_employee() {
-    cout << "\n---    ---\n";
+    cout << "\n--- Редактирование данных сотрудника ---\n";
 
     auto employees = store_->get_all_employees();
     if (employees.empty()) {
-        cout << " .\n";
+        cout << "Нет сотрудников.\n";
         return;
     }
 
-    cout << " :\n";
+    cout << "Список сотрудников:\n";
     for (size_t i = 0; i < employees.size(); ++i) {
         cout << (i + 1) << ") " << employees[i]->fullname()<< "\n";
     }
 
-    int choice = input_int("   : ");
+    int choice = input_int("Выберите сотрудника для редактирования: ");
     if (choice < 1 || choice > static_cast<int>(employees.size())) {
-        cout << " .\n";
+        cout << "Неверный выбор.\n";
         return;
     }
 
     const string username = employees[choice - 1]->username();
 
-    cout << "\n :\n";
+    cout << "\nТекущая информация:\n";
     employees[choice - 1]->view_profile();
 
-    cout << "\n   ( ,   ):\n";
+    cout << "\nВведите новые данные (оставьте пустым, чтобы не менять):\n";
 
-    string new_fullname = input_line(" : ", true);
+    string new_fullname = input_line("Новое ФИО: ", true);
     if (new_fullname.empty()) {
         new_fullname = employees[choice - 1]->fullname();
     }
 
-    cout << "\n   ( Enter,   ):\n";
+    cout << "\nВыберите новый отдел (нажмите Enter, чтобы оставить текущий):\n";
     vector<string> depts = {
-        "HR", "", "QA", "", "", "", ""
+        "HR", "Разработка", "QA", "Дизайн", "Маркетинг", "Продажи", "Поддержка"
     };
 
     for (size_t i = 0; i < depts.size(); ++i) {
@@ -2080,11 +2862,11 @@ void Application::hr_edit_employee() {
 
     string new_department;
     while (true) {
-        cout << "\n  (1-" << depts.size() << ")  Enter   : ";
+        cout << "\nВаш выбор (1-" << depts.size() << ") или Enter для текущего отдела: ";
         string input;
         getline(cin, input);
 
-        //   Enter -   
+        // Если нажали Enter - оставляем текущий отдел
         if (input.empty()) {
             new_department = employees[choice - 1]->department();
             break;
@@ -2097,80 +2879,82 @@ void Application::hr_edit_employee() {
                 break;
             }
             else {
-                cout << " . ,    1  " << depts.size() << ".\n";
+                cout << "Неверный выбор. Пожалуйста, введите число от 1 до " << depts.size() << ".\n";
             }
         }
         catch (const exception&) {
-            cout << ",     Enter.\n";
+            cout << "Пожалуйста, введите число или нажмите Enter.\n";
         }
     }
 
     if (store_->update_employee(username, new_fullname, new_department)) {
-        cout << "  .\n";
+        cout << "Данные сотрудника обновлены.\n";
     }
     else {
-        cout << "  .\n";
+        cout << "Ошибка обновления данных.\n";
     }
 }
 
 void Application::hr_delete_employee() {
-    cout << "\n---   ---\n";
+    cout << "\n--- Удаление сотрудника ---\n";
 
     auto employees = store_->get_all_employees();
     if (employees.empty()) {
-        cout << " .\n";
+        cout << "Нет сотрудников.\n";
         return;
     }
 
-    cout << " :\n";
+    cout << "Список сотрудников:\n";
     for (size_t i = 0; i < employees.size(); ++i) {
         cout << (i + 1) << ") " << employees[i]->fullname() << "\n";
     }
 
-    int choice = input_int("   : ");
+    int choice = input_int("Выберите сотрудника для удаления: ");
     if (choice < 1 || choice > static_cast<int>(employees.size())) {
-        cout << " .\n";
+        cout << "Неверный выбор.\n";
         return;
     }
 
     const string username = employees[choice - 1]->username();
 
-    cout << " ,     '" << employees[choice - 1]->fullname() << "'? (y/n): ";
+    cout << "Вы уверены, что хотите удалить сотрудника '" << employees[choice - 1]->fullname() << "'? (y/n): ";
     string confirm = input_line("");
     if (confirm == "y" || confirm == "Y") {
+        ProjectStore::Transaction tx(*project_store_);
         auto emp_projects = project_store_->all_employee_projects();
         for (const auto& emp_proj : emp_projects) {
             if (emp_proj->username() == username) {
                 project_store_->remove_employee_from_project(username, emp_proj->project_name());
             }
         }
+        tx.commit();
 
         if (store_->remove_user_by_username(username)) {
-            cout << " .\n";
+            cout << "Сотрудник удален.\n";
         }
         else {
-            cout << "  .\n";
+            cout << "Ошибка удаления сотрудника.\n";
         }
     }
     else {
-        cout << " .\n";
+        cout << "Удаление отменено.\n";
     }
 }
 
 void Application::hr_search_employees() {
-    cout << "\n---   ---\n";
-    string keyword = input_line("     (): ");
+    cout << "\n--- Поиск сотрудников ---\n";
+    string keyword = input_line("Введите ключевое слово для поиска (ФИО): ");
     auto results = store_->search_employees_by_name(keyword);
 
     if (results.empty()) {
-        cout << "  .\n";
+        cout << "Сотрудники не найдены.\n";
     }
     else {
-        cout << "\n---   (" << results.size() << ") ---\n";
+        cout << "\n--- Результаты поиска (" << results.size() << ") ---\n";
         for (const auto& emp : results) {
-            cout << ": " << emp->fullname()
-                << " | : " << emp->department()
-                << " | : " << role_to_string(emp->role()) << "\n";
+            cout << "ФИО: " << emp->fullname()
+                << " | Отдел: " << emp->department()
+                << " | Роль: " << role_to_string(emp->role()) << "\n";
         }
     }
 }
@@ -2180,45 +2964,45 @@ void Application::hr_sort_employees() {
     vector<const User*> sorted_employees;
  
     sorted_employees = store_->get_employees_sorted_by_name(true);
-    cout << "\n---     (-) ---\n";
+    cout << "\n--- Сотрудники отсортированные по ФИО (А-Я) ---\n";
 
     if (sorted_employees.empty()) {
-        cout << " .\n";
+        cout << "Нет сотрудников.\n";
         return;
     }
 
     for (const auto& emp : sorted_employees) {
-        cout << ": " << emp->fullname()
-            << " | : " << emp->username()
-            << " | : " << emp->department()
-            << " | : " << role_to_string(emp->role()) << "\n";
+        cout << "ФИО: " << emp->fullname()
+            << " | Логин: " << emp->username()
+            << " | Отдел: " << emp->department()
+            << " | Роль: " << role_to_string(emp->role()) << "\n";
     }
 }
 
-//      (   +   )
+// Метод для генерации отчета сотрудника (вывод на экран + сохранение в файл)
 void Application::hr_generate_report() {
     const int TABLE_WIDTH = 80;
 
     cout << "\n";
     printHorizontalLine('=', TABLE_WIDTH);
-    cout << "|" << centerAlign("   ", TABLE_WIDTH - 2) << "|\n";
+    cout << "|" << centerAlign("ГЕНЕРАЦИЯ ОТЧЕТА О СОТРУДНИКЕ", TABLE_WIDTH - 2) << "|\n";
     printHorizontalLine('=', TABLE_WIDTH);
 
     auto employees = store_->get_all_employees();
     if (employees.empty()) {
-        cout << "|" << centerAlign("    ", TABLE_WIDTH - 2) << "|\n";
+        cout << "|" << centerAlign("Нет сотрудников для генерации отчетов", TABLE_WIDTH - 2) << "|\n";
         printHorizontalLine('=', TABLE_WIDTH);
         return;
     }
 
-    cout << "|" << centerAlign(" ", TABLE_WIDTH - 2) << "|\n";
+    cout << "|" << centerAlign("Список сотрудников", TABLE_WIDTH - 2) << "|\n";
     printHorizontalLine('-', TABLE_WIDTH);
 
     for (size_t i = 0; i < employees.size(); ++i) {
         string employee_info = to_string(i + 1) + ") " + employees[i]->fullname() + " - "+
             employees[i]->department();
 
-        //    
+        // Обрезаем если слишком длинное
         if (employee_info.length() > TABLE_WIDTH - 4) {
             employee_info = employee_info.substr(0, TABLE_WIDTH - 7) + "...";
         }
@@ -2228,11 +3012,11 @@ void Application::hr_generate_report() {
 
     printHorizontalLine('=', TABLE_WIDTH);
 
-    int choice = input_int("\n     (0 - ): ");
+    int choice = input_int("\nВыберите сотрудника для генерации отчета (0 - отмена): ");
     if (choice == 0) {
         cout << "\n";
         printHorizontalLine('=', TABLE_WIDTH);
-        cout << "|" << centerAlign(" ", TABLE_WIDTH - 2) << "|\n";
+        cout << "|" << centerAlign("Операция отменена", TABLE_WIDTH - 2) << "|\n";
         printHorizontalLine('=', TABLE_WIDTH);
         return;
     }
@@ -2240,7 +3024,7 @@ void Application::hr_generate_report() {
     if (choice < 1 || choice > static_cast<int>(employees.size())) {
         cout << "\n";
         printHorizontalLine('=', TABLE_WIDTH);
-        cout << "|" << centerAlign(" ", TABLE_WIDTH - 2) << "|\n";
+        cout << "|" << centerAlign("Неверный выбор", TABLE_WIDTH - 2) << "|\n";
         printHorizontalLine('=', TABLE_WIDTH);
         return;
     }
@@ -2251,7 +3035,7 @@ void Application::hr_generate_report() {
     if (!employee) {
         cout << "\n";
         printHorizontalLine('=', TABLE_WIDTH);
-        cout << "|" << centerAlign(":   ", TABLE_WIDTH - 2) << "|\n";
+        cout << "|" << centerAlign("Ошибка: сотрудник не найден", TABLE_WIDTH - 2) << "|\n";
         printHorizontalLine('=', TABLE_WIDTH);
         return;
     }
@@ -2259,217 +3043,157 @@ void Application::hr_generate_report() {
     generate_detailed_report(username, employee);
 }
 
-//         
-void Application::generate_detailed_report(const string& username, User* employee) {
-    const int TABLE_WIDTH = 80;
-
-    cout << "\n";
-    printHorizontalLine('=', TABLE_WIDTH);
-    cout << "|" << centerAlign("  ", TABLE_WIDTH - 2) << "|\n";
-    printHorizontalLine('=', TABLE_WIDTH);
-
-    //  
-    string department = employee->department();
-    string deptParamName = system_config_->getDepartmentParameterName(department);
-
-    //    
-    auto projects = project_store_->get_employee_projects(username);
-    int total_projects = projects.size();
-    int active_projects = 0;
-    int completed_projects = 0;
-    int leadership_count = 0;
-    vector<string> project_details;
-
-    for (const auto& project : projects) {
-        if (project->status() == "" || project->status() == "Active") {
-            active_projects++;
-        }
-        else if (project->status() == "" || project->status() == "Completed") {
-            completed_projects++;
-        }
-
-        //     
-        string role = "";
-        string assigned_date = "";
-        auto all_emp_projects = project_store_->all_employee_projects();
-        for (const auto& emp_proj : all_emp_projects) {
-            if (emp_proj->username() == username &&
-                emp_proj->project_name() == project->name()) {
-                role = emp_proj->role();
-                assigned_date = emp_proj->assigned_date();
-                if (role == "" || role == "Team Lead" ||
-                    role == "" || role == "Manager") {
-                    leadership_count++;
-                }
-                break;
-            }
-        }
-
-        project_details.push_back(project->name() + "|" + project->status() + "|" +
-            role + "|" + assigned_date + "|" + project->created_date());
+// Отчеты по всем сотрудникам. Данные собираются в главном потоке (согласованный
+// снимок хранилищ), затем каждый отчет удаляет прежние файлы своего сотрудника и пишет
+// свой файл в пуле потоков - общих файлов у задач нет.
+void Application::hr_generate_all_reports() {
+    auto employees = store_->get_all_employees();
+    if (employees.empty()) {
+        cout << "Нет сотрудников для генерации отчетов.\n";
+        return;
     }
 
-    //   
-    cout << "|" << centerAlign(" ", TABLE_WIDTH - 2) << "|\n";
-    printHorizontalLine('-', TABLE_WIDTH);
-
-    int label_width = 20;
-    int value_width = TABLE_WIDTH - label_width - 7;
-
-    
-    cout << "| " << left << setw(label_width) << ":"
-        << " | " << left << setw(value_width) << employee->fullname() << " |\n";
-    cout << "| " << left << setw(label_width) << ":"
-        << " | " << left << setw(value_width) << department << " |\n";
-    cout << "| " << left << setw(label_width) << " :"
-        << " | " << left << setw(value_width) << now_string() << " |\n";
-    
-    printHorizontalLine('=', TABLE_WIDTH);
-
-    //  
-    cout << "|" << centerAlign(" ", TABLE_WIDTH - 2) << "|\n";
-    printHorizontalLine('-', TABLE_WIDTH);
-
-    int label_width2 = 30;
-    int value_width2 = TABLE_WIDTH - label_width2 - 7;
-
-    cout << "| " << left << setw(label_width2) << " :"
-        << " | " << right << setw(value_width2) << to_string(total_projects) << " |\n";
-    cout << "| " << left << setw(label_width2) << " :"
-        << " | " << right << setw(value_width2) << to_string(active_projects) << " |\n";
-    cout << "| " << left << setw(label_width2) << " :"
-        << " | " << right << setw(value_width2) << to_string(completed_projects) << " |\n";
-    cout << "| " << left << setw(label_width2) << " :"
-        << " | " << right << setw(value_width2) << to_string(leadership_count) << " |\n";
-
-    if (total_projects > 0) {
-        double completion_rate = (static_cast<double>(completed_projects) / total_projects) * 100;
-        double activity_rate = (static_cast<double>(active_projects) / total_projects) * 100;
-        double leadership_rate = (static_cast<double>(leadership_count) / total_projects) * 100;
-
-        cout << "| " << left << setw(label_width2) << " :"
-            << " | " << right << setw(value_width2) << fixed << setprecision(1) << completion_rate << "%|\n";
-        cout << "| " << left << setw(label_width2) << " :"
-            << " | " << right << setw(value_width2) << fixed << setprecision(1) << activity_rate << "%|\n";
-        cout << "| " << left << setw(label_width2) << " :"
-            << " | " << right << setw(value_width2) << fixed << setprecision(1) << leadership_rate << "%|\n";
+    cout << "\nФормат отчетов:\n1. Текст (TXT)\n2. JSON\n3. CSV\n";
+    int format_choice = input_int("Выберите формат: ");
+    if (format_choice < 1 || format_choice > 3) {
+        cout << "Неверный выбор.\n";
+        return;
     }
+    const ReportFormat format = format_choice == 2 ? ReportFormat::JSON :
+        format_choice == 3 ? ReportFormat::CSV : ReportFormat::TEXT;
 
-    printHorizontalLine('=', TABLE_WIDTH);
-
-    //  
-    if (!project_details.empty()) {
-        cout << "|" << centerAlign(" ", TABLE_WIDTH - 2) << "|\n";
-        printHorizontalLine('-', TABLE_WIDTH);
-
-        //      
-        int col1_width = 30; //  
-        int col2_width = 15; // 
-        int col3_width = 20; // 
-        int col4_width = 25; // 
-        int total_col_width = col1_width + col2_width + col3_width + col4_width + 9;
-
-        //  
-        cout << "| " << left << setw(col1_width) << " "
-            << " | " << left << setw(col2_width) << ""
-            
-            << " | " << left << setw(col4_width) << "" << " |\n";
-        printHorizontalLine('-', TABLE_WIDTH);
-
-        for (size_t i = 0; i < min(project_details.size(), static_cast<size_t>(10)); ++i) {
-            vector<string> parts = split(project_details[i], '|');
-            if (parts.size() >= 5) {
-                string project_name = parts[0];
-                if (project_name.length() > col1_width - 2) {
-                    project_name = project_name.substr(0, col1_width - 3) + "...";
-                }
-
-                string status = parts[1];
-                if (status.length() > col2_width - 2) {
-                    status = status.substr(0, col2_width - 3) + "...";
-                }
+    auto start = chrono::steady_clock::now();
+    vector<ReportModel> reports;
+    reports.reserve(employees.size());
+    for (const User* employee : employees) {
+        reports.push_back(build_report_model(employee->username(), employee));
+    }
+    // Прежние файлы каждого сотрудника известны из каталога - задачам не нужен обход каталога
+    const string extension = report_file_extension(format);
+    vector<vector<string>> old_files(reports.size());
+    for (size_t i = 0; i < reports.size(); ++i) {
+        old_files[i] = report_catalog_.files_of(reports[i].username, extension);
+    }
+    auto collected = chrono::steady_clock::now();
 
-                string role = parts[2];
-                if (role.length() > col3_width - 2) {
-                    role = role.substr(0, col3_width - 3) + "...";
+    struct ReportResult {
+        string filename;
+        double ms = 0;
+        bool saved = false;
+    };
+    vector<ReportResult> results(reports.size());
+    size_t threads = 0;
+    {
+        ThreadPool pool;
+        threads = pool.size();
+        cout << "\nГенерация отчетов: " << reports.size() << ", потоков: " << threads << "...\n";
+
+        for (size_t i = 0; i < reports.size(); ++i) {
+            pool.submit([&reports, &results, &old_files, &extension, &archive = report_archive_, format, i] {
+                auto file_start = chrono::steady_clock::now();
+                // Свой рендерер (и буфер) у каждой задачи
+                auto renderer = make_report_renderer(format);
+                const string& text = renderer->render(reports[i]);
+                results[i].filename = make_report_filename(reports[i].username, extension);
+                results[i].saved = ReportRenderer::write_file(results[i].filename, text);
+                if (results[i].saved) {
+                    // Архив у каждого сотрудника свой - задачи не пишут в общие файлы
+                    if (format == ReportFormat::TEXT) archive.append(reports[i].username, reports[i].generated_at, text);
+                    remove_report_files(old_files[i], results[i].filename, false);
                 }
-
-                string short_date = parts[3].length() > col4_width ? parts[3].substr(0, col4_width) : parts[3];
-
-                cout << "| " << left << setw(col1_width) << project_name
-                    << " | " << left << setw(col2_width) << status
-                    << " | " << left << setw(col4_width) << short_date << " |\n";
-            }
-        }
-
-        if (project_details.size() > 10) {
-            cout << "| " << left << setw(TABLE_WIDTH - 4)
-                << "...   " + to_string(project_details.size() - 10) + " " << " |\n";
+                results[i].ms = chrono::duration<double, milli>(chrono::steady_clock::now() - file_start).count();
+            });
         }
+        pool.wait();
+    }
 
-        printHorizontalLine('=', TABLE_WIDTH);
+    vector<pair<string, string>> saved_files;
+    saved_files.reserve(results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].saved) saved_files.emplace_back(reports[i].username, results[i].filename);
     }
+    report_catalog_.replace_all(saved_files);
+    auto finished = chrono::steady_clock::now();
 
-    cout << "|" << centerAlign(" ", TABLE_WIDTH - 2) << "|\n";
-    printHorizontalLine('-', TABLE_WIDTH);
+    cout << "\n" << left << setw(5) << "№" << setw(20) << "Логин" << setw(50) << "Файл" << "Время, мс\n";
+    cout << string(85, '-') << "\n";
 
-    if (system_config_->hasPerformanceScore(username)) {
-        double score = system_config_->getPerformanceScore(username);
+    size_t saved = 0;
+    double files_ms = 0;
+    cout << fixed << setprecision(2);
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].saved) saved++;
+        files_ms += results[i].ms;
+        cout << left << setw(5) << (i + 1) << setw(20) << reports[i].username
+            << setw(50) << (results[i].saved ? results[i].filename : "ОШИБКА СОХРАНЕНИЯ")
+            << results[i].ms << "\n";
+    }
 
-        cout << "| " << left << setw(40) << " :"
-            << " | " << right << setw(value_width2-14) << fixed << setprecision(2) << score << "/100 |\n";
+    double collect_ms = chrono::duration<double, milli>(collected - start).count();
+    double write_ms = chrono::duration<double, milli>(finished - collected).count();
 
-        cout << "| " << left << setw(40) << ":"
-            << " | " << left << setw(value_width2-10)
-            << (score >= 90 ? "" :
-                score >= 75 ? "" :
-                score >= 60 ? "" :
-                score >= 40 ? " " : "") << " |\n";
+    cout << "\n=== ИТОГИ ГЕНЕРАЦИИ ОТЧЕТОВ ===\n";
+    cout << "Сохранено отчетов: " << saved << " из " << reports.size() << "\n";
+    cout << "Потоков: " << threads << "\n";
+    cout << "Сбор данных: " << collect_ms << " мс\n";
+    cout << "Запись файлов: " << write_ms << " мс (сумма по файлам: " << files_ms << " мс)\n";
+    cout << "Всего: " << (collect_ms + write_ms) << " мс\n";
+    cout << resetiosflags(ios_base::floatfield) << setprecision(6);
+}
 
-        
-    }
-    else {
-        cout << "| " << left << setw(TABLE_WIDTH - 4)
-            << "   .   " << " |\n";
-        cout << "| " << left << setw(TABLE_WIDTH - 4)
-            << "'  '   ." << " |\n";
-    }
-    
+// Метод для создания подробного отчета с сохранением в файл
+void Application::generate_detailed_report(const string& username, User* employee) {
+    // Данные отчета собираются один раз и дальше используются и для экрана, и для файла
+    ReportModel report = build_report_model(username, employee);
+    console_report_.render_to(report, cout);
 
-    printHorizontalLine('=', TABLE_WIDTH);
+    // Теперь сохраняем отчет в файл
+    save_report_to_file(report);
+}
 
-    // 
-    vector<string> recommendations = generate_recommendations(total_projects, active_projects,
-        completed_projects, leadership_count);
+// Все обращения к хранилищам и настройкам, нужные отчету
+ReportModel Application::build_report_model(const string& username, const User* employee) {
+    STAT_SCOPE(stat, "Application::build_report_model");
+    ReportModel report;
+    report.username = username;
+    report.fullname = employee->fullname();
+    report.department = employee->department();
+    report.department_parameter = system_config_->getDepartmentParameterName(
+        system_config_->getDepartmentId(report.department));
+    report.generated_at = now_string();
 
-    cout << "|" << centerAlign("  ", TABLE_WIDTH - 2) << "|\n";
-    printHorizontalLine('-', TABLE_WIDTH);
+    // Получаем информацию о проектах вместе с ролью и датой назначения
+    auto links = project_store_->get_employee_project_links(username);
+    report.total_projects = static_cast<int>(links.size());
+    report.projects.reserve(links.size());
 
-    for (size_t i = 0; i < recommendations.size(); ++i) {
-        string rec_line = to_string(i + 1) + ". " + recommendations[i];
-        if (rec_line.length() > TABLE_WIDTH - 4) {
-            rec_line = rec_line.substr(0, TABLE_WIDTH - 7) + "...";
+    for (const auto& link : links) {
+        const Project* project = link.project;
+        if (project->status_code() == ProjectStatus::ACTIVE) {
+            report.active_projects++;
+        }
+        else if (project->status_code() == ProjectStatus::COMPLETED) {
+            report.completed_projects++;
         }
-        cout << "| " << left << setw(TABLE_WIDTH - 4) << rec_line << " |\n";
-    }
 
-    printHorizontalLine('=', TABLE_WIDTH);
+        if (link.assignment->is_leadership()) {
+            report.leadership_count++;
+        }
 
-   
+        report.projects.push_back({ project->name(), project->status(), link.assignment->role(),
+            link.assignment->assigned_date(), project->created_date() });
+    }
 
-    // 
-    int sign_width = 40;
-    int date_width = TABLE_WIDTH - sign_width - 7;
-    cout << "| " << left << setw(sign_width) << " HR-: ___________________"
-        << " | " << left << setw(date_width) << ": ___________________" << "|\n";
-    printHorizontalLine('=', TABLE_WIDTH);
+    report.recommendations = generate_recommendations(report.total_projects, report.active_projects,
+        report.completed_projects, report.leadership_count);
 
-    //     
-    save_report_to_file(username, employee, department, deptParamName,
-        total_projects, active_projects, completed_projects,
-        leadership_count, project_details, recommendations);
+    report.has_score = system_config_->hasPerformanceScore(username);
+    if (report.has_score) {
+        report.score = system_config_->getPerformanceScore(username);
+    }
+    return report;
 }
-//     
+// Вспомогательные функции для форматирования таблиц
 string Application::centerAlign(const string& text, int width) {
     if (text.length() >= width) return text.substr(0, width);
 
@@ -2484,273 +3208,128 @@ void Application::printHorizontalLine(char symbol, int width) {
     cout << string(width, symbol) << "\n";
 }
 
-//  
+// Генерация рекомендаций
 vector<string> Application::generate_recommendations(int total_projects, int active_projects,
     int completed_projects, int leadership_count) {
     vector<string> recommendations;
 
     if (total_projects == 0) {
-        recommendations.push_back("    ");
-        recommendations.push_back("   ");
-        recommendations.push_back("  ");
+        recommendations.push_back("Включить сотрудника в активные проекты");
+        recommendations.push_back("Назначить наставника для адаптации");
+        recommendations.push_back("Определить зону ответственности");
     }
     else if (leadership_count == 0 && total_projects >= 3) {
-        recommendations.push_back("     ");
-        recommendations.push_back("  ");
-        recommendations.push_back("   ");
+        recommendations.push_back("Рассмотреть возможность назначения на лидерскую роль");
+        recommendations.push_back("Развивать управленческие навыки");
+        recommendations.push_back("Поручить менторство новым сотрудникам");
     }
     else if (completed_projects == 0 && active_projects > 0) {
-        recommendations.push_back("    ");
-        recommendations.push_back("  -");
-        recommendations.push_back("  ");
+        recommendations.push_back("Сфокусироваться на завершении текущих проектов");
+        recommendations.push_back("Улучшить навыки тайм-менеджмента");
+        recommendations.push_back("Установить четкие дедлайны");
     }
     else if (completed_projects >= 3 && leadership_count >= 1) {
-        recommendations.push_back("   ");
-        recommendations.push_back("     ");
-        recommendations.push_back("    ");
+        recommendations.push_back("Рассмотреть кандидатуру для повышения");
+        recommendations.push_back("Поручить более сложные и ответственные задачи");
+        recommendations.push_back("Включить в процессы принятия решений");
     }
     else {
-        recommendations.push_back("  ");
-        recommendations.push_back("  ");
-        recommendations.push_back("  - ");
+        recommendations.push_back("Продолжать текущую деятельность");
+        recommendations.push_back("Развивать профессиональные навыки");
+        recommendations.push_back("Участвовать в кросс-функциональных проектах");
     }
 
-    //  
-    recommendations.push_back("  one-to-one ");
-    recommendations.push_back("   ");
-    recommendations.push_back("     ");
+    // Общие рекомендации
+    recommendations.push_back("Проводить регулярные one-to-one встречи");
+    recommendations.push_back("Отслеживать прогресс по проектам");
+    recommendations.push_back("Обеспечить доступ к обучению и развитию");
 
     return recommendations;
 }
 
-//       (    )
-void Application::save_report_to_file(const string& username, User* employee,
-    const string& department, const string& deptParamName,
-    int total_projects, int active_projects, int completed_projects,
-    int leadership_count, const vector<string>& project_details,
-    const vector<string>& recommendations) {
-    
-    //   
+// Имя файла отчета: HR_REPORT_<логин>_<дата>_<время><расширение>
+string Application::make_report_filename(const string& username, const string& extension) {
     string timestamp = now_string();
     replace(timestamp.begin(), timestamp.end(), ':', '-');
     replace(timestamp.begin(), timestamp.end(), ' ', '_');
+    return "HR_REPORT_" + username + "_" + timestamp + extension;
+}
 
-    //       
-    string search_pattern = "HR_REPORT_" + username + "_*.txt";
-    WIN32_FIND_DATAA findFileData;
-    HANDLE hFind = FindFirstFileA(search_pattern.c_str(), &findFileData);
-
-    if (hFind != INVALID_HANDLE_VALUE) {
-        do {
-            if (!(findFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
-                string old_file = findFileData.cFileName;
-                remove(old_file.c_str());
-
-                cout << "  '" << old_file << "' .\n";
-            }
-        } while (FindNextFileA(hFind, &findFileData) != 0);
-        FindClose(hFind);
-    }
-
-    string filename = "HR_REPORT_" + username + "_" + timestamp + ".txt";
-
-    ofstream file(filename);
-    if (!file) {
-        cout << "\n";
-        printHorizontalLine('=', 80);
-        cout << "|" << centerAlign("  ", 78) << "|\n";
-        printHorizontalLine('=', 80);
-        return;
-    }
-
-    const int FILE_WIDTH = 80;
-
-    //    
-    file << string(FILE_WIDTH, '=') << "\n";
-    file << "|" << centerAlign(" HR  ", FILE_WIDTH - 2) << "|\n";
-    file << string(FILE_WIDTH, '=') << "\n";
-    file << "| " << left << setw(20) << " :"
-        << " | " << left << setw(FILE_WIDTH - 27) << now_string() << " |\n";
-    file << "| " << left << setw(20) << ":"
-        << " | " << left << setw(FILE_WIDTH - 27) << "HR-" << " |\n";
-    file << string(FILE_WIDTH, '=') << "\n\n";
-
-    //  
-    file << string(FILE_WIDTH, '=') << "\n";
-    file << "|" << centerAlign(" ", FILE_WIDTH - 2) << "|\n";
-    file << string(FILE_WIDTH, '-') << "\n";
-
-    int label_width = 20;
-    int value_width = FILE_WIDTH - label_width - 7;
-
-    file << "| " << left << setw(label_width) << ":"
-        << " | " << left << setw(value_width) << employee->fullname() << " |\n";
-    file << "| " << left << setw(label_width) << ":"
-        << " | " << left << setw(value_width) << department << " |\n";
-    
-    file << string(FILE_WIDTH, '=') << "\n\n";
-
-    file << string(FILE_WIDTH, '=') << "\n";
-    file << "|" << centerAlign(" ", FILE_WIDTH - 2) << "|\n";
-    file << string(FILE_WIDTH, '-') << "\n";
-
-    int label_width2 = 30;
-    int value_width2 = FILE_WIDTH - label_width2 - 7;
-
-    file << "| " << left << setw(label_width2) << " :"
-        << " | " << right << setw(value_width2) << to_string(total_projects) << " |\n";
-    file << "| " << left << setw(label_width2) << " :"
-        << " | " << right << setw(value_width2) << to_string(active_projects) << " |\n";
-    file << "| " << left << setw(label_width2) << " :"
-        << " | " << right << setw(value_width2) << to_string(completed_projects) << " |\n";
-    file << "| " << left << setw(label_width2) << " :"
-        << " | " << right << setw(value_width2) << to_string(leadership_count) << " |\n";
-
-    if (total_projects > 0) {
-        double completion_rate = (static_cast<double>(completed_projects) / total_projects) * 100;
-        double activity_rate = (static_cast<double>(active_projects) / total_projects) * 100;
-        double leadership_rate = (static_cast<double>(leadership_count) / total_projects) * 100;
-
-        file << "| " << left << setw(label_width2) << " :"
-            << " | " << right << setw(value_width2) << fixed << setprecision(1) << completion_rate << "%|\n";
-        file << "| " << left << setw(label_width2) << " :"
-            << " | " << right << setw(value_width2) << fixed << setprecision(1) << activity_rate << "%|\n";
-        file << "| " << left << setw(label_width2) << " :"
-            << " | " << right << setw(value_width2) << fixed << setprecision(1) << leadership_rate << "%|\n";
-    }
-
-    file << string(FILE_WIDTH, '=') << "\n\n";
-
-    //  
-    if (!project_details.empty()) {
-        file << string(FILE_WIDTH, '=') << "\n";
-        file << "|" << centerAlign(" ", FILE_WIDTH - 2) << "|\n";
-        file << string(FILE_WIDTH, '-') << "\n";
-
-        int col1_width = 30;
-        int col2_width = 15;
-        int col3_width = 20;
-        int col4_width = 25;
-
-        file << "| " << left << setw(col1_width) << " "
-            << " | " << left << setw(col2_width) << ""
-            
-            << " | " << left << setw(col4_width) << " " << " |\n";
-        file << string(FILE_WIDTH, '-') << "\n";
-
-        for (const auto& project_detail : project_details) {
-            vector<string> parts = split(project_detail, '|');
-            if (parts.size() >= 5) {
-                string project_name = parts[0];
-                if (project_name.length() > col1_width - 2) {
-                    project_name = project_name.substr(0, col1_width - 3) + "...";
-                }
-
-                string status = parts[1];
-                if (status.length() > col2_width - 2) {
-                    status = status.substr(0, col2_width - 3) + "...";
-                }
-
-                string role = parts[2];
-                if (role.length() > col3_width - 2) {
-                    role = role.substr(0, col3_width - 3) + "...";
-                }
+// Удаляет прежние отчеты (кроме keep); возвращает число удаленных файлов
+int Application::remove_report_files(const vector<string>& filenames, const string& keep, bool verbose) {
+    int removed = 0;
+    for (const string& old_file : filenames) {
+        if (old_file == keep) continue;
 
-                file << "| " << left << setw(col1_width) << project_name
-                    << " | " << left << setw(col2_width) << status
-                    
-                    << " | " << left << setw(col4_width) << parts[3] << " |\n";
-            }
+        error_code ec;
+        if (filesystem::remove(old_file, ec)) {
+            ++removed;
+            if (verbose) cout << "Старый отчет '" << old_file << "' удален.\n";
         }
-
-        file << string(FILE_WIDTH, '=') << "\n\n";
     }
+    return removed;
+}
 
-    file << "|" << centerAlign(" ", FILE_WIDTH - 2) << "|\n";
-    file << string(FILE_WIDTH, '-') << "\n";
-
-    if (system_config_->hasPerformanceScore(username)) {
-        double score = system_config_->getPerformanceScore(username);
-
-        file << "| " << left << setw(40) << " :"
-            << " | " << right << setw(value_width2-14) << fixed << setprecision(2) << score << "/100 |\n";
+// Метод для сохранения отчета в файл (теперь в том же формате)
+bool Application::store_report(const ReportModel& report, ReportRenderer& renderer, string& filename,
+    size_t& version, bool verbose) {
+    STAT_SCOPE(stat, "Application::store_report");
+    const string extension = renderer.file_extension();
+    filename = make_report_filename(report.username, extension);
+    version = 0;
+    vector<string> old_files = report_catalog_.files_of(report.username, extension);
 
-        file << "| " << left << setw(40) << ":"
-            << " | " << left << setw(value_width2-10)
-            << (score >= 90 ? "" :
-                score >= 75 ? "" :
-                score >= 60 ? "" :
-                score >= 40 ? " " : "") << " |\n";
+    const string& text = renderer.render(report);
+    if (!ReportRenderer::write_file(filename, text)) return false;
+    stat.add_bytes(static_cast<long long>(text.size()));
 
-        
+    // Прежние файлы удаляются только после успешной записи нового; все версии остаются в архиве
+    if (extension == report_file_extension(ReportFormat::TEXT)) {
+        version = report_archive_.append(report.username, report.generated_at, text);
     }
-    else {
-        file << "| " << left << setw(FILE_WIDTH - 4)
-            << "   .   " << " |\n";
-        file << "| " << left << setw(FILE_WIDTH - 4)
-            << "'  '   ." << " |\n";
-    }
-    
-
-    printHorizontalLine('=', FILE_WIDTH);
-
-    file << string(FILE_WIDTH, '=') << "\n";
-    file << "|" << centerAlign("  ", FILE_WIDTH - 2) << "|\n";
-    file << string(FILE_WIDTH, '-') << "\n";
+    remove_report_files(old_files, filename, verbose);
+    report_catalog_.replace(report.username, filename);
+    return true;
+}
 
-    for (size_t i = 0; i < recommendations.size(); ++i) {
-        file << "| " << left << setw(FILE_WIDTH - 4)
-            << to_string(i + 1) + ". " + recommendations[i] << " |\n";
+void Application::save_report_to_file(const ReportModel& report) {
+    string filename;
+    size_t version = 0;
+    if (!store_report(report, text_report_, filename, version, true)) {
+        cout << "\n";
+        printHorizontalLine('=', 80);
+        cout << "|" << centerAlign("ОШИБКА СОХРАНЕНИЯ ФАЙЛА", 78) << "|\n";
+        printHorizontalLine('=', 80);
+        return;
     }
 
-    file << string(FILE_WIDTH, '=') << "\n\n";
-
-    int sign_width = 40;
-    int date_width = FILE_WIDTH - sign_width - 7;
-    file << string(FILE_WIDTH, '=') << "\n";
-    file << "| " << left << setw(sign_width) << " HR-: ___________________"
-        << " | " << left << setw(date_width) << ": ___________________" << "|\n";
-    file << string(FILE_WIDTH, '=') << "\n";
-
-    file.close();
-
     cout << "\n";
     printHorizontalLine('=', 80);
-    cout << "|" << centerAlign("  !", 78) << "|\n";
+    cout << "|" << centerAlign("ОТЧЕТ УСПЕШНО СОХРАНЕН!", 78) << "|\n";
 
     int label_width4 = 20;
     int value_width4 = 80 - label_width4 - 7;
 
-    cout << "| " << left << setw(label_width4) << ":"
+    cout << "| " << left << setw(label_width4) << "Файл:"
         << " | " << left << setw(value_width4) << filename << " |\n";
-    cout << "| " << left << setw(label_width4) << ":"
-        << " | " << left << setw(value_width4) << "    " << " |\n";
-    cout << "| " << left << setw(label_width4) << ":"
-        << " | " << left << setw(value_width4) << "  " << " |\n";
+    cout << "| " << left << setw(label_width4) << "Архив:"
+        << " | " << left << setw(value_width4)
+        << (version != 0 ? "версия " + to_string(version) : string("ошибка записи в архив")) << " |\n";
+    cout << "| " << left << setw(label_width4) << "Размер:"
+        << " | " << left << setw(value_width4) << "Полный отчет доступен для печати" << " |\n";
+    cout << "| " << left << setw(label_width4) << "Путь:"
+        << " | " << left << setw(value_width4) << "Текущая директория программы" << " |\n";
     printHorizontalLine('=', 80);
 
-    cout << "\n  ? (y/n): ";
+    cout << "\nОткрыть сохраненный файл? (y/n): ";
     string openFile = input_line("");
     if (openFile == "y" || openFile == "Y") {
-        cout << "\n";
-        printHorizontalLine('=', 80);
-        cout << "|" << centerAlign(" : " + filename, 78) << "|\n";
-        printHorizontalLine('=', 80);
-
-        ifstream read_file(filename); 
-        if (read_file) {
-            string line;
-            int line_count = 0;
-            while (getline(read_file, line) && line_count < 100) {
-                cout << line << "\n";
-                line_count++;
-            }
-            if (line_count >= 100) {
-                cout << string(80, '.') << "\n";
-                cout << "  100  .  : " << filename << "\n";
-            }
-            printHorizontalLine('=', 80);
-            read_file.close();
+        MappedFile saved_file(filename);
+        if (saved_file.is_open()) {
+            view_report("СОДЕРЖИМОЕ ФАЙЛА: " + filename, saved_file.view());
+        }
+        else {
+            cout << "Ошибка открытия файла отчета.\n";
         }
     }
 }
@@ -1,11 +1,19 @@
 #pragma once
 
 #include <algorithm> 
+#include <cstdint>
 #include <fstream> 
+#include <map>
 #include <memory> 
 #include <string> 
+#include <string_view>
 #include <vector>
 #include "Utilities.h"
+#include "MappedFile.h"
+#include "Report.h"
+#include "ReportCatalog.h"
+#include "ReportArchive.h"
+#include "TrigramIndex.h"
 #include "SystemConfig.h"
 
 class Project;
@@ -14,7 +22,7 @@ class ProjectStore;
 
 using namespace std;
 
-// ---------------------------    ---------------------------
+// --------------------------- Роли и типы ---------------------------
 enum class Role { EMPLOYEE, HR, ADMIN, PENDING };
 
 inline string role_to_string(Role r) {
@@ -27,17 +35,19 @@ inline string role_to_string(Role r) {
     return "UNKNOWN";
 }
 
-inline Role string_to_role(const string& s) {
-    string u = s;
-    transform(u.begin(), u.end(), u.begin(), ::toupper);
-    if (u == "EMPLOYEE") return Role::EMPLOYEE;
-    if (u == "HR") return Role::HR;
-    if (u == "ADMIN") return Role::ADMIN;
-    if (u == "PENDING") return Role::PENDING;
+inline Role string_to_role(string_view s) {
+    // Регистр не важен; сравнение без копирования и выделения памяти
+    if (equals_fold_cp1251(s, "EMPLOYEE")) return Role::EMPLOYEE;
+    if (equals_fold_cp1251(s, "HR")) return Role::HR;
+    if (equals_fold_cp1251(s, "ADMIN")) return Role::ADMIN;
+    if (equals_fold_cp1251(s, "PENDING")) return Role::PENDING;
     return Role::EMPLOYEE;
 }
 
-// ---------------------------   User ---------------------------
+// Хеш пароля в том виде, в каком он хранится в файлах пользователей
+string hash_password(const string& password);
+
+// --------------------------- Базовый класс User ---------------------------
 class User {
     friend ostream& operator<<(ostream&, const User&);
     static int total_users;
@@ -85,7 +95,7 @@ public:
 
 };
 
-//    User
+// Администратор — расширяет User
 class Admin : public User {
 public:
     Admin(string username, string password, string fullname = "Administrator")
@@ -93,7 +103,7 @@ public:
     }
    
     void admin_assign_hr_role(const string& username) override;
-    //     HR 
+    // Админ НЕ должен выполнять HR функции
     void hr_add_employee() override {} 
     void hr_add_project() override {}
     void hr_calc_performance(const string& username) override {}
@@ -113,7 +123,7 @@ public:
         : User(move(username), move(password), move(fullname), move(department), Role::HR) {
     }
 
-    // HR     HR
+    // HR НЕ может назначать других HR
     void admin_assign_hr_role(const string& username) override {}
     void employee_view_rating() const override {};
 
@@ -126,14 +136,14 @@ public:
     
 };
 
-//  
+// Обычный сотрудник
 class EmployeeUser : public User {
 public:
     EmployeeUser(string username, string password, string fullname, string department)
         : User(move(username), move(password), move(fullname), move(department), Role::EMPLOYEE) {
     }
 
-    //     HR  Admin 
+    // Сотрудник НЕ может выполнять HR и Admin функции
     void admin_assign_hr_role(const string& username) override {}
 
     void hr_add_employee() override {}
@@ -141,32 +151,32 @@ public:
     void hr_calc_performance(const string& username) override {}
     void hr_generate_report(const string& username) override {}
 
-    //        
+    // Сотрудник может только просматривать свои отчеты и рейтинг
     void employee_view_reports() const override;
     void employee_view_rating() const override;
 };
 
-// --------------------------- Factory   ---------------------------
+// --------------------------- Factory для пользователей ---------------------------
 class UserFactory {
 public:
     static unique_ptr<User> create_user_from_record(const string& record) {
-        auto parts = split(record, '|');
-        if (parts.size() < 5) return nullptr;
+        string_view fields[5];
+        size_t count = split_fields(record, '|', fields, 5);
+        return create_user_from_fields(fields, count);
+    }
 
-        string username = trim(parts[0]);
-        string password = trim(parts[1]);
-        string fullname = trim(parts[2]);
-        string department = trim(parts[3]);
-        Role role = string_to_role(trim(parts[4]));
+    // Поля уже разобраны загрузчиком (string_view в отображенный файл):
+    // байты копируются один раз — сразу в строки пользователя
+    static unique_ptr<User> create_user_from_fields(const string_view* fields, size_t count) {
+        if (count < 5) return nullptr;
 
+        Role role = string_to_role(fields[4]);
+        auto ptr = make_unique<EmployeeUser>(string(fields[0]), string(fields[1]),
+            string(fields[2]), string(fields[3]));
         if (role == Role::PENDING) {
-            auto ptr = make_unique<EmployeeUser>(username, password, fullname, department);
             ptr->set_role(Role::PENDING);
-            return ptr;
-        }
-        else {
-            return make_unique<EmployeeUser>(username, password, fullname, department);
         }
+        return ptr;
     }
 
     static unique_ptr<User> create_user(const string& username,
@@ -191,7 +201,7 @@ public:
     }
 };
 
-// ---------------------------   () ---------------------------
+// --------------------------- Хранилище пользователей (файловое) ---------------------------
 template <typename T>
 class Store {
 protected:
@@ -213,11 +223,142 @@ public:
     }
 };
 
+// --------------------------- Хеш-индекс логинов ---------------------------
+// Единый индекс логин -> пользователь для всех трех уровней хранилища
+// (администратор, HR, сотрудники). Открытая адресация с линейным пробированием,
+// емкость — степень двойки, удаленные записи помечаются надгробием.
+class UsernameIndex {
+public:
+    UsernameIndex() { rehash(16); }
+
+    User* find(const string& username) const;
+    bool insert(User* user);        // false, если логин уже занят
+    bool erase(const User* user);   // удаляет запись только для этого объекта
+    void clear();
+    size_t size() const { return size_; }
+
+private:
+    struct Slot {
+        size_t hash = 0;
+        User* user = nullptr;
+        bool tombstone = false;
+    };
+
+    vector<Slot> slots_;
+    size_t size_ = 0;
+    size_t used_ = 0;   // живые записи + надгробия
+
+    static size_t hash_of(const string& username);
+    size_t find_slot(const string& username, size_t hash) const;
+    void rehash(size_t capacity);
+};
+
+// --------------------------- Индекс рейтинга ---------------------------
+// Сотрудники в порядке рейтинга: сначала оцененные по убыванию оценки, затем
+// неоцененные; при равенстве - по ФИО (и логину, чтобы порядок был однозначным).
+// Декартово дерево с размерами поддеревьев: место сотрудника и k-я позиция
+// находятся за O(log n), полный список получается обходом без сортировки.
+// Ключ берется из ФИО и логина пользователя, поэтому перед их изменением запись
+// нужно удалить из индекса и вставить заново.
+class RatingIndex {
+public:
+    struct Entry {
+        const User* user;
+        double rating;      // < 0 - сотрудник не оценен
+    };
+
+    void clear();
+    void insert(const User* user, double rating);
+    bool erase(const User* user);
+    bool contains(const User* user) const { return node_of_.count(user) != 0; }
+    size_t size() const { return node_of_.size(); }
+    // Оцененные сотрудники занимают позиции [0, rated_count())
+    size_t rated_count() const { return rated_count_; }
+
+    // Место в рейтинге начиная с 1; 0, если сотрудника нет в индексе
+    size_t rank_of(const User* user) const;
+    // Запись на позиции position (с 0), position < size()
+    const Entry& at(size_t position) const;
+    // До count записей начиная с позиции first, O(log n + count)
+    vector<Entry> slice(size_t first, size_t count) const;
+
+    // fn(const Entry&) для всех записей в порядке рейтинга
+    template <typename Fn>
+    void for_each(Fn fn) const {
+        vector<uint32_t> path;
+        uint32_t t = root_;
+        while (t != NIL || !path.empty()) {
+            while (t != NIL) {
+                path.push_back(t);
+                t = nodes_[t].left;
+            }
+            t = path.back();
+            path.pop_back();
+            fn(nodes_[t].entry);
+            t = nodes_[t].right;
+        }
+    }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        Entry entry;
+        uint32_t priority;
+        uint32_t left;
+        uint32_t right;
+        uint32_t size;
+    };
+
+    vector<Node> nodes_;
+    vector<uint32_t> free_nodes_;
+    uint32_t root_ = NIL;
+    unordered_map<const User*, uint32_t> node_of_;
+    size_t rated_count_ = 0;
+    uint32_t random_state_ = 0x9E3779B9u;
+
+    static bool precedes(const Entry& a, const Entry& b);
+    uint32_t size_of(uint32_t t) const { return t == NIL ? 0 : nodes_[t].size; }
+    void update(uint32_t t) { nodes_[t].size = 1 + size_of(nodes_[t].left) + size_of(nodes_[t].right); }
+    uint32_t next_priority();
+    void split(uint32_t t, const Entry& key, uint32_t& less, uint32_t& not_less);
+    uint32_t merge(uint32_t a, uint32_t b);
+    uint32_t insert_node(uint32_t t, uint32_t node);
+    uint32_t erase_node(uint32_t t, const Entry& key, bool& removed);
+    uint32_t unlink_node(uint32_t t, uint32_t node, bool& removed);
+};
+
 class UserStore : public Store<User> {
 private:
     vector<unique_ptr<User>> users_;
     vector<unique_ptr<User>> hr_users_;
     unique_ptr<User> admin_user_;
+    UsernameIndex username_index_;
+    // Поиск по ФИО и логину (search_employees_by_name); порядок выдачи - порядок users_
+    TrigramIndex<User> name_index_;
+
+    // Пакетный режим: файлы помечаются измененными и пишутся один раз при commit.
+    // Администратор меняется только при загрузке, поэтому в откат не входит
+    int batch_depth_ = 0;
+    bool users_dirty_ = false;
+    bool hr_dirty_ = false;
+    bool admin_dirty_ = false;
+    BatchRollback<User> users_rollback_;
+    BatchRollback<User> hr_rollback_;
+
+    // Рейтинг строится по оценкам ratings_config_ при первом запросе
+    // и дальше поддерживается через update_rating
+    mutable RatingIndex rating_index_;
+    mutable StringMap<RatingIndex> department_ratings_;     // отдел -> рейтинг внутри отдела
+    mutable const SystemConfig* ratings_config_ = nullptr;
+
+    void rebuild_username_index();
+    void rebuild_name_index();
+    static string name_search_text(const User* user);
+    void rebuild_rating_index() const;
+    double rating_of(const User* user) const;
+    void index_rating(const User* user);
+    void unindex_rating(const User* user);
 public:
     UserStore() {
         load_from_file();
@@ -236,42 +377,86 @@ public:
     bool move_user_to_hr(const string& username);
     void save_all_files();
 
-    // ,    HR
+    // Проверка, является ли пользователь HR
     bool is_hr_user(const string& username) const;
     void create_default_admin();
 
     void load_admin_from_file();
     void save_admin_to_file();
     bool is_admin_user(const string& username) const;
+
+    // Пакетная запись (командный режим: begin/commit/rollback).
+    // commit вложенного пакета переносит его изменения во внешний, rollback отменяет
+    // изменения своего уровня на месте: объекты, бывшие до пакета, не пересоздаются.
+    void begin_batch();
+    void commit_batch();
+    void rollback_batch();
+    bool in_batch() const { return batch_depth_ > 0; }
+
     const vector<unique_ptr<User>>& users() const { return users_; }
     vector<const User*> all_users() const;
     vector<const User*> get_all_employees() const;
     User* get_employee(const string& username) const;
     bool update_employee(const string& username, const string& new_fullname, const string& new_department);
     
+    // Поиск подстроки в ФИО или логине без учета регистра через триграммный индекс:
+    // проверяются только сотрудники, у которых есть все триграммы запроса
     vector<const User*> search_employees_by_name(const string& keyword) const;
 
     vector<const User*> get_employees_sorted_by_name(bool ascending = true) const;
     vector<const User*> get_pending_users() const;
     bool remove_hr_user_by_username(const string& username);
+    // Рейтинг по оценкам config: индекс строится при первом обращении,
+    // изменения оценок передаются через update_rating
+    void attach_ratings(const SystemConfig* config) const;
+    void update_rating(const string& username, double score);
+
     vector<pair<const User*, double>> get_employees_sorted_by_rating(SystemConfig* config) const;
 
-    //     
+    // Получить место сотрудника в рейтинге: { место, всего сотрудников }, O(log n)
     pair<int, int> get_employee_rank(const string& username, SystemConfig* config) const;
 
-    //     ( )
+    // Лидеры и отстающие (только оцененные сотрудники), O(log n + k) без сортировки:
+    // k лучших, k лучших отдела, k худших (от худшего к лучшему)
+    vector<pair<const User*, double>> get_top_rated(size_t k, SystemConfig* config) const;
+    vector<pair<const User*, double>> get_top_rated_in_department(const string& department,
+        size_t k, SystemConfig* config) const;
+    vector<pair<const User*, double>> get_bottom_rated(size_t k, SystemConfig* config) const;
+    // k лучших каждого отдела, в котором есть оцененные сотрудники
+    map<string, vector<pair<const User*, double>>> get_top_rated_by_department(size_t k,
+        SystemConfig* config) const;
+
+    // Получить всех обычных пользователей (для сортировки)
     vector<User*> get_employees() const;
     
 };
 
 
-// ---------------------------   /   ---------------------------
+// --------------------------- Расчет эффективности ---------------------------
+// Проверенные данные для расчета оценки одного сотрудника (Application::prepare_performance)
+struct PerformanceInput {
+    DepartmentId department = DepartmentId::OTHER;
+    double department_score = 0;
+    double teamwork_score = 0;
+    double tasks_score = 0;
+};
+
+// --------------------------- Интерфейс консоли / рабочий поток ---------------------------
 class Application {
 private:
     unique_ptr<UserStore> store_;
     unique_ptr<ProjectStore> project_store_;
     unique_ptr<SystemConfig> system_config_;
 
+    // Сохраненные отчеты по сотрудникам (без обхода каталога)
+    ReportCatalog report_catalog_;
+    // Все версии текстовых отчетов каждого сотрудника
+    ReportArchive report_archive_;
+
+    // Буферы отчета по одному сотруднику переиспользуются между вызовами
+    ConsoleReportRenderer console_report_;
+    TextReportRenderer text_report_;
+
     void show_main_menu();
 
     static int input_int(const string& prompt);
@@ -289,14 +474,14 @@ private:
 
     string choose_department();
 
-    // -----------   (  ) -----------
+    // ----------- Сессии пользователей (меню после входа) -----------
     void admin_session(Admin& admin);
 
     void hr_session(HRManagerUser& hr);
 
     void employee_session(EmployeeUser& emp);
 
-    // -----------   -----------
+    // ----------- Административные утилиты -----------
     void list_all_users();
 
     void assign_hr_role_flow();
@@ -309,12 +494,21 @@ public:
         setlocale(LC_ALL, "Russian");
         locale::global(std::locale("Russian"));
 
+        // Рейтинг в UserStore обновляется при каждом сохранении оценки
+        system_config_->setScoreListener([this](const string& username, double score) {
+            store_->update_rating(username, score);
+        });
+
     }
     
     void run();
-    //     ( HR )
+    // Командный режим без меню и очистки экрана (Headless.cpp): команды по одной
+    // на строку из in, на каждую - строка JSON с результатом и временем выполнения в out.
+    // Возвращает 0, если все команды выполнены, иначе 1
+    int run_headless(istream& in, ostream& out);
+    // Методы для управления проектами (для HR менеджеров)
     void hr_manage_projects(HRManagerUser& hr);
-    //     
+    // Методы для работы с проектами
     void hr_add_project();
     void hr_view_all_projects();
     void hr_edit_project();
@@ -335,22 +529,50 @@ public:
     void hr_view_employee_details();
     void hr_search_employees();
     void hr_sort_employees();
-    //       SystemConfig
+    // метод для расчета эффективности с использованием SystemConfig
     void hr_calculate_performance();
 
-    //      
+    // Пакетный расчет эффективности из файла строк "логин|оценка_отдела|оценка_команды"
+    void hr_batch_calculate_performance();
+    void batch_calculate_performance(const string& input_file);
+
+    // Проверка и расчет оценки - общие для меню, пакетного расчета и командного режима.
+    // Оценка отдела и командной работы - конечное число от 0 до 100 (stod и from_chars
+    // принимают "nan" и "inf"); у сотрудника должны быть проекты
+    static bool is_valid_score(double score);
+    static double round_score(double score);
+    bool prepare_performance(const User& employee, double departmentScore, double teamworkScore,
+        PerformanceInput& input, string& error) const;
+    // Итоговая оценка (округленная до сотых) сохраняется и возвращается
+    double save_performance(const string& username, const PerformanceInput& input);
+
+    // Метод для администратора для настройки коэффициентов
     void admin_configure_system();
+    // Статистика горячих путей (Stats.h): просмотр, запись в файл, включение и сброс
+    void admin_stats_menu();
 
     void show_employee_performance_score(const string& username);
     void hr_view_saved_report(const string& username);
+    // Постраничный просмотр текста отчета (обычно - отображенного в память файла)
+    void view_report(const string& title, string_view text);
     
     void hr_generate_report();
     void generate_detailed_report(const string& username, User* employee);
-    void save_report_to_file(const string& username, User* employee,
-        const string& department, const string& deptParamName,
-        int total_projects, int active_projects, int completed_projects,
-        int leadership_count, const vector<string>& project_details,
-        const vector<string>& recommendations);
+    ReportModel build_report_model(const string& username, const User* employee);
+    void save_report_to_file(const ReportModel& report);
+    // Запись отчета без вывода на экран: новый файл, затем (для TXT) версия в архиве,
+    // удаление прежних файлов сотрудника и запись в каталоге. version - номер версии
+    // в архиве (0 - не архивировался); verbose - сообщать об удаленных файлах
+    bool store_report(const ReportModel& report, ReportRenderer& renderer, string& filename, size_t& version,
+        bool verbose = false);
+
+    // Отчеты по всем сотрудникам (TXT, JSON или CSV): файлы пишутся параллельно в пуле потоков
+    void hr_generate_all_reports();
+
+    // Имена и удаление файлов отчета без обращения к каталогу (безопасны для рабочих потоков);
+    // extension - с точкой, как ReportRenderer::file_extension()
+    static string make_report_filename(const string& username, const string& extension = ".txt");
+    static int remove_report_files(const vector<string>& filenames, const string& keep, bool verbose);
 
     string centerAlign(const string& text, int width);
     void printHorizontalLine(char symbol, int width);
@@ -358,11 +580,13 @@ public:
         int completed_projects, int leadership_count);
     void show_employees_sorted_by_name();
     void show_employees_rating();
+    void show_rating_leaders();
     void show_my_rating(const string& username);
 
 
 };
 namespace HRSystem {
+    using ::PerformanceInput;
     using ::Application;
     using ::User;
     using ::Admin;
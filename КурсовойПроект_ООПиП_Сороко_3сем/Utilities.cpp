@@ -1,4 +1,5 @@
 #include "Utilities.h"
+#include <charconv>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
@@ -9,12 +10,9 @@
 using namespace std;
 
 
-// ---------------------------   ---------------------------
+// --------------------------- Вспомогательные утилиты ---------------------------
 string trim(const string& s) {
-    size_t a = s.find_first_not_of(" \t\r\n");
-    if (a == string::npos) return "";
-    size_t b = s.find_last_not_of(" \t\r\n");
-    return s.substr(a, b - a + 1);
+    return string(trim(string_view(s)));
 }
 
 bool isCyrillic(char ch) {
@@ -23,14 +21,15 @@ bool isCyrillic(char ch) {
 }
 
 string& toLower(string& s) {
-    transform(s.begin(), s.end(), s.begin(),
-        [](unsigned char c) {
-            return std::tolower(c);
-        }
-    );
+    fold_case_cp1251(s.data(), s.size(), s.data());
     return s;
 }
 
+string login_of(string_view text) {
+    string login(text);
+    return toLower(login);
+}
+
 string format_cell(const string& text, size_t width) {
     if (text.length() > width) {
         return text.substr(0, width - 3) + "...";
@@ -40,12 +39,12 @@ string format_cell(const string& text, size_t width) {
     }
 }
 
-//     
+// Функция для вывода горизонтальной линии
 void print_horizontal_line(size_t total_width) {
     cout << string(total_width + 2, '-') << "\n";
 }   
 
-//     
+// Функция для вывода заголовка таблицы
 void print_table_header(const vector<string>& headers, const vector<size_t>& widths) {
     size_t total_width = 0;
     for (size_t w : widths) {
@@ -64,7 +63,7 @@ void print_table_header(const vector<string>& headers, const vector<size_t>& wid
     print_horizontal_line(total_width);
 }
 
-//     
+// Функция для вывода строки таблицы
 void print_table_row(const vector<string>& cells, const vector<size_t>& widths) {
     cout << "|";
     for (size_t i = 0; i < cells.size(); ++i) {
@@ -75,12 +74,38 @@ void print_table_row(const vector<string>& cells, const vector<size_t>& widths)
 
 vector<string> split(const string& s, char delim) {
     vector<string> out;
-    stringstream ss(s);
-    string item;
-    while (getline(ss, item, delim)) out.push_back(item);
+    for (string_view field : FieldRange(s, delim)) out.emplace_back(field);
     return out;
 }
 
+// from_chars не зависит от локали и не выделяет память
+bool parse_decimal(string_view text, double& value) {
+    char buf[64];
+    if (text.empty() || text.size() >= sizeof(buf)) return false;
+    for (size_t i = 0; i < text.size(); ++i) {
+        buf[i] = text[i] == ',' ? '.' : text[i];
+    }
+    auto result = from_chars(buf, buf + text.size(), value);
+    return result.ec == errc() && result.ptr == buf + text.size();
+}
+
+// Верхняя половина CP1251: 0xC0-0xFF - сплошной блок А..я, остальное по таблице
+char16_t cp1251_to_unicode(unsigned char c) {
+    static const char16_t HIGH[64] = {
+        0x0402, 0x0403, 0x201A, 0x0453, 0x201E, 0x2026, 0x2020, 0x2021,
+        0x20AC, 0x2030, 0x0409, 0x2039, 0x040A, 0x040C, 0x040B, 0x040F,
+        0x0452, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+        0xFFFD, 0x2122, 0x0459, 0x203A, 0x045A, 0x045C, 0x045B, 0x045F,
+        0x00A0, 0x040E, 0x045E, 0x0408, 0x00A4, 0x0490, 0x00A6, 0x00A7,
+        0x0401, 0x00A9, 0x0404, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x0407,
+        0x00B0, 0x00B1, 0x0406, 0x0456, 0x0491, 0x00B5, 0x00B6, 0x00B7,
+        0x0451, 0x2116, 0x0454, 0x00BB, 0x0458, 0x0405, 0x0455, 0x0457,
+    };
+    if (c < 0x80) return c;
+    if (c >= 0xC0) return static_cast<char16_t>(0x0410 + (c - 0xC0));
+    return HIGH[c - 0x80];
+}
+
 string now_string() {
     time_t t = time(nullptr);
     tm tm{};
@@ -94,7 +119,7 @@ string now_string() {
     return oss.str();
 }
 
-// ---------------------------  CRUD-   ---------------------------
+// --------------------------- Шаблонные CRUD-утилиты для контейнеров ---------------------------
 template <typename T, typename KeyFunc>
 optional<size_t> find_index_by_key(const vector<T>& container, const typename invoke_result_t<KeyFunc(const T&)>::type& key, KeyFunc keyFn) {
     for (size_t i = 0; i < container.size(); ++i) {
@@ -103,13 +128,13 @@ optional<size_t> find_index_by_key(const vector<T>& container, const typename in
     return nullopt;
 }
 
-//  
+// Добавить элемент
 template <typename T>
 void add_item(vector<T>& container, T item) {
     container.push_back(move(item));
 }
 
-//    
+// Удалить элемент по индексу
 template <typename T>
 bool remove_item_at(vector<T>& container, size_t index) {
     if (index >= container.size()) return false;
@@ -117,7 +142,7 @@ bool remove_item_at(vector<T>& container, size_t index) {
     return true;
 }
 
-//   (  )
+// Редактировать элемент (здесь просто заменяем)
 template <typename T>
 bool update_item_at(vector<T>& container, size_t index, const T& newItem) {
     if (index >= container.size()) return false;
@@ -2,68 +2,292 @@
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
 
-//   byte Windows
+// блокируем определение byte Windows
 #define NONAMELESSUNION
 #define NONAMELESSSTRUCT
 
 #ifdef byte
 #undef byte
 #endif
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <optional>
+#include "CaseFold.h"
 
 using namespace std;
 
-// ---------------------------   ---------------------------
+// --------------------------- Константы файлов ---------------------------
 const string USERS_FILE = "users.txt";
 const string PROJECTS_FILE = "projects.txt"; 
 const string EMPLOYEE_PROJECTS_FILE = "employee_projects.txt"; 
+const string EMPLOYEE_PROJECTS_JOURNAL_FILE = "employee_projects.journal";
 const string HR_USERS_FILE = "hr_users.txt"; 
 const string ADMIN_USERS_FILE = "admin_users.txt";  
+const string PERFORMANCE_SCORES_FILE = "performance_scores.txt";
+const string PERFORMANCE_SCORES_JOURNAL_FILE = "performance_scores.journal";
+const string REPORTS_CATALOG_FILE = "reports_catalog.journal";
+const string REPORT_ARCHIVE_DIR = "reports_archive";
+const string STATS_FILE = "hr_stats.txt";
 
-// ---------------------------   ---------------------------
+// --------------------------- Вспомогательные утилиты ---------------------------
 string trim(const string& s);
 string format_cell(const string& text, size_t width);
 
-//     
+// Функция для вывода горизонтальной линии
 void print_horizontal_line(size_t total_width);
 
-//     
+// Функция для вывода заголовка таблицы
 void print_table_header(const vector<string>& headers, const vector<size_t>& widths);
 
-//     
+// Функция для вывода строки таблицы
 void print_table_row(const vector<string>& cells, const vector<size_t>& widths);
 bool isCyrillic(char ch);
 vector<string> split(const string& s, char delim);
 
 string now_string();
+// Нижний регистр на месте (CP1251, см. CaseFold.h)
 string& toLower(string& s);
-// ---------------------------  CRUD-   ---------------------------
+// Логин в том виде, в каком он хранится: копия в нижнем регистре (меню, пакетный и командный режимы)
+string login_of(string_view text);
+
+// Число из файла или ввода: принимает и запятую (русская локаль), и точку; не зависит от локали
+bool parse_decimal(string_view text, double& value);
+
+// Код символа Unicode для байта CP1251 (неопределенный 0x98 -> U+FFFD)
+char16_t cp1251_to_unicode(unsigned char c);
+// --------------------------- Разбор записей без выделения памяти ---------------------------
+// Результаты указывают в исходную строку и действительны, пока она жива.
+
+// Обрезка пробелов без копирования
+inline string_view trim(string_view s) {
+    size_t a = s.find_first_not_of(" \t\r\n");
+    if (a == string_view::npos) return {};
+    size_t b = s.find_last_not_of(" \t\r\n");
+    return s.substr(a, b - a + 1);
+}
+
+// Ленивый диапазон полей записи: for (string_view field : FieldRange(line, '|')) ...
+// Поля не обрезаются. Как и split(), не выдает пустое поле после завершающего разделителя.
+class FieldRange {
+public:
+    class iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = string_view;
+        using difference_type = ptrdiff_t;
+        using pointer = const string_view*;
+        using reference = const string_view&;
+
+        iterator() = default;
+        iterator(string_view text, char delim) : delim_(delim) {
+            if (!text.empty()) read_field(text);
+        }
+
+        reference operator*() const { return field_; }
+        pointer operator->() const { return &field_; }
+
+        iterator& operator++() {
+            if (has_more_ && !rest_.empty()) read_field(rest_);
+            else at_end_ = true;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const iterator& other) const {
+            return at_end_ == other.at_end_ && (at_end_ || field_.data() == other.field_.data());
+        }
+
+    private:
+        void read_field(string_view text) {
+            size_t end = text.find(delim_);
+            field_ = text.substr(0, end);
+            has_more_ = end != string_view::npos;
+            rest_ = has_more_ ? text.substr(end + 1) : string_view();
+            at_end_ = false;
+        }
+
+        string_view field_;
+        string_view rest_;
+        char delim_ = '|';
+        bool has_more_ = false;
+        bool at_end_ = true;
+    };
+
+    FieldRange(string_view text, char delim) : text_(text), delim_(delim) {}
+
+    iterator begin() const { return iterator(text_, delim_); }
+    iterator end() const { return iterator(); }
+
+private:
+    string_view text_;
+    char delim_;
+};
+
+// Записывает в fields не более max_fields обрезанных полей записи; возвращает их число
+inline size_t split_fields(string_view text, char delim, string_view* fields, size_t max_fields) {
+    size_t count = 0;
+    for (string_view field : FieldRange(text, delim)) {
+        if (count == max_fields) break;
+        fields[count++] = trim(field);
+    }
+    return count;
+}
+
+// --------------------------- Хеш-таблицы со строковым ключом ---------------------------
+// Прозрачный хеш: поиск по string_view и const char* без создания временной строки
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(string_view s) const { return hash<string_view>{}(s); }
+};
+
+template <typename V>
+using StringMap = unordered_map<string, V, StringHash, equal_to<>>;
+
+// --------------------------- Шаблонные CRUD-утилиты для контейнеров ---------------------------
 template <typename T, typename KeyFunc>
 optional<size_t> find_index_by_key(const vector<T>& container, const typename invoke_result_t<KeyFunc(const T&)>::type& key, KeyFunc keyFn);
 
-//  
+// Добавить элемент
 template <typename T>
 void add_item(vector<T>& container, T item);
 
-//    
+// Удалить элемент по индексу
 template <typename T>
 bool remove_item_at(vector<T>& container, size_t index);
 
-//   (  )
+// Редактировать элемент (здесь просто заменяем)
 template <typename T>
 bool update_item_at(vector<T>& container, size_t index, const T& newItem);
 
+// --------------------------- Пакетная запись (транзакция) ---------------------------
+// Пока объект жив, изменения хранилища копятся в памяти; commit() записывает каждый
+// затронутый файл ровно один раз. Без commit() деструктор откатывает изменения.
+// StoreT должен предоставлять begin_batch(), commit_batch() и rollback_batch().
+template <typename StoreT>
+class StoreTransaction {
+public:
+    explicit StoreTransaction(StoreT& store) : store_(store) { store_.begin_batch(); }
+    ~StoreTransaction() { rollback(); }
+
+    StoreTransaction(const StoreTransaction&) = delete;
+    StoreTransaction& operator=(const StoreTransaction&) = delete;
+
+    void commit() {
+        if (!active_) return;
+        active_ = false;
+        store_.commit_batch();
+    }
+
+    void rollback() {
+        if (!active_) return;
+        active_ = false;
+        store_.rollback_batch();
+    }
+
+private:
+    StoreT& store_;
+    bool active_ = true;
+};
+
+// --------------------------- Откат пакета на месте ---------------------------
+// Владеет объектами хранилища, удаленными во время пакета, и помнит порядок вектора
+// на начало каждого уровня пакета. rollback() возвращает в вектор те же объекты в прежнем
+// порядке, а изменения полей откатывает действиями on_rollback(), поэтому указатели на
+// объекты, существовавшие до пакета (текущий пользователь, выборки меню), остаются
+// действительными. Индексы поверх вектора хранилище после отката перестраивает само.
+// commit() вложенного уровня переносит его действия отката во внешний уровень.
+template <typename T>
+class BatchRollback {
+public:
+    bool active() const { return !levels_.empty(); }
+
+    void begin(const vector<unique_ptr<T>>& live) {
+        Level level;
+        level.order.reserve(live.size());
+        for (const auto& object : live) level.order.push_back(object.get());
+        levels_.push_back(move(level));
+    }
+
+    // Вне пакета объект просто уничтожается
+    void retire(unique_ptr<T> object) {
+        if (active() && object) retired_.push_back(move(object));
+    }
+
+    // Действие, возвращающее прежние значения полей объекта
+    void on_rollback(function<void()> undo) {
+        if (active()) levels_.back().undo.push_back(move(undo));
+    }
+
+    void commit() {
+        if (!active()) return;
+        Level level = move(levels_.back());
+        levels_.pop_back();
+        if (active()) {
+            auto& outer = levels_.back().undo;
+            outer.insert(outer.end(), make_move_iterator(level.undo.begin()), make_move_iterator(level.undo.end()));
+        }
+        else {
+            retired_.clear();
+        }
+    }
+
+    void rollback(vector<unique_ptr<T>>& live) {
+        if (!active()) return;
+        Level level = move(levels_.back());
+        levels_.pop_back();
+        for (auto it = level.undo.rbegin(); it != level.undo.rend(); ++it) (*it)();
+
+        unordered_map<T*, unique_ptr<T>> pool;
+        pool.reserve(live.size() + retired_.size());
+        for (auto& object : live) pool.emplace(object.get(), move(object));
+        for (auto& object : retired_) pool.emplace(object.get(), move(object));
+        live.clear();
+        retired_.clear();
+
+        live.reserve(level.order.size());
+        for (T* object : level.order) {
+            auto it = pool.find(object);
+            if (it == pool.end()) continue;
+            live.push_back(move(it->second));
+            pool.erase(it);
+        }
+
+        // Остались объекты, созданные в этом уровне, и удаленные до его начала:
+        // вторые еще нужны внешнему уровню, поэтому до конца пакета живут все
+        if (active()) {
+            for (auto& [object, owner] : pool) retired_.push_back(move(owner));
+        }
+    }
+
+private:
+    struct Level {
+        vector<T*> order;
+        vector<function<void()>> undo;
+    };
+    vector<Level> levels_;
+    vector<unique_ptr<T>> retired_;
+};
+
 namespace HRSystem {
-    // 
+    // Константы
     const string USERS_FILE = "users.txt";
     const string PROJECTS_FILE = "projects.txt";
     const string EMPLOYEE_PROJECTS_FILE = "employee_projects.txt";
+    const string EMPLOYEE_PROJECTS_JOURNAL_FILE = "employee_projects.journal";
     const string HR_USERS_FILE = "hr_users.txt";
     const string ADMIN_USERS_FILE = "admin_users.txt";
 
-    //  ( using)
+    // Функции (с using)
     using ::trim;
     using ::format_cell;
     using ::print_horizontal_line;
@@ -71,6 +295,15 @@ namespace HRSystem {
     using ::print_table_row;
     using ::isCyrillic;
     using ::split;
+    using ::FieldRange;
+    using ::split_fields;
+    using ::StringHash;
+    using ::StringMap;
     using ::now_string;
+    using ::parse_decimal;
     using ::toLower;
+    using ::login_of;
+    using ::cp1251_to_unicode;
+    using ::StoreTransaction;
+    using ::BatchRollback;
 }
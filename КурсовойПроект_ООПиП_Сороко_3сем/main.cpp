@@ -1,15 +1,72 @@
 ﻿#include"UserClasses.h"
 #include "Projects.h"
+#include "Stats.h"
 #include <windows.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
 //using namespace HRSystem;
 
 
+// Статистика горячих путей (Stats.h) записывается при выходе, если сбор был включен -
+// флагом --stats или из меню администратора
+static void dump_stats() {
+    if (!HRSystem::stats_enabled()) return;
+    if (!HRSystem::write_stats_file(STATS_FILE)) {
+        std::cerr << "Не удалось записать статистику: " << STATS_FILE << "\n";
+    }
+}
+
 // --------------------------- main ---------------------------
-int main() {
+// Без аргументов - меню. --script <файл> - командный режим по файлу сценария,
+// --script - (или --headless) - командный режим со стандартного ввода.
+// --stats (в любом месте) - сбор статистики с запуска
+int main(int argc, char* argv[]) {
     setlocale(LC_ALL, "RUS");
     SetConsoleCP(1251);
     SetConsoleOutputCP(1251);
-    HRSystem::Application app;
-    app.run();
-    return 0;
-}
\ No newline at end of file
+
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--stats") HRSystem::set_stats_enabled(true);
+        else args.emplace_back(argv[i]);
+    }
+
+    std::string mode = args.empty() ? "" : args[0];
+    if (mode != "--script" && mode != "--headless") {
+        {
+            HRSystem::Application app;
+            app.run();
+        }
+        dump_stats();
+        return 0;
+    }
+
+    std::ifstream script;
+    bool from_stdin = mode == "--headless" || (args.size() > 1 && args[1] == "-");
+    if (!from_stdin) {
+        if (args.size() < 2) {
+            std::cerr << "Использование: " << argv[0] << " --script <файл>|- [--stats]\n";
+            return 2;
+        }
+        script.open(args[1]);
+        if (!script) {
+            std::cerr << "Не удалось открыть сценарий: " << args[1] << "\n";
+            return 2;
+        }
+    }
+
+    // В stdout - только ответы команд; сообщения хранилищ (загрузка файлов и т.п.) уходят в stderr
+    std::ostream results(std::cout.rdbuf());
+    std::cout.rdbuf(std::cerr.rdbuf());
+
+    int code;
+    {
+        HRSystem::Application app;
+        code = app.run_headless(from_stdin ? std::cin : script, results);
+    }
+    std::cout.rdbuf(results.rdbuf());
+    dump_stats();
+    return code;
+}